@@ -0,0 +1,31 @@
+# find benchmarks in the benchmarks directory and generate an executable for each one
+
+function(find_benchmarks)
+    file(GLOB MGL_BENCHMARKS "${CMAKE_CURRENT_SOURCE_DIR}/benchmarks/bench_*.cpp")
+    foreach(FILE_PATH ${MGL_BENCHMARKS})
+        get_filename_component(BENCHMARK_NAME ${FILE_PATH} NAME_WE)
+
+        message(STATUS "Adding benchmark: ${BENCHMARK_NAME}")
+
+        add_executable(${PROJECT_NAME}_${BENCHMARK_NAME} ${FILE_PATH})
+
+        # Benchmarks compare against the vendored implementations, e.g. stb
+        target_include_directories(
+            ${PROJECT_NAME}_${BENCHMARK_NAME}
+          PRIVATE
+            ${VENDORS_HEADERS_ONLY_INC_DIR}
+        )
+
+        target_link_libraries(
+            ${PROJECT_NAME}_${BENCHMARK_NAME}
+          PRIVATE
+            ${ARGV}
+        )
+
+        target_compile_definitions(${PROJECT_NAME}_${BENCHMARK_NAME}
+            PRIVATE
+            ${MGL_COMPILER_DEFINITION}
+            ${MGL_BUILD_TYPE_DEFINITIONS}
+        )
+    endforeach()
+endfunction(find_benchmarks)
@@ -5,6 +5,7 @@
 
 #include "mgl_core/containers.hpp"
 #include "mgl_platform/window.hpp"
+#include "mgl_registry/registry.hpp"
 
 namespace mgl::application
 {
@@ -15,6 +16,11 @@ namespace mgl::application
     mgl::graphics::layer_ref render_layer = nullptr;
     mgl::ref_list<mgl::graphics::layer> extra_layers;
 
+    // Assets of the startup stage are prefetched while the window and context are created. The
+    // prefetch starts in the application constructor, only locations registered before it are read
+    mgl::registry::manifest_ref manifest = nullptr;
+    std::string startup_stage = "boot";
+
     application_config()
         : mgl::platform::window_config()
         , gui_layer(nullptr)
@@ -34,6 +40,8 @@ namespace mgl::application
         , gui_layer(settings.gui_layer)
         , render_layer(settings.render_layer)
         , extra_layers(settings.extra_layers)
+        , manifest(settings.manifest)
+        , startup_stage(settings.startup_stage)
     { }
 
     application_config& operator=(const mgl::platform::window_config& settings)
@@ -48,6 +56,8 @@ namespace mgl::application
       gui_layer = settings.gui_layer;
       render_layer = settings.render_layer;
       extra_layers = settings.extra_layers;
+      manifest = settings.manifest;
+      startup_stage = settings.startup_stage;
       return *this;
     }
   };
@@ -64,6 +74,9 @@ public:
 
     application_config& config() { return m_config; }
 
+    // Completes once the startup stage of the manifest is in memory, invalid without a manifest
+    const mgl::registry::prefetch_future& startup_prefetch() const { return m_prefetch; }
+
 protected:
     virtual void on_event(mgl::platform::event& event) override final;
     virtual void on_update(float time, float frame_time) override final;
@@ -75,6 +88,7 @@ private:
     mgl::graphics::layer_ref m_render_layer;
     application_config m_config;
     mgl::graphics::layer_stack m_layers;
+    mgl::registry::prefetch_future m_prefetch;
   };
 
   inline application& current_application()
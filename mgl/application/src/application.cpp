@@ -1,6 +1,8 @@
 #include "mgl_application/application.hpp"
+#include "mgl_graphics/graphics.hpp"
 #include "mgl_graphics/layers/gui.hpp"
 #include "mgl_graphics/layers/render.hpp"
+#include "mgl_registry/registry.hpp"
 
 #include "mgl_core/containers.hpp"
 #include "mgl_core/memory.hpp"
@@ -19,6 +21,12 @@ namespace mgl::application
   {
     MGL_CORE_ASSERT(s_instance == nullptr, "Application already exists!");
     s_instance = mgl::scope<application>(this);
+
+    // The window is only created in run(), the disk is busy in the meantime
+    if(settings.manifest != nullptr)
+    {
+      m_prefetch = mgl::registry::prefetch(*settings.manifest, settings.startup_stage);
+    }
   }
 
   application::~application()
@@ -36,9 +44,13 @@ namespace mgl::application
 
   void application::on_update(float time, float frame_time)
   {
+    // Completion callbacks of asynchronous loads run on the main thread
+    mgl::registry::dispatch_completions();
+    mgl::graphics::begin_frame();
     m_render_layer->on_update(time, frame_time);
     m_layers.on_update(time, frame_time);
     m_gui_layer->on_update(time, frame_time);
+    mgl::graphics::end_frame();
   }
 
   bool application::on_load()
@@ -57,6 +57,63 @@ namespace mgl::io
    */
   using ofstream_ref = mgl::ref<ofstream>;
 
+  /**
+   * @brief Input stream reading a block of memory in place, without copying it.
+   *
+   * The memory must stay valid while the stream is used, an owner can be given to keep it alive.
+   */
+  class memory_istream : public std::istream
+  {
+    struct memory_buf : public std::streambuf
+    {
+      memory_buf(const uint8_t* data, size_t size)
+      {
+        char* begin = reinterpret_cast<char*>(const_cast<uint8_t*>(data));
+        setg(begin, begin, begin + size);
+      }
+
+      pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode) override
+      {
+        char* base = dir == std::ios_base::beg   ? eback()
+                     : dir == std::ios_base::cur ? gptr()
+                                                 : egptr();
+        char* target = base + off;
+        if(target < eback() || target > egptr())
+          return pos_type(off_type(-1));
+        setg(eback(), target, egptr());
+        return pos_type(target - eback());
+      }
+
+      pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+      {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+      }
+    };
+
+public:
+    memory_istream(const uint8_t* data, size_t size, mgl::ref<const void> owner = nullptr)
+        : std::istream(nullptr)
+        , m_buffer(data, size)
+        , m_owner(std::move(owner))
+        , m_data(data)
+        , m_size(size)
+    {
+      rdbuf(&m_buffer);
+    }
+
+    const uint8_t* data() const { return m_data; }
+
+    size_t size() const { return m_size; }
+
+private:
+    memory_buf m_buffer;
+    mgl::ref<const void> m_owner;
+    const uint8_t* m_data;
+    size_t m_size;
+  };
+
+  using memory_istream_ref = mgl::ref<memory_istream>;
+
   /**
    * @brief Constant representing a null path.
    */
@@ -0,0 +1,50 @@
+/**
+ * @file lz4.hpp
+ * @brief LZ4 block format compression and decompression.
+*/
+#pragma once
+
+#include "mgl_core/memory.hpp"
+
+namespace mgl::lz4
+{
+  /**
+   * @brief Worst case size of the compressed data, incompressible input grows slightly.
+   * @param size The size of the uncompressed data.
+   */
+  inline size_t compress_bound(size_t size)
+  {
+    return size + size / 255 + 16;
+  }
+
+  /**
+   * @brief Largest size a block can decompress to, each byte of a match length adds at most 255.
+   * @param size The size of the compressed block.
+   */
+  inline size_t decompress_bound(size_t size)
+  {
+    return size * 255 + 16;
+  }
+
+  /**
+   * @brief Compresses a block using the LZ4 block format.
+   *
+   * The output is compatible with LZ4_decompress_safe, there is no frame header so the caller
+   * must store the uncompressed size.
+   * @param src The data to compress.
+   * @param size The size of the data in bytes.
+   * @param out Receives the compressed block, resized to the compressed size.
+   */
+  void compress(const uint8_t* src, size_t size, mgl::uint8_buffer& out);
+
+  /**
+   * @brief Decompresses an LZ4 block.
+   * @param src The compressed block.
+   * @param size The size of the compressed block in bytes.
+   * @param dst The output, must hold exactly dst_size bytes.
+   * @param dst_size The uncompressed size.
+   * @return False if the block is malformed or does not decompress to dst_size bytes.
+   */
+  bool decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t dst_size);
+
+} // namespace mgl::lz4
@@ -0,0 +1,63 @@
+/**
+ * @file mapped_file.hpp
+ * @brief Contains the definition of the mapped_file class.
+*/
+#pragma once
+
+#include "mgl_core/memory.hpp"
+#include "mgl_core/utils.hpp"
+
+namespace mgl
+{
+  /**
+   * @brief Read-only memory mapping of a whole file.
+   *
+   * Pages are loaded by the OS on first access, so mapping a large archive costs a few page faults
+   * for the parts that are actually read instead of a read of the full file.
+   */
+  class mapped_file
+  {
+public:
+    /**
+     * @brief Maps the file, is_open() returns false if it could not be mapped.
+     * @param path The path to the file to map.
+     */
+    mapped_file(const mgl::path& path);
+
+    /**
+     * @brief Unmaps the file, pointers returned by data() are no longer valid.
+     */
+    ~mapped_file();
+
+    mapped_file(const mapped_file&) = delete;
+
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    const uint8_t* data() const { return m_data; }
+
+    size_t size() const { return m_size; }
+
+    bool is_open() const { return m_data != nullptr; }
+
+    const mgl::path& path() const { return m_path; }
+
+    /**
+     * @brief Asks the OS to start loading a range of the file, without waiting for it.
+     * @param offset The offset of the range.
+     * @param size The size of the range, clamped to the end of the file.
+     */
+    void prefetch(size_t offset, size_t size) const;
+
+private:
+    mgl::path m_path;
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+
+    // Windows file and mapping handles, unused on POSIX
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+  };
+
+  using mapped_file_ref = mgl::ref<mapped_file>;
+
+} // namespace mgl
@@ -0,0 +1,83 @@
+/**
+ * @file thread_pool.hpp
+ * @brief Contains the definition of the thread_pool class.
+*/
+#pragma once
+
+#include "mgl_core/containers.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace mgl
+{
+  /**
+   * @brief A fixed size pool of worker threads executing tasks in FIFO order.
+   */
+  class thread_pool
+  {
+public:
+    /**
+     * @brief Creates the pool and starts the workers.
+     * @param threads Number of worker threads, 0 uses the hardware concurrency.
+     */
+    thread_pool(size_t threads = 0);
+
+    /**
+     * @brief Runs the pending tasks and joins the workers.
+     */
+    ~thread_pool();
+
+    thread_pool(const thread_pool&) = delete;
+
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    /**
+     * @brief Queues a task to be executed by a worker.
+     * @param task The task to execute.
+     */
+    void enqueue(std::function<void()> task);
+
+    /**
+     * @brief Queues a callable and returns a future for its result.
+     * @param func The callable to execute.
+     * @return A future that becomes ready when the callable returns.
+     */
+    template <typename F>
+    auto submit(F&& func) -> std::future<decltype(func())>
+    {
+      using result_type = decltype(func());
+      auto task = std::make_shared<std::packaged_task<result_type()>>(std::forward<F>(func));
+      auto future = task->get_future();
+      enqueue([task]() { (*task)(); });
+      return future;
+    }
+
+    /**
+     * @brief Blocks until every queued task has finished.
+     */
+    void wait();
+
+    /**
+     * @brief Gets the number of worker threads.
+     * @return The number of workers.
+     */
+    size_t size() const { return m_workers.size(); }
+
+private:
+    void worker();
+
+    mgl::list<std::thread> m_workers;
+    std::queue<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_task_available;
+    std::condition_variable m_idle;
+    size_t m_active;
+    bool m_stop;
+  };
+
+} // namespace mgl
@@ -6,6 +6,7 @@
 #include "containers.hpp"
 
 #include <filesystem>
+#include <functional>
 
 #define BIT(x) 1 << x
 
@@ -44,4 +45,17 @@ namespace mgl
     return zipped;
   }
 
+  /**
+   * @brief Mixes the hash of a value into a seed.
+   *
+   * @tparam T The type of the value, it must be hashable with std::hash.
+   * @param seed The hash to update.
+   * @param value The value to mix in.
+   */
+  template <typename T>
+  void hash_combine(size_t& seed, const T& value)
+  {
+    seed ^= std::hash<T>{}(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+  }
+
 } // namespace  mgl
\ No newline at end of file
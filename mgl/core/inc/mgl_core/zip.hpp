@@ -44,6 +44,13 @@ public:
      */
     bool exists(const mgl::path& path) const;
 
+    /**
+     * Lists the names of all the entries stored in the ZIP archive.
+     * 
+     * @return The entry names, directories end with a '/'.
+     */
+    mgl::list<std::string> entries() const;
+
     /**
      * Checks if the zip_file object is valid.
      * 
@@ -0,0 +1,183 @@
+#include "mgl_core/lz4.hpp"
+#include "mgl_core/containers.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace mgl::lz4
+{
+  static constexpr size_t MIN_MATCH = 4;
+  static constexpr size_t LAST_LITERALS = 5;
+  static constexpr size_t MF_LIMIT = 12;
+  static constexpr size_t MAX_OFFSET = 65535;
+  static constexpr uint32_t HASH_BITS = 16;
+
+  static inline uint32_t read32(const uint8_t* p)
+  {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+  }
+
+  static inline uint32_t hash(uint32_t sequence)
+  {
+    return (sequence * 2654435761u) >> (32 - HASH_BITS);
+  }
+
+  static inline void write_length(uint8_t*& op, size_t length)
+  {
+    while(length >= 255)
+    {
+      *op++ = 255;
+      length -= 255;
+    }
+    *op++ = static_cast<uint8_t>(length);
+  }
+
+  static inline bool read_length(const uint8_t*& ip, const uint8_t* end, size_t& length)
+  {
+    uint8_t b;
+    do
+    {
+      if(ip >= end)
+        return false;
+      b = *ip++;
+      length += b;
+    } while(b == 255);
+    return true;
+  }
+
+  static void emit_sequence(uint8_t*& op,
+                            const uint8_t* literals,
+                            size_t literal_length,
+                            size_t offset,
+                            size_t match_length)
+  {
+    uint8_t* token = op++;
+    *token = static_cast<uint8_t>(std::min<size_t>(literal_length, 15) << 4);
+    if(literal_length >= 15)
+      write_length(op, literal_length - 15);
+
+    std::memcpy(op, literals, literal_length);
+    op += literal_length;
+
+    // The last sequence only carries literals
+    if(match_length == 0)
+      return;
+
+    *op++ = static_cast<uint8_t>(offset & 0xFF);
+    *op++ = static_cast<uint8_t>(offset >> 8);
+
+    match_length -= MIN_MATCH;
+    *token |= static_cast<uint8_t>(std::min<size_t>(match_length, 15));
+    if(match_length >= 15)
+      write_length(op, match_length - 15);
+  }
+
+  void compress(const uint8_t* src, size_t size, mgl::uint8_buffer& out)
+  {
+    out.resize(compress_bound(size));
+    uint8_t* op = out.data();
+
+    size_t ip = 0;
+    size_t anchor = 0;
+
+    // The format requires the last match to start MF_LIMIT bytes before the end of the block
+    if(size > MF_LIMIT)
+    {
+      mgl::list<uint32_t> table(size_t(1) << HASH_BITS, 0);
+      const size_t match_limit = size - MF_LIMIT;
+
+      while(ip < match_limit)
+      {
+        uint32_t sequence = read32(src + ip);
+        uint32_t h = hash(sequence);
+        size_t candidate = table[h];
+        table[h] = static_cast<uint32_t>(ip);
+
+        if(candidate >= ip || ip - candidate > MAX_OFFSET || read32(src + candidate) != sequence)
+        {
+          ip++;
+          continue;
+        }
+
+        size_t length = MIN_MATCH;
+        const size_t max_length = size - LAST_LITERALS - ip;
+        while(length < max_length && src[candidate + length] == src[ip + length])
+          length++;
+
+        while(ip > anchor && candidate > 0 && src[ip - 1] == src[candidate - 1])
+        {
+          ip--;
+          candidate--;
+          length++;
+        }
+
+        emit_sequence(op, src + anchor, ip - anchor, ip - candidate, length);
+        ip += length;
+        anchor = ip;
+      }
+    }
+
+    emit_sequence(op, src + anchor, size - anchor, 0, 0);
+    out.resize(static_cast<size_t>(op - out.data()));
+  }
+
+  bool decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t dst_size)
+  {
+    const uint8_t* ip = src;
+    const uint8_t* const end = src + size;
+    size_t op = 0;
+
+    while(ip < end)
+    {
+      const uint8_t token = *ip++;
+
+      size_t literal_length = token >> 4;
+      if(literal_length == 15 && !read_length(ip, end, literal_length))
+        return false;
+
+      if(literal_length > static_cast<size_t>(end - ip) || literal_length > dst_size - op)
+        return false;
+
+      std::memcpy(dst + op, ip, literal_length);
+      ip += literal_length;
+      op += literal_length;
+
+      if(ip == end)
+        break;
+
+      if(end - ip < 2)
+        return false;
+
+      const size_t offset = ip[0] | (ip[1] << 8);
+      ip += 2;
+      if(offset == 0 || offset > op)
+        return false;
+
+      size_t match_length = token & 15;
+      if(match_length == 15 && !read_length(ip, end, match_length))
+        return false;
+      match_length += MIN_MATCH;
+
+      if(match_length > dst_size - op)
+        return false;
+
+      // Matches may overlap their own output, which repeats the last offset bytes
+      const uint8_t* match = dst + op - offset;
+      if(offset >= match_length)
+      {
+        std::memcpy(dst + op, match, match_length);
+      }
+      else
+      {
+        for(size_t i = 0; i < match_length; i++)
+          dst[op + i] = match[i];
+      }
+      op += match_length;
+    }
+
+    return op == dst_size;
+  }
+
+} // namespace mgl::lz4
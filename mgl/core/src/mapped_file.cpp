@@ -0,0 +1,126 @@
+#include "mgl_core/mapped_file.hpp"
+#include "mgl_core/log.hpp"
+#include "mgl_core/platform.hpp"
+
+#include <algorithm>
+
+#ifdef MGL_PLATFORM_WINDOWS
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace mgl
+{
+  mapped_file::mapped_file(const mgl::path& path)
+      : m_path(path)
+  {
+#ifdef MGL_PLATFORM_WINDOWS
+    HANDLE file = CreateFileW(path.c_str(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if(file == INVALID_HANDLE_VALUE)
+    {
+      MGL_CORE_ERROR("mapped_file: failed to open {}", path.string());
+      return;
+    }
+
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+      CloseHandle(file);
+      return;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(mapping == nullptr)
+    {
+      MGL_CORE_ERROR("mapped_file: failed to map {}", path.string());
+      CloseHandle(file);
+      return;
+    }
+
+    m_data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if(m_data == nullptr)
+    {
+      MGL_CORE_ERROR("mapped_file: failed to map {}", path.string());
+      CloseHandle(mapping);
+      CloseHandle(file);
+      return;
+    }
+
+    m_size = static_cast<size_t>(size.QuadPart);
+    m_file = file;
+    m_mapping = mapping;
+#else
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd < 0)
+    {
+      MGL_CORE_ERROR("mapped_file: failed to open {}", path.string());
+      return;
+    }
+
+    struct stat st;
+    if(fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+      close(fd);
+      return;
+    }
+
+    // The mapping keeps its own reference to the file, the descriptor is not needed after this
+    void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if(data == MAP_FAILED)
+    {
+      MGL_CORE_ERROR("mapped_file: failed to map {}", path.string());
+      return;
+    }
+
+    m_data = static_cast<const uint8_t*>(data);
+    m_size = static_cast<size_t>(st.st_size);
+#endif
+  }
+
+  void mapped_file::prefetch(size_t offset, size_t size) const
+  {
+    if(m_data == nullptr || offset >= m_size)
+      return;
+
+    size = std::min(size, m_size - offset);
+
+#ifdef MGL_PLATFORM_WINDOWS
+    // PrefetchVirtualMemory is not available before Windows 8, touching every page faults it in
+    volatile uint8_t sink = 0;
+    for(size_t i = 0; i < size; i += 4096)
+      sink = sink ^ m_data[offset + i];
+#else
+    // madvise needs a page aligned start, the mapping itself always starts on a page
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t start = offset & ~(page - 1);
+    madvise(const_cast<uint8_t*>(m_data + start), size + (offset - start), MADV_WILLNEED);
+#endif
+  }
+
+  mapped_file::~mapped_file()
+  {
+    if(m_data == nullptr)
+      return;
+
+#ifdef MGL_PLATFORM_WINDOWS
+    UnmapViewOfFile(m_data);
+    CloseHandle(static_cast<HANDLE>(m_mapping));
+    CloseHandle(static_cast<HANDLE>(m_file));
+#else
+    munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+  }
+
+} // namespace mgl
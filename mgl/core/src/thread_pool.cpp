@@ -0,0 +1,83 @@
+#include "mgl_core/thread_pool.hpp"
+
+namespace mgl
+{
+  thread_pool::thread_pool(size_t threads)
+      : m_active(0)
+      , m_stop(false)
+  {
+    if(threads == 0)
+    {
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    m_workers.reserve(threads);
+    for(size_t i = 0; i < threads; i++)
+    {
+      m_workers.emplace_back(&thread_pool::worker, this);
+    }
+  }
+
+  thread_pool::~thread_pool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_task_available.notify_all();
+
+    for(auto& worker : m_workers)
+    {
+      worker.join();
+    }
+  }
+
+  void thread_pool::enqueue(std::function<void()> task)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_tasks.push(std::move(task));
+    }
+    m_task_available.notify_one();
+  }
+
+  void thread_pool::wait()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this]() { return m_tasks.empty() && m_active == 0; });
+  }
+
+  void thread_pool::worker()
+  {
+    while(true)
+    {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_task_available.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+
+        // Pending tasks are still executed when the pool is stopping
+        if(m_tasks.empty())
+        {
+          return;
+        }
+
+        task = std::move(m_tasks.front());
+        m_tasks.pop();
+        m_active++;
+      }
+
+      task();
+
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_active--;
+        if(m_tasks.empty() && m_active == 0)
+        {
+          m_idle.notify_all();
+        }
+      }
+    }
+  }
+
+} // namespace mgl
@@ -97,6 +97,37 @@ namespace mgl
     zip_close(z_file);
   }
 
+  mgl::list<std::string> zip_file::entries() const
+  {
+    mgl::list<std::string> names;
+
+    if(m_source.empty())
+    {
+      MGL_CORE_ERROR("zip_file: source is empty");
+      return names;
+    }
+
+    auto z_file = zip_open(m_source.c_str(), 0, nullptr);
+
+    if(!z_file)
+    {
+      MGL_CORE_ERROR("zip_file: error opening zip file: {0}", m_source);
+      return names;
+    }
+
+    auto count = zip_get_num_entries(z_file, 0);
+
+    for(zip_int64_t i = 0; i < count; i++)
+    {
+      zip_stat_t z_stat;
+      if(zip_stat_index(z_file, i, 0, &z_stat) == 0 && (z_stat.valid & ZIP_STAT_NAME))
+        names.push_back(z_stat.name);
+    }
+
+    zip_close(z_file);
+    return names;
+  }
+
   zip_ifstream_ref zip_file::open(const mgl::path& path) const
   {
     return mgl::create_ref<zip_ifstream>(m_source, path.string());
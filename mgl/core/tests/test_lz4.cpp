@@ -0,0 +1,62 @@
+#include "mgl_core/lz4.hpp"
+#include "gtest/gtest.h"
+
+static mgl::uint8_buffer roundtrip(const mgl::uint8_buffer& data)
+{
+  mgl::uint8_buffer compressed;
+  mgl::lz4::compress(data.data(), data.size(), compressed);
+  EXPECT_LE(compressed.size(), mgl::lz4::compress_bound(data.size()));
+
+  mgl::uint8_buffer result(data.size());
+  EXPECT_TRUE(
+      mgl::lz4::decompress(compressed.data(), compressed.size(), result.data(), result.size()));
+  return result;
+}
+
+TEST(mgl_core, lz4_roundtrip_test)
+{
+  EXPECT_EQ(roundtrip({}), mgl::uint8_buffer());
+  EXPECT_EQ(roundtrip({ 1, 2, 3 }), mgl::uint8_buffer({ 1, 2, 3 }));
+
+  mgl::uint8_buffer text;
+  for(int i = 0; i < 1000; i++)
+    for(char c : std::string("the quick brown fox "))
+      text.push_back(static_cast<uint8_t>(c));
+  EXPECT_EQ(roundtrip(text), text);
+
+  mgl::uint8_buffer noise(100000);
+  uint32_t seed = 1;
+  for(auto& b : noise)
+  {
+    seed = seed * 1664525u + 1013904223u;
+    b = static_cast<uint8_t>(seed >> 24);
+  }
+  EXPECT_EQ(roundtrip(noise), noise);
+}
+
+TEST(mgl_core, lz4_compresses_repeated_data_test)
+{
+  mgl::uint8_buffer zeros(1 << 20, 0);
+  mgl::uint8_buffer compressed;
+  mgl::lz4::compress(zeros.data(), zeros.size(), compressed);
+  EXPECT_LT(compressed.size(), zeros.size() / 100);
+}
+
+TEST(mgl_core, lz4_rejects_malformed_data_test)
+{
+  mgl::uint8_buffer data(64, 7);
+  mgl::uint8_buffer compressed;
+  mgl::lz4::compress(data.data(), data.size(), compressed);
+
+  mgl::uint8_buffer result(data.size());
+  EXPECT_FALSE(mgl::lz4::decompress(
+      compressed.data(), compressed.size() - 1, result.data(), result.size()));
+  EXPECT_FALSE(
+      mgl::lz4::decompress(compressed.data(), compressed.size(), result.data(), result.size() - 1));
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,31 @@
+#include "mgl_core/thread_pool.hpp"
+#include "gtest/gtest.h"
+
+#include <atomic>
+
+TEST(mgl_core, thread_pool_wait_test)
+{
+  mgl::thread_pool pool(4);
+  std::atomic<int> counter = 0;
+
+  for(int i = 0; i < 100; i++)
+  {
+    pool.enqueue([&counter]() { counter++; });
+  }
+
+  pool.wait();
+  EXPECT_EQ(counter, 100);
+}
+
+TEST(mgl_core, thread_pool_submit_test)
+{
+  mgl::thread_pool pool(2);
+  auto result = pool.submit([]() { return 42; });
+  EXPECT_EQ(result.get(), 42);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
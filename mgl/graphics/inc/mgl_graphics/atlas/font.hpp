@@ -9,6 +9,8 @@
 
 #include "mgl_platform/api/buffers.hpp"
 
+#include "glm/glm.hpp"
+
 namespace mgl::graphics
 {
   class font_atlas
@@ -35,6 +37,12 @@ public:
 
     const mgl::list<mgl::registry::font::glyph>& glyphs() const { return m_glyphs; }
 
+    void text_to_vertices(const glm::vec2& pos,
+                          const std::string& text,
+                          mgl::list<glm::vec4>& out,
+                          float sx = 1.0,
+                          float sy = 1.0) const;
+
     void text_to_vertices(const glm::vec2& pos,
                           const std::string& text,
                           float32_buffer& out,
@@ -48,10 +56,6 @@ public:
                           float sx = 1.0,
                           float sy = 1.0) const;
 
-private:
-    glm::vec4* text_to_vertices(
-        const glm::vec2& pos, const std::string& text, float sx, float sy, int32_t& vertices) const;
-
 private:
     mgl::registry::font_ref m_font;
     int32_t m_pixel_height;
@@ -2,6 +2,7 @@
 #include "batch.hpp"
 #include "enums.hpp"
 #include "glm/glm.hpp"
+#include "manager.hpp"
 #include "shader.hpp"
 #include "textures.hpp"
 
@@ -11,6 +12,8 @@
 #include "mgl_core/containers.hpp"
 #include "mgl_core/memory.hpp"
 
+#include <functional>
+
 namespace mgl::graphics
 {
   class render_command;
@@ -25,17 +28,45 @@ public:
     virtual void execute() = 0;
   };
 
+  struct text_vertex
+  {
+    glm::vec4 position_uv;
+    glm::vec4 color;
+  };
+
+  /**
+   * @brief A list of render commands that can be executed any number of times.
+   *
+   * A script built with a recorder is retained: its commands are only recorded again on the next
+   * execute() after it is marked dirty. Scripts are commands themselves, so a retained script can
+   * be called from another one and be re-recorded without touching its parent.
+   */
   class render_script : public render_command
 
   {
 public:
+    using recorder = std::function<void(render_script&)>;
+
     render_script();
 
     render_script(const mgl::platform::api::framebuffer_ref& target);
 
+    render_script(const recorder& record,
+                  const mgl::platform::api::framebuffer_ref& target = nullptr);
+
     ~render_script() { m_commands.clear(); }
 
-    void reset() { m_commands.clear(); }
+    void reset()
+    {
+      m_commands.clear();
+      m_text_batches.clear();
+    }
+
+    void mark_dirty() { m_dirty = true; }
+
+    bool is_dirty() const { return m_dirty; }
+
+    void call(const render_script_ref& script);
 
     void enable_state(int state);
 
@@ -45,7 +76,7 @@ public:
 
     void enable_texture(uint32_t slot, const std::string& name);
 
-    void enable_texture(uint32_t slot, uint32_t idx);
+    void enable_texture(uint32_t slot, handle h);
 
     void clear(const glm::vec4& color);
 
@@ -84,11 +115,13 @@ public:
 
     void draw_batch(const batch_ref& batch);
 
+    void flush_text();
+
     void enable_shader(shader_ref shader);
 
     void enable_shader(const std::string& name);
 
-    void enable_shader(uint32_t idx);
+    void enable_shader(handle h);
 
     void set_shader_uniform(const std::string& name, bool value);
 
@@ -125,10 +158,21 @@ public:
     void execute();
 
 private:
+    // Text is accumulated per font and drawn with one call per atlas when flushed
+    struct text_batch
+    {
+      std::string font;
+      mgl::list<text_vertex> vertices;
+    };
+
     void submit(const render_command_ref& command) { m_commands.push_back(command); }
 
     mgl::list<render_command_ref> m_commands;
     mgl::platform::api::framebuffer_ref m_render_target;
+    mgl::list<text_batch> m_text_batches;
+    mgl::list<glm::vec4> m_text_vertices;
+    recorder m_recorder;
+    bool m_dirty;
   };
 
 } // namespace mgl::graphics
\ No newline at end of file
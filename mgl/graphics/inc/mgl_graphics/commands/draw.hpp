@@ -2,6 +2,7 @@
 
 #include "mgl_graphics/batch.hpp"
 #include "mgl_graphics/command.hpp"
+#include "mgl_graphics/ring_buffer.hpp"
 
 #include "mgl_platform/api/buffers.hpp"
 #include "mgl_platform/api/render_api.hpp"
@@ -40,6 +41,28 @@ private:
     size_t m_instance_count;
   };
 
+  class draw_text_command : public render_command
+  {
+public:
+    draw_text_command(const ring_buffer_ref& ring, mgl::list<text_vertex>&& vertices)
+        : m_ring(ring)
+        , m_vertices(std::move(vertices))
+    { }
+
+    void execute() override final
+    {
+      size_t offset = m_ring->write(m_vertices.data(), sizeof(text_vertex) * m_vertices.size());
+      int32_t count = static_cast<int32_t>(m_vertices.size());
+      int32_t first = static_cast<int32_t>(offset / sizeof(text_vertex));
+      mgl::platform::api::render_api::render_call(
+          m_ring->buffer(), nullptr, count, first, render_mode::TRIANGLES);
+    }
+
+private:
+    ring_buffer_ref m_ring;
+    mgl::list<text_vertex> m_vertices;
+  };
+
   class draw_batch_command : public render_command
   {
 public:
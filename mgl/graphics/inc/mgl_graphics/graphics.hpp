@@ -7,6 +7,7 @@
 #include "managers/font.hpp"
 #include "managers/shader.hpp"
 #include "managers/texture.hpp"
+#include "ring_buffer.hpp"
 
 namespace mgl::graphics
 {
@@ -14,7 +15,17 @@ namespace mgl::graphics
 
   void shutdown();
 
-  inline size_t register_shader(const std::string& name, const shader_ref& shader)
+  void begin_frame();
+
+  void end_frame();
+
+  const ring_buffer_ref& text_buffer();
+
+  handle text_shader();
+
+  handle occlusion_shader();
+
+  inline handle register_shader(const std::string& name, const shader_ref& shader)
   {
     return shaders().add_item(name, shader);
   }
@@ -24,22 +35,37 @@ namespace mgl::graphics
     shaders().remove_item(name);
   }
 
+  inline void unregister_shader(handle h)
+  {
+    shaders().remove_item(h);
+  }
+
   inline bool has_shader(const std::string& name)
   {
     return shaders().has_item(name);
   }
 
+  inline bool has_shader(handle h)
+  {
+    return shaders().has_item(h);
+  }
+
+  inline handle find_shader(const std::string& name)
+  {
+    return shaders().find_item(name);
+  }
+
   inline shader_ref get_shader(const std::string& name)
   {
     return shaders().get_item(name);
   }
 
-  inline shader_ref get_shader(size_t idx)
+  inline shader_ref get_shader(handle h)
   {
-    return shaders().get_item(idx);
+    return shaders().get_item(h);
   }
 
-  inline size_t register_texture(const std::string& name, const texture_ref& texture)
+  inline handle register_texture(const std::string& name, const texture_ref& texture)
   {
     return textures().add_item(name, texture);
   }
@@ -49,22 +75,37 @@ namespace mgl::graphics
     textures().remove_item(name);
   }
 
+  inline void unregister_texture(handle h)
+  {
+    textures().remove_item(h);
+  }
+
   inline bool has_texture(const std::string& name)
   {
     return textures().has_item(name);
   }
 
+  inline bool has_texture(handle h)
+  {
+    return textures().has_item(h);
+  }
+
+  inline handle find_texture(const std::string& name)
+  {
+    return textures().find_item(name);
+  }
+
   inline texture_ref get_texture(const std::string& name)
   {
     return textures().get_item(name);
   }
 
-  inline texture_ref get_texture(size_t idx)
+  inline texture_ref get_texture(handle h)
   {
-    return textures().get_item(idx);
+    return textures().get_item(h);
   }
 
-  inline size_t register_buffer(const std::string& name,
+  inline handle register_buffer(const std::string& name,
                                 const mgl::platform::api::buffer_ref& buffer)
   {
     return buffers().add_item(name, buffer);
@@ -75,22 +116,37 @@ namespace mgl::graphics
     buffers().remove_item(name);
   }
 
+  inline void unregister_buffer(handle h)
+  {
+    buffers().remove_item(h);
+  }
+
   inline bool has_buffer(const std::string& name)
   {
     return buffers().has_item(name);
   }
 
+  inline bool has_buffer(handle h)
+  {
+    return buffers().has_item(h);
+  }
+
+  inline handle find_buffer(const std::string& name)
+  {
+    return buffers().find_item(name);
+  }
+
   inline mgl::platform::api::buffer_ref get_buffer(const std::string& name)
   {
     return buffers().get_item(name);
   }
 
-  inline mgl::platform::api::buffer_ref get_buffer(size_t idx)
+  inline mgl::platform::api::buffer_ref get_buffer(handle h)
   {
-    return buffers().get_item(idx);
+    return buffers().get_item(h);
   }
 
-  inline size_t register_font(const std::string& name, const mgl::registry::font_ref& font)
+  inline handle register_font(const std::string& name, const mgl::registry::font_ref& font)
   {
     return fonts().add_item(name, font);
   }
@@ -100,19 +156,34 @@ namespace mgl::graphics
     fonts().remove_item(name);
   }
 
+  inline void unregister_font(handle h)
+  {
+    fonts().remove_item(h);
+  }
+
   inline bool has_font(const std::string& name)
   {
     return fonts().has_item(name);
   }
 
+  inline bool has_font(handle h)
+  {
+    return fonts().has_item(h);
+  }
+
+  inline handle find_font(const std::string& name)
+  {
+    return fonts().find_item(name);
+  }
+
   inline mgl::registry::font_ref get_font(const std::string& name)
   {
     return fonts().get_item(name);
   }
 
-  inline mgl::registry::font_ref get_font(size_t idx)
+  inline mgl::registry::font_ref get_font(handle h)
   {
-    return fonts().get_item(idx);
+    return fonts().get_item(h);
   }
 
 } // namespace mgl::graphics
\ No newline at end of file
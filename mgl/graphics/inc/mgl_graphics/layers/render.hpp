@@ -8,7 +8,7 @@ namespace mgl::graphics::layers
   class render_layer : public layer
   {
 public:
-    render_layer(const std::string& name = "Renderer Layer");
+    render_layer(const std::string& name = "Renderer Layer", bool retained = false);
 
     virtual ~render_layer() override = default;
 
@@ -21,6 +21,19 @@ public:
     virtual void render_prepare(render_script& script) = 0;
 
     void on_event(mgl::platform::event& event) override;
+
+    // A retained layer only calls render_prepare again after being marked dirty
+    void set_retained(bool retained) { m_retained = retained; }
+
+    bool is_retained() const { return m_retained; }
+
+    void mark_dirty() { m_script->mark_dirty(); }
+
+    bool is_dirty() const { return m_script->is_dirty(); }
+
+private:
+    render_script_ref m_script;
+    bool m_retained;
   };
 
   class null_render_layer : public render_layer
@@ -3,87 +3,162 @@
 #include "mgl_core/containers.hpp"
 #include "mgl_core/debug.hpp"
 
+#include <mutex>
+#include <shared_mutex>
+
 namespace mgl::graphics
 {
+  /**
+   * @brief Generational handle to an item stored in a manager.
+   *
+   * A handle stays valid until its item is removed, after that the slot generation changes and
+   * the handle is detected as stale. Generation 0 is never used so a default handle is invalid.
+   */
+  struct handle
+  {
+    uint32_t index = 0;
+    uint32_t generation = 0;
+
+    handle() = default;
+
+    handle(uint32_t index, uint32_t generation)
+        : index(index)
+        , generation(generation)
+    { }
+
+    explicit handle(uint64_t id)
+        : index(static_cast<uint32_t>(id & 0xFFFFFFFF))
+        , generation(static_cast<uint32_t>(id >> 32))
+    { }
+
+    uint64_t id() const { return (static_cast<uint64_t>(generation) << 32) | index; }
+
+    bool valid() const { return generation != 0; }
+
+    bool operator==(const handle& other) const = default;
+  };
+
+  /**
+   * @brief Named storage for graphics resources.
+   *
+   * Lookups can be done from any thread, adding and removing items calls on_add and on_remove,
+   * which usually touch the GPU, so they must be done from the render thread.
+   */
   template <typename T>
   class manager
   {
-    struct database
+    // Items live in a dense slot array indexed by handle, names are only used to resolve handles
+    struct slot_map
     {
-      mgl::unordered_map<std::string, T> items_by_name;
-      mgl::unordered_map<size_t, T> items_by_idx;
-      mgl::unordered_map<std::string, size_t> item_idx_by_name;
-      mgl::unordered_map<size_t, std::string> item_name_by_idx;
-      size_t item_idx = 1;
+      struct slot
+      {
+        T item;
+        uint32_t generation = 1;
+        bool used = false;
+      };
+
+      mgl::list<slot> slots;
+      mgl::list<std::string> names;
+      mgl::list<uint32_t> free_slots;
+      mgl::unordered_map<std::string, handle> handles;
 
-      size_t add_item(const std::string& name, const T& item)
+      handle add_item(const std::string& name, const T& item)
       {
-        if(items_by_name.find(name) != items_by_name.end())
-          return 0;
-
-        items_by_name[name] = item;
-        items_by_idx[item_idx] = item;
-        item_idx_by_name[name] = item_idx;
-        item_name_by_idx[item_idx] = name;
-        return item_idx++;
+        if(handles.find(name) != handles.end())
+          return handle();
+
+        uint32_t index;
+        if(free_slots.empty())
+        {
+          index = static_cast<uint32_t>(slots.size());
+          slots.push_back({});
+          names.push_back({});
+        }
+        else
+        {
+          index = free_slots.back();
+          free_slots.pop_back();
+        }
+
+        auto& s = slots[index];
+        s.item = item;
+        s.used = true;
+        names[index] = name;
+
+        handle h(index, s.generation);
+        handles[name] = h;
+        return h;
       }
 
-      void remove_item(const std::string& name)
+      void remove_item(handle h)
       {
-        if(items_by_name.find(name) == items_by_name.end())
+        if(!is_valid(h))
           return;
 
-        items_by_name.erase(name);
-        items_by_idx.erase(item_idx_by_name[name]);
-        item_name_by_idx.erase(item_idx_by_name[name]);
-        item_idx_by_name.erase(name);
+        auto& s = slots[h.index];
+        s.item = T();
+        s.used = false;
+        // Skip generation 0 on wrap around, it marks invalid handles
+        s.generation = s.generation == UINT32_MAX ? 1 : s.generation + 1;
+
+        handles.erase(names[h.index]);
+        names[h.index].clear();
+        free_slots.push_back(h.index);
       }
 
-      void remove_item(size_t idx)
+      handle find_item(const std::string& name) const
       {
-        if(items_by_idx.find(idx) == items_by_idx.end())
-          return;
+        auto it = handles.find(name);
+        return it != handles.end() ? it->second : handle();
+      }
 
-        items_by_idx.erase(idx);
-        items_by_name.erase(item_name_by_idx[idx]);
-        item_idx_by_name.erase(item_name_by_idx[idx]);
-        item_name_by_idx.erase(idx);
+      T& get_item(handle h)
+      {
+        MGL_CORE_ASSERT(is_valid(h), "Item does not exist or handle is stale");
+        return slots[h.index].item;
       }
 
-      T& get_item(const std::string& name)
+      const T& get_item(handle h) const
       {
-        MGL_CORE_ASSERT(items_by_name.find(name) != items_by_name.end(), "Item does not exist");
-        return items_by_name[name];
+        MGL_CORE_ASSERT(is_valid(h), "Item does not exist or handle is stale");
+        return slots[h.index].item;
       }
 
-      T& get_item(size_t idx)
+      const std::string& get_name(handle h) const
       {
-        MGL_CORE_ASSERT(items_by_idx.find(idx) != items_by_idx.end(), "Item does not exist");
-        return items_by_idx[idx];
+        MGL_CORE_ASSERT(is_valid(h), "Item does not exist or handle is stale");
+        return names[h.index];
       }
 
-      bool has_item(const std::string& name)
+      bool is_valid(handle h) const
       {
-        return items_by_name.find(name) != items_by_name.end();
+        return h.index < slots.size() && slots[h.index].used &&
+               slots[h.index].generation == h.generation;
       }
 
       void clear()
       {
-        items_by_name.clear();
-        items_by_idx.clear();
-        item_idx_by_name.clear();
-        item_name_by_idx.clear();
-        item_idx = 0;
+        // Bump every generation so handles from before the clear are detected as stale
+        for(uint32_t i = 0; i < slots.size(); i++)
+        {
+          if(slots[i].used)
+          {
+            remove_item(handle(i, slots[i].generation));
+          }
+        }
       }
     };
 
 public:
-    size_t add_item(const std::string& name, const T& item);
+    handle add_item(const std::string& name, const T& item);
     void remove_item(const std::string& name);
-    void remove_item(size_t idx);
-    T& get_item(const std::string& name);
-    T& get_item(size_t idx);
-    bool has_item(const std::string& name);
+    void remove_item(handle h);
+    handle find_item(const std::string& name) const;
+    // Unknown names and stale handles return a default constructed item
+    T get_item(const std::string& name) const;
+    T get_item(handle h) const;
+    bool has_item(const std::string& name) const;
+    bool has_item(handle h) const;
     void clear();
 
 protected:
@@ -91,67 +166,99 @@ protected:
     virtual void on_remove(const T& item, const std::string& name) = 0;
 
 protected:
-    database m_database;
+    slot_map m_slots;
+    mutable std::shared_mutex m_mutex;
   };
 
   template <typename T>
-  size_t manager<T>::add_item(const std::string& name, const T& item)
+  handle manager<T>::add_item(const std::string& name, const T& item)
   {
-    size_t idx = m_database.add_item(name, item);
-    if(idx == 0)
-      return 0;
+    std::unique_lock lock(m_mutex);
+    handle h = m_slots.add_item(name, item);
+    if(!h.valid())
+      return h;
     on_add(item, name);
-    return idx;
+    return h;
   }
 
   template <typename T>
   void manager<T>::remove_item(const std::string& name)
   {
-    auto item = m_database.get_item(name);
-    if(item == nullptr)
+    std::unique_lock lock(m_mutex);
+    handle h = m_slots.find_item(name);
+    if(!m_slots.is_valid(h))
       return;
 
-    on_remove(item, name);
-    m_database.remove_item(name);
+    on_remove(m_slots.get_item(h), name);
+    m_slots.remove_item(h);
   }
 
   template <typename T>
-  void manager<T>::remove_item(size_t idx)
+  void manager<T>::remove_item(handle h)
   {
-    auto item = m_database.get_item(idx);
-    if(item == nullptr)
+    std::unique_lock lock(m_mutex);
+    if(!m_slots.is_valid(h))
       return;
 
-    on_remove(item);
-    m_database.remove_item(idx);
+    on_remove(m_slots.get_item(h), m_slots.get_name(h));
+    m_slots.remove_item(h);
   }
 
   template <typename T>
-  T& manager<T>::get_item(const std::string& name)
+  handle manager<T>::find_item(const std::string& name) const
   {
-    return m_database.get_item(name);
+    std::shared_lock lock(m_mutex);
+    return m_slots.find_item(name);
   }
 
   template <typename T>
-  T& manager<T>::get_item(size_t idx)
+  T manager<T>::get_item(const std::string& name) const
   {
-    return m_database.get_item(idx);
+    std::shared_lock lock(m_mutex);
+    handle h = m_slots.find_item(name);
+    if(!m_slots.is_valid(h))
+      return T();
+
+    return m_slots.get_item(h);
+  }
+
+  template <typename T>
+  T manager<T>::get_item(handle h) const
+  {
+    std::shared_lock lock(m_mutex);
+    if(!m_slots.is_valid(h))
+      return T();
+
+    return m_slots.get_item(h);
   }
 
   template <typename T>
   void manager<T>::clear()
   {
-    for(auto& item : m_database.items_by_name)
+    std::unique_lock lock(m_mutex);
+    for(uint32_t i = 0; i < m_slots.slots.size(); i++)
     {
-      on_remove(item.second, item.first);
+      auto& s = m_slots.slots[i];
+      if(s.used)
+      {
+        on_remove(s.item, m_slots.names[i]);
+      }
     }
-    m_database.clear();
+    m_slots.clear();
+  }
+
+  template <typename T>
+  bool manager<T>::has_item(const std::string& name) const
+  {
+    std::shared_lock lock(m_mutex);
+    return m_slots.find_item(name).valid();
   }
 
   template <typename T>
-  bool manager<T>::has_item(const std::string& name)
+  bool manager<T>::has_item(handle h) const
   {
-    return m_database.has_item(name);
+    std::shared_lock lock(m_mutex);
+    return m_slots.is_valid(h);
   }
 
-} // namespace mgl::graphics
\ No newline at end of file
+} // namespace mgl::graphics
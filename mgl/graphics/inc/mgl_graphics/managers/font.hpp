@@ -26,8 +26,8 @@ public:
     virtual void on_remove(const mgl::registry::font_ref& font,
                            const std::string& name) override final;
 
-    const font_atlas_ref& get_atlas(const std::string& name) const;
-    const texture2d_ref& get_texture(const std::string& name) const;
+    font_atlas_ref get_atlas(const std::string& name) const;
+    texture2d_ref get_texture(const std::string& name) const;
 
     static font_manager& instance()
     {
@@ -0,0 +1,92 @@
+#pragma once
+#include "mgl_core/containers.hpp"
+#include "mgl_core/memory.hpp"
+
+#include "mgl_platform/api/buffers.hpp"
+#include "mgl_platform/api/query.hpp"
+#include "mgl_platform/api/vertex_array.hpp"
+
+#include "glm/glm.hpp"
+
+namespace mgl::graphics
+{
+  class occlusion_culler;
+  using occlusion_culler_ref = mgl::ref<occlusion_culler>;
+
+  /**
+   * @brief Skips the draws of objects hidden behind the rest of the scene.
+   *
+   * Every frame the bounding box of each object is rendered against the depth buffer into an
+   * occlusion query, with color and depth writes off. The draws of the next frame are wrapped in
+   * a conditional render on that query, so the GPU discards them without the CPU ever waiting for
+   * a result. Results that are already available are polled to keep an object drawn for a few
+   * frames after it was last seen, which hides the one frame latency when it comes into view.
+   */
+  class occlusion_culler
+  {
+public:
+    /**
+     * @param hysteresis Frames an object is drawn unconditionally after it was last visible.
+     * @param padding Distance the boxes are grown by, so they are not hidden by their own object.
+     */
+    occlusion_culler(uint32_t hysteresis = 4, float padding = 0.01f);
+
+    ~occlusion_culler() = default;
+
+    // Registers an object by its world space bounding box, returns the id used to draw it
+    uint32_t add(const glm::vec3& min, const glm::vec3& max);
+
+    void update(uint32_t id, const glm::vec3& min, const glm::vec3& max);
+
+    // The id and the query of a removed object are reused by the next one added
+    void remove(uint32_t id);
+
+    // Draws issued until end_draw() are discarded by the GPU if the object was hidden last frame
+    void begin_draw(uint32_t id);
+
+    void end_draw(uint32_t id);
+
+    /**
+     * @brief Tests the bounding box of every object against the current depth buffer.
+     *
+     * Call once per frame after the scene was drawn, with the scene's depth test enabled and the
+     * view and projection matrices set.
+     * @param eye The camera position, objects whose box contains it are always visible.
+     */
+    void render_proxies(const glm::vec3& eye);
+
+    // Whether the object was seen within the hysteresis window, from the results polled so far
+    bool visible(uint32_t id) const;
+
+    // Whether the draws since begin_draw() are wrapped in a conditional render
+    bool conditional(uint32_t id) const;
+
+    size_t size() const { return m_objects.size() - m_free_ids.size(); }
+
+    uint64_t frame() const { return m_frame; }
+
+    void release();
+
+private:
+    struct object
+    {
+      glm::vec3 min;
+      glm::vec3 max;
+      mgl::platform::api::occlusion_query_ref query;
+      uint64_t last_visible;
+      bool issued;
+      bool conditional;
+    };
+
+    mgl::list<object> m_objects;
+    mgl::list<uint32_t> m_free_ids;
+    mgl::list<mgl::platform::api::occlusion_query_ref> m_free_queries;
+    uint32_t m_hysteresis;
+    float m_padding;
+    uint64_t m_frame;
+    mgl::platform::api::vertex_buffer_ref m_proxy_vertices;
+    mgl::platform::api::index_buffer_ref m_proxy_indices;
+    mgl::platform::api::vertex_array_ref m_proxy;
+  };
+
+} // namespace mgl::graphics
@@ -0,0 +1,45 @@
+#pragma once
+#include "command.hpp"
+
+#include "mgl_platform/api/framebuffer.hpp"
+
+#include "mgl_core/containers.hpp"
+#include "mgl_core/thread_pool.hpp"
+
+namespace mgl::graphics
+{
+  /**
+   * @brief Records render scripts on worker threads and executes them on the render thread.
+   *
+   * Recording only reads resources and builds command lists, it never calls the graphics API, so
+   * scripts can be recorded in parallel. execute() waits for the recordings and runs the scripts
+   * in the order record() was called, regardless of the order in which the workers finished.
+   */
+  class render_queue
+  {
+public:
+    render_queue(size_t threads = 0);
+
+    ~render_queue();
+
+    render_queue(const render_queue&) = delete;
+
+    render_queue& operator=(const render_queue&) = delete;
+
+    render_script_ref record(const render_script::recorder& record,
+                             const mgl::platform::api::framebuffer_ref& target = nullptr);
+
+    void wait();
+
+    void execute();
+
+    void clear();
+
+    size_t size() const { return m_scripts.size(); }
+
+private:
+    mgl::thread_pool m_pool;
+    mgl::list<render_script_ref> m_scripts;
+  };
+
+} // namespace mgl::graphics
@@ -0,0 +1,73 @@
+#pragma once
+#include "mgl_core/containers.hpp"
+#include "mgl_core/memory.hpp"
+
+#include "mgl_platform/api/buffers.hpp"
+#include "mgl_platform/api/fence.hpp"
+
+namespace mgl::graphics
+{
+  class ring_buffer;
+  using ring_buffer_ref = mgl::ref<ring_buffer>;
+
+  /**
+   * @brief Streaming vertex buffer partitioned in one region per frame in flight.
+   *
+   * Each frame writes only to its own region, a fence is inserted at the end of the frame and
+   * waited on before the region is reused. If a frame needs more space than the region provides
+   * the buffer is replaced by a larger one, the old one is released once no frame can use it.
+   */
+  class ring_buffer
+  {
+public:
+    ring_buffer(const std::string& layout,
+                const mgl::string_list& attrs,
+                size_t frame_size,
+                uint32_t frames = 3);
+
+    ~ring_buffer() = default;
+
+    void allocate();
+
+    void free();
+
+    void begin_frame();
+
+    void end_frame();
+
+    /**
+     * @brief Writes data to the current frame region, growing the buffer if needed.
+     * @return The byte offset of the data in the buffer returned by buffer().
+     */
+    size_t write(const void* data, size_t size);
+
+    const mgl::platform::api::vertex_buffer_ref& buffer() const { return m_buffer; }
+
+    size_t frame_size() const { return m_frame_size; }
+
+    size_t used() const { return m_used; }
+
+    uint32_t frames() const { return m_frames; }
+
+private:
+    struct retired_buffer
+    {
+      mgl::platform::api::vertex_buffer_ref buffer;
+      uint64_t frame;
+    };
+
+    void grow(size_t size);
+
+    std::string m_layout;
+    mgl::string_list m_attrs;
+    size_t m_frame_size;
+    size_t m_used;
+    uint32_t m_frames;
+    uint32_t m_index;
+    uint64_t m_frame;
+    mgl::platform::api::vertex_buffer_ref m_buffer;
+    mgl::list<mgl::platform::api::fence_ref> m_fences;
+    mgl::list<retired_buffer> m_retired;
+  };
+
+} // namespace mgl::graphics
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "mgl_core/string.hpp"
+#include "mgl_graphics/shader.hpp"
+
+namespace mgl::graphics::builtins
+{
+  class occlusion_shader : public mgl::graphics::shader
+  {
+public:
+    occlusion_shader() = default;
+
+    virtual void prepare() override final;
+    virtual void load() override final;
+  };
+
+} // namespace mgl::graphics::builtins
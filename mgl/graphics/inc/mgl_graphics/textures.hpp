@@ -65,6 +65,12 @@ public:
         , m_opts(opts)
     { }
 
+    // Prepared mip chain, e.g. from the registry texture cache, all of its levels are uploaded
+    texture2d(const mgl::registry::texture_data_ref& data, const texture_opts& opts = {})
+        : m_data(data)
+        , m_opts(opts)
+    { }
+
     ~texture2d() = default;
 
     virtual texture::type texture_type() override final { return texture::type::TEXTURE_2D; }
@@ -72,8 +78,11 @@ public:
     virtual void load() override final
     {
       MGL_CORE_ASSERT(m_texture == nullptr, "Texture already loaded");
-      MGL_CORE_ASSERT(m_image != nullptr, "Image is null");
-      m_texture = mgl::platform::api::render_api::create_texture_2d(m_image, m_opts.samples);
+      MGL_CORE_ASSERT(m_image != nullptr || m_data != nullptr, "Image is null");
+      if(m_data != nullptr)
+        m_texture = mgl::platform::api::render_api::create_texture_2d(m_data, m_opts.samples);
+      else
+        m_texture = mgl::platform::api::render_api::create_texture_2d(m_image, m_opts.samples);
       MGL_CORE_ASSERT(m_texture != nullptr, "Texture is null");
       // tex->set_filter({ (int)m_opts.min_filter, (int)m_opts.mag_filter });
     }
@@ -86,6 +95,7 @@ public:
 
 private:
     mgl::registry::image_ref m_image;
+    mgl::registry::texture_data_ref m_data;
     texture_opts m_opts;
   };
 
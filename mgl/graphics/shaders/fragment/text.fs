@@ -1,10 +1,10 @@
 #version 330 core
 
 in vec2 f_uv;
+in vec4 f_color;
 out vec4 o_color;
 
 uniform sampler2D atlas;
-uniform vec4 color;
 uniform float px_range;
 
 float screen_px_range() {
@@ -18,5 +18,5 @@ void main()
   float sdf = texture(atlas, f_uv).r;
   float screen_px_distance = screen_px_range()*(sdf - 0.5);
   float alpha = clamp(screen_px_distance + 0.5, 0.0, 1.0);
-  o_color = vec4(color.rgb, alpha*color.a);
+  o_color = vec4(f_color.rgb, alpha*f_color.a);
 }
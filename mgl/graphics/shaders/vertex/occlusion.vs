@@ -0,0 +1,12 @@
+#version 330 core
+layout (location = 0) in vec3 i_position; // unit cube corner
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec3 box_min;
+uniform vec3 box_max;
+
+void main()
+{
+  gl_Position = projection * view * vec4(mix(box_min, box_max, i_position), 1.0);
+}
@@ -1,8 +1,10 @@
 #version 330 core
 layout (location = 0) in vec2 i_position; 
 layout (location = 1) in vec2 i_uv; 
+layout (location = 2) in vec4 i_color; 
 
 out vec2 f_uv;
+out vec4 f_color;
 
 uniform mat4 projection; // ortho matrix
 
@@ -10,5 +12,6 @@ void main()
 {
   gl_Position = projection  * vec4(i_position.xy, 0.0, 1.0);
   f_uv = i_uv;
+  f_color = i_color;
 }
 
@@ -30,10 +30,13 @@ namespace mgl::graphics
     }
   }
 
-  glm::vec4* font_atlas::text_to_vertices(
-      const glm::vec2& pos, const std::string& text, float sx, float sy, int32_t& vertices) const
+  void font_atlas::text_to_vertices(const glm::vec2& pos,
+                                    const std::string& text,
+                                    mgl::list<glm::vec4>& out,
+                                    float sx,
+                                    float sy) const
   {
-    glm::vec4* coords = new glm::vec4[6 * text.size()];
+    out.reserve(out.size() + 6 * text.size());
 
     float scale = m_font->get_scale_for_pixel_height(m_pixel_height);
     int32_t row_height =
@@ -45,8 +48,6 @@ namespace mgl::graphics
     float x = pos.x;
     float y = pos.y - row_height;
 
-    int32_t i = 0;
-    vertices = 0;
     for(auto& c : text)
     {
       if(c == '\n')
@@ -69,31 +70,27 @@ namespace mgl::graphics
       float x1 = x0 + g.width * sx;
       float y1 = y0 + g.height * sy;
 
-      coords[i++] = { x0, y0, g.u0, g.v1 };
-      coords[i++] = { x0, y1, g.u0, g.v0 };
-      coords[i++] = { x1, y1, g.u1, g.v0 };
-      coords[i++] = { x1, y1, g.u1, g.v0 };
-      coords[i++] = { x1, y0, g.u1, g.v1 };
-      coords[i++] = { x0, y0, g.u0, g.v1 };
+      out.push_back({ x0, y0, g.u0, g.v1 });
+      out.push_back({ x0, y1, g.u0, g.v0 });
+      out.push_back({ x1, y1, g.u1, g.v0 });
+      out.push_back({ x1, y1, g.u1, g.v0 });
+      out.push_back({ x1, y0, g.u1, g.v1 });
+      out.push_back({ x0, y0, g.u0, g.v1 });
 
       x += g.x_advance * sx;
-      vertices += 6;
     }
-
-    return coords;
   }
 
   void font_atlas::text_to_vertices(
       const glm::vec2& pos, const std::string& text, float32_buffer& out, float sx, float sy) const
   {
-    int32_t vertices;
-    glm::vec4* coords = text_to_vertices(pos, text, sx, sy, vertices);
+    mgl::list<glm::vec4> coords;
+    text_to_vertices(pos, text, coords, sx, sy);
 
-    std::copy(reinterpret_cast<const uint8_t*>(coords),
-              reinterpret_cast<const uint8_t*>(coords) + sizeof(glm::vec4) * vertices,
+    out.resize(coords.size() * 4);
+    std::copy(reinterpret_cast<const float*>(coords.data()),
+              reinterpret_cast<const float*>(coords.data()) + out.size(),
               out.data());
-
-    delete[] coords;
   }
 
   void font_atlas::text_to_vertices(const glm::vec2& pos,
@@ -103,9 +100,10 @@ namespace mgl::graphics
                                     float sx,
                                     float sy) const
   {
-    glm::vec4* coords = text_to_vertices(pos, text, sx, sy, vertices);
-    buffer->write(reinterpret_cast<const uint8_t*>(coords), sizeof(glm::vec4) * vertices);
-    delete[] coords;
+    mgl::list<glm::vec4> coords;
+    text_to_vertices(pos, text, coords, sx, sy);
+    vertices = static_cast<int32_t>(coords.size());
+    buffer->write(coords.data(), sizeof(glm::vec4) * coords.size());
   }
 
 } // namespace mgl::graphics
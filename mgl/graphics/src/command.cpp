@@ -12,28 +12,52 @@
 #include "mgl_core/profiling.hpp"
 
 #include "glm/gtc/matrix_transform.hpp"
+
+#include <algorithm>
 namespace mgl::graphics
 {
   render_script::render_script()
       : m_render_target(nullptr)
       , m_commands()
+      , m_text_batches()
+      , m_text_vertices()
+      , m_recorder(nullptr)
+      , m_dirty(false)
   {
-    auto vb = get_buffer("text_vb");
-    MGL_CORE_ASSERT(vb != nullptr, "Font vertex buffer is null");
-    vb->seek(0);
     m_commands.reserve(100);
   }
 
   render_script::render_script(const mgl::platform::api::framebuffer_ref& target)
       : m_render_target(target)
       , m_commands()
+      , m_text_batches()
+      , m_text_vertices()
+      , m_recorder(nullptr)
+      , m_dirty(false)
   {
-    auto vb = get_buffer("text_vb");
-    MGL_CORE_ASSERT(vb != nullptr, "Font vertex buffer is null");
-    vb->seek(0);
     m_commands.reserve(100);
   }
 
+  render_script::render_script(const recorder& record,
+                               const mgl::platform::api::framebuffer_ref& target)
+      : m_render_target(target)
+      , m_commands()
+      , m_text_batches()
+      , m_text_vertices()
+      , m_recorder(record)
+      , m_dirty(true)
+  {
+    MGL_CORE_ASSERT(m_recorder != nullptr, "Recorder is null");
+    m_commands.reserve(100);
+  }
+
+  void render_script::call(const render_script_ref& script)
+  {
+    MGL_CORE_ASSERT(script != nullptr, "Script is null");
+    MGL_CORE_ASSERT(script.get() != this, "Script cannot call itself");
+    submit(script);
+  }
+
   void render_script::enable_state(int state)
   {
     submit(mgl::create_ref<mgl::graphics::enable_state>(state));
@@ -56,9 +80,9 @@ namespace mgl::graphics
     submit(mgl::create_ref<mgl::graphics::enable_texture>(slot, tex));
   }
 
-  void render_script::enable_texture(uint32_t slot, uint32_t idx)
+  void render_script::enable_texture(uint32_t slot, handle h)
   {
-    auto tex = get_texture(idx);
+    auto tex = get_texture(h);
     MGL_CORE_ASSERT(tex != nullptr, "Texture is null");
     submit(mgl::create_ref<mgl::graphics::enable_texture>(slot, tex));
   }
@@ -124,9 +148,9 @@ namespace mgl::graphics
     submit(mgl::create_ref<mgl::graphics::enable_shader>(shader));
   }
 
-  void render_script::enable_shader(uint32_t idx)
+  void render_script::enable_shader(handle h)
   {
-    auto shader = get_shader(idx);
+    auto shader = get_shader(h);
     MGL_CORE_ASSERT(shader != nullptr, "Shader is null");
     submit(mgl::create_ref<mgl::graphics::enable_shader>(shader));
   }
@@ -214,6 +238,13 @@ namespace mgl::graphics
   void render_script::execute()
   {
     MGL_PROFILE_FUNCTION("RENDER_SCRIPT");
+    if(m_recorder != nullptr && m_dirty)
+    {
+      reset();
+      m_recorder(*this);
+      m_dirty = false;
+    }
+
     if(m_render_target != nullptr)
     {
       MGL_CORE_ASSERT(false, "Render target not implemented");
@@ -224,6 +255,8 @@ namespace mgl::graphics
       mgl::platform::api::render_api::bind_screen_framebuffer();
     }
 
+    flush_text();
+
     for(auto& command : m_commands)
     {
       command->execute();
@@ -238,33 +271,78 @@ namespace mgl::graphics
   {
     auto atlas = fonts().get_atlas(font);
     MGL_CORE_ASSERT(atlas != nullptr, "Font atlas is null");
-    auto tex = fonts().get_texture(font);
-    MGL_CORE_ASSERT(tex != nullptr, "Font texture is null");
 
-    auto shader = get_shader("text_shader");
+    // convert position to screen space
+    auto x = position.x;
+    auto y = mgl::platform::current_window().height() - position.y;
+
+    float scale = static_cast<float>(size) / atlas->pixel_height();
+    m_text_vertices.clear();
+    atlas->text_to_vertices({ x, y }, text, m_text_vertices, scale, scale);
+
+    if(m_text_vertices.empty())
+    {
+      return;
+    }
+
+    auto batch = std::find_if(m_text_batches.begin(),
+                              m_text_batches.end(),
+                              [&font](const text_batch& b) { return b.font == font; });
+
+    if(batch == m_text_batches.end())
+    {
+      m_text_batches.push_back({ font, {} });
+      batch = m_text_batches.end() - 1;
+    }
+
+    batch->vertices.reserve(batch->vertices.size() + m_text_vertices.size());
+    for(auto& v : m_text_vertices)
+    {
+      batch->vertices.push_back({ v, color });
+    }
+  }
+
+  void render_script::flush_text()
+  {
+    if(std::all_of(m_text_batches.begin(), m_text_batches.end(), [](const text_batch& b) {
+         return b.vertices.empty();
+       }))
+    {
+      return;
+    }
+
+    auto& ring = text_buffer();
+    MGL_CORE_ASSERT(ring != nullptr, "Text buffer is null");
+    auto shader = get_shader(text_shader());
     MGL_CORE_ASSERT(shader != nullptr, "Text shader is null");
-    auto vb = std::static_pointer_cast<mgl::platform::api::vertex_buffer>(get_buffer("text_vb"));
 
     set_projection(glm::ortho(0.0f,
                               static_cast<float>(mgl::platform::current_window().width()),
                               0.0f,
                               static_cast<float>(mgl::platform::current_window().height())));
     enable_shader(shader);
-    set_shader_uniform("color", color);
-    set_shader_uniform("px_range", static_cast<float>(atlas->pixel_height()));
-    enable_texture(0, tex);
     set_blend_func(blend_factor::SRC_ALPHA, blend_factor::ONE_MINUS_SRC_ALPHA);
     set_blend_equation(blend_equation_mode::ADD);
 
-    // convert position to screen space
-    auto x = position.x;
-    auto y = mgl::platform::current_window().height() - position.y;
-
-    int32_t vertices = 0;
-    int32_t first = vb->needle() / sizeof(glm::vec4);
-    float scale = static_cast<float>(size) / atlas->pixel_height();
-    atlas->text_to_vertices({ x, y }, text, vb, vertices, scale, scale);
-    draw(vb, nullptr, render_mode::TRIANGLES, vertices, first);
+    for(auto& batch : m_text_batches)
+    {
+      if(batch.vertices.empty())
+      {
+        continue;
+      }
+
+      auto atlas = fonts().get_atlas(batch.font);
+      MGL_CORE_ASSERT(atlas != nullptr, "Font atlas is null");
+      auto tex = fonts().get_texture(batch.font);
+      MGL_CORE_ASSERT(tex != nullptr, "Font texture is null");
+
+      set_shader_uniform("px_range", static_cast<float>(atlas->pixel_height()));
+      enable_texture(0, tex);
+
+      // The vertices are uploaded when the command executes, so retained scripts stay valid
+      submit(mgl::create_ref<mgl::graphics::draw_text_command>(ring, std::move(batch.vertices)));
+      batch.vertices.clear();
+    }
 
     disable_shader();
     clear_samplers(0, 1);
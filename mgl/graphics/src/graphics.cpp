@@ -5,6 +5,7 @@
 #include "mgl_graphics/commands/state.hpp"
 #include "mgl_graphics/commands/texture.hpp"
 #include "mgl_graphics/fonts/default.hpp"
+#include "mgl_graphics/shaders/occlusion.hpp"
 #include "mgl_graphics/shaders/text.hpp"
 
 #include "mgl_platform/api/render_api.hpp"
@@ -14,10 +15,15 @@
 #include "mgl_core/debug.hpp"
 #include "mgl_core/profiling.hpp"
 
-#define TEXT_BUFFER_SIZE 4096 * sizeof(float) * 6 * 4
+// Per frame size of the text ring buffer, grows on demand
+#define TEXT_BUFFER_SIZE 4096 * sizeof(float) * 6 * 8
 
 namespace mgl::graphics
 {
+  static ring_buffer_ref s_text_buffer = nullptr;
+  static handle s_text_shader;
+  static handle s_occlusion_shader;
+
   void init()
   {
     MGL_PROFILE_FUNCTION("GRAPHICS INIT");
@@ -25,12 +31,48 @@ namespace mgl::graphics
     auto font = mgl::create_ref<mgl::registry::truetype_font>(default_font, default_font_len);
     register_font("default", font);
     MGL_CORE_INFO("Creating vertex buffer and shader for text rendering.");
-    register_buffer("text_vb",
-                    mgl::platform::api::render_api::create_vertex_buffer(
-                        TEXT_BUFFER_SIZE, "2f 2f", { "i_position", "i_uv" }, true));
-    register_shader("text_shader", mgl::create_ref<builtins::text_shader>());
+    s_text_buffer = mgl::create_ref<ring_buffer>(
+        "2f 2f 4f", mgl::string_list{ "i_position", "i_uv", "i_color" }, TEXT_BUFFER_SIZE);
+    s_text_buffer->allocate();
+    s_text_shader = register_shader("text_shader", mgl::create_ref<builtins::text_shader>());
+    s_occlusion_shader =
+        register_shader("occlusion_shader", mgl::create_ref<builtins::occlusion_shader>());
+  }
+
+  void shutdown()
+  {
+    if(s_text_buffer != nullptr)
+    {
+      s_text_buffer->free();
+      s_text_buffer = nullptr;
+    }
+  }
+
+  void begin_frame()
+  {
+    MGL_CORE_ASSERT(s_text_buffer != nullptr, "Graphics not initialized");
+    s_text_buffer->begin_frame();
+  }
+
+  void end_frame()
+  {
+    MGL_CORE_ASSERT(s_text_buffer != nullptr, "Graphics not initialized");
+    s_text_buffer->end_frame();
   }
 
-  void shutdown() { }
+  const ring_buffer_ref& text_buffer()
+  {
+    return s_text_buffer;
+  }
+
+  handle text_shader()
+  {
+    return s_text_shader;
+  }
+
+  handle occlusion_shader()
+  {
+    return s_occlusion_shader;
+  }
 
 } // namespace mgl::graphics
\ No newline at end of file
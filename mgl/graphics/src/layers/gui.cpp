@@ -15,6 +15,10 @@
 #include <glm/gtc/matrix_transform.hpp>
 namespace mgl::graphics::layers
 {
+  static handle s_gui_shader;
+  static handle s_gui_vb;
+  static handle s_gui_ib;
+
   gui_layer::gui_layer(const std::string& name)
       : layer(name)
   { }
@@ -89,11 +93,11 @@ namespace mgl::graphics::layers
       return;
     }
 
-    register_shader("gui", mgl::create_ref<builtins::gui_shader>());
-    register_buffer("gui_vb",
-                    mgl::platform::api::render_api::create_vertex_buffer(
-                        "2f 2f 4f1", { "i_position", "i_uv", "i_color" }, true));
-    register_buffer(
+    s_gui_shader = register_shader("gui", mgl::create_ref<builtins::gui_shader>());
+    s_gui_vb = register_buffer("gui_vb",
+                               mgl::platform::api::render_api::create_vertex_buffer(
+                                   "2f 2f 4f1", { "i_position", "i_uv", "i_color" }, true));
+    s_gui_ib = register_buffer(
         "gui_ib", mgl::platform::api::render_api::create_index_buffer(0, sizeof(ImDrawIdx), true));
 
     refresh_font();
@@ -193,8 +197,8 @@ namespace mgl::graphics::layers
     if(has_texture("gui_font"))
       unregister_texture("gui_font");
 
-    size_t id = register_texture("gui_font", mgl::create_ref<mgl::graphics::texture2d>(image));
-    io.Fonts->TexID = reinterpret_cast<void*>(id);
+    handle h = register_texture("gui_font", mgl::create_ref<mgl::graphics::texture2d>(image));
+    io.Fonts->TexID = reinterpret_cast<void*>(static_cast<uintptr_t>(h.id()));
   }
 
   void gui_layer::shutdown_subsystem()
@@ -203,9 +207,9 @@ namespace mgl::graphics::layers
 
     ImGuiIO& io = ImGui::GetIO();
 
-    unregister_buffer("gui_ib");
-    unregister_buffer("gui_vb");
-    unregister_shader("gui");
+    unregister_buffer(s_gui_ib);
+    unregister_buffer(s_gui_vb);
+    unregister_shader(s_gui_shader);
     unregister_texture("gui_font");
 
     io.BackendRendererUserData = nullptr;
@@ -240,7 +244,7 @@ namespace mgl::graphics::layers
     if(!draw_data)
       return;
 
-    auto prg = get_shader("gui");
+    auto prg = get_shader(s_gui_shader);
     MGL_CORE_ASSERT(prg != nullptr, "No shader available");
 
     draw_data->ScaleClipRects(io.DisplayFramebufferScale);
@@ -252,8 +256,8 @@ namespace mgl::graphics::layers
 
     mgl::platform::api::render_api::enable_scissor();
 
-    auto vb = std::static_pointer_cast<mgl::platform::api::vertex_buffer>(get_buffer("gui_vb"));
-    auto ib = std::static_pointer_cast<mgl::platform::api::index_buffer>(get_buffer("gui_ib"));
+    auto vb = std::static_pointer_cast<mgl::platform::api::vertex_buffer>(get_buffer(s_gui_vb));
+    auto ib = std::static_pointer_cast<mgl::platform::api::index_buffer>(get_buffer(s_gui_ib));
 
     mgl::platform::api::render_api::enable_program(prg->api());
     mgl::platform::api::render_api::set_projection_matrix(
@@ -288,7 +292,7 @@ namespace mgl::graphics::layers
               static_cast<int32_t>(pcmd->ClipRect.z - pcmd->ClipRect.x),
               static_cast<int32_t>(pcmd->ClipRect.w - pcmd->ClipRect.y));
 
-          auto tex = get_texture(reinterpret_cast<size_t>(pcmd->TextureId));
+          auto tex = get_texture(handle(reinterpret_cast<uintptr_t>(pcmd->TextureId)));
           mgl::platform::api::render_api::bind_texture(0, tex->api());
 
           vao->render(
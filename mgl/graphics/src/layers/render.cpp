@@ -4,9 +4,15 @@
 
 namespace mgl::graphics::layers
 {
-  render_layer::render_layer(const std::string& name)
+  render_layer::render_layer(const std::string& name, bool retained)
       : layer(name)
-  { }
+      , m_script(nullptr)
+      , m_retained(retained)
+  {
+    m_script = mgl::create_ref<render_script>([this](render_script& script) {
+      render_prepare(script);
+    });
+  }
 
   void render_layer::on_attach() { }
 
@@ -15,10 +21,21 @@ namespace mgl::graphics::layers
   void render_layer::on_update(float time, float frame_time)
   {
     MGL_PROFILE_FUNCTION("RENDER_LAYER");
-    render_script script;
-    render_prepare(script);
-    script.execute();
+    if(!m_retained)
+    {
+      m_script->mark_dirty();
+    }
+    m_script->execute();
   }
 
-  void render_layer::on_event(mgl::platform::event& event) { }
+  void render_layer::on_event(mgl::platform::event& event)
+  {
+    // Text and projections are recorded with the window size, record them again on resize
+    mgl::platform::EventDispatcher dispatcher(event);
+    dispatcher.dispatch<mgl::platform::window_resize_event>(
+        [this](mgl::platform::window_resize_event& e) {
+          mark_dirty();
+          return false;
+        });
+  }
 } // namespace mgl::graphics::layers
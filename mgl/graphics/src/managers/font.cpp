@@ -26,14 +26,17 @@ namespace mgl::graphics
     m_font_cache.erase(name);
   }
 
-  const font_atlas_ref& font_manager::get_atlas(const std::string& name) const
+  // on_add and on_remove already run under the manager lock
+  font_atlas_ref font_manager::get_atlas(const std::string& name) const
   {
+    std::shared_lock lock(m_mutex);
     MGL_CORE_ASSERT(m_font_cache.find(name) != m_font_cache.end(), "Font does not exist");
     return m_font_cache.at(name).atlas;
   }
 
-  const texture2d_ref& font_manager::get_texture(const std::string& name) const
+  texture2d_ref font_manager::get_texture(const std::string& name) const
   {
+    std::shared_lock lock(m_mutex);
     MGL_CORE_ASSERT(m_font_cache.find(name) != m_font_cache.end(), "Font does not exist");
     return m_font_cache.at(name).texture;
   }
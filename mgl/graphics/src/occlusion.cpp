@@ -0,0 +1,197 @@
+#include "mgl_graphics/occlusion.hpp"
+#include "mgl_graphics/graphics.hpp"
+
+#include "mgl_platform/api/render_api.hpp"
+
+#include "mgl_core/debug.hpp"
+#include "mgl_core/profiling.hpp"
+
+namespace mgl::graphics
+{
+  using render_api = mgl::platform::api::render_api;
+
+  // Unit cube, scaled to each box in the vertex shader
+  static const mgl::float32_buffer s_cube_vertices = {
+    0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f,
+    0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f,
+  };
+
+  static const mgl::uint32_buffer s_cube_indices = {
+    0, 2, 1, 1, 2, 3, 4, 5, 6, 5, 7, 6, 0, 1, 4, 1, 5, 4,
+    2, 6, 3, 3, 6, 7, 0, 4, 2, 2, 4, 6, 1, 3, 5, 3, 7, 5,
+  };
+
+  occlusion_culler::occlusion_culler(uint32_t hysteresis, float padding)
+      : m_hysteresis(hysteresis)
+      , m_padding(padding)
+      , m_frame(0)
+      , m_proxy_vertices(nullptr)
+      , m_proxy_indices(nullptr)
+      , m_proxy(nullptr)
+  { }
+
+  uint32_t occlusion_culler::add(const glm::vec3& min, const glm::vec3& max)
+  {
+    mgl::platform::api::occlusion_query_ref query = nullptr;
+    if(!m_free_queries.empty())
+    {
+      query = m_free_queries.back();
+      m_free_queries.pop_back();
+    }
+    else
+    {
+      query = render_api::create_occlusion_query();
+    }
+
+    object o = { min, max, query, m_frame, false, false };
+
+    if(!m_free_ids.empty())
+    {
+      uint32_t id = m_free_ids.back();
+      m_free_ids.pop_back();
+      m_objects[id] = o;
+      return id;
+    }
+
+    m_objects.push_back(o);
+    return m_objects.size() - 1;
+  }
+
+  void occlusion_culler::update(uint32_t id, const glm::vec3& min, const glm::vec3& max)
+  {
+    MGL_CORE_ASSERT(id < m_objects.size() && m_objects[id].query, "Invalid occlusion object");
+    m_objects[id].min = min;
+    m_objects[id].max = max;
+  }
+
+  void occlusion_culler::remove(uint32_t id)
+  {
+    MGL_CORE_ASSERT(id < m_objects.size() && m_objects[id].query, "Invalid occlusion object");
+    m_free_queries.push_back(m_objects[id].query);
+    m_objects[id].query = nullptr;
+    m_free_ids.push_back(id);
+  }
+
+  void occlusion_culler::begin_draw(uint32_t id)
+  {
+    MGL_CORE_ASSERT(id < m_objects.size() && m_objects[id].query, "Invalid occlusion object");
+    auto& o = m_objects[id];
+
+    // Objects without a proxy result yet, or seen recently, are drawn as usual
+    o.conditional = o.issued && !visible(id);
+    if(o.conditional)
+      o.query->begin_render();
+  }
+
+  void occlusion_culler::end_draw(uint32_t id)
+  {
+    MGL_CORE_ASSERT(id < m_objects.size() && m_objects[id].query, "Invalid occlusion object");
+    auto& o = m_objects[id];
+
+    if(o.conditional)
+      o.query->end_render();
+
+    o.conditional = false;
+  }
+
+  void occlusion_culler::render_proxies(const glm::vec3& eye)
+  {
+    MGL_PROFILE_FUNCTION("OCCLUSION_PROXIES");
+
+    if(size() == 0)
+    {
+      m_frame++;
+      return;
+    }
+
+    auto shader = get_shader(occlusion_shader());
+    MGL_CORE_ASSERT(shader != nullptr, "Occlusion shader is null");
+    render_api::enable_program(shader->api());
+
+    if(m_proxy == nullptr)
+    {
+      m_proxy_vertices =
+          render_api::create_vertex_buffer(s_cube_vertices, "3f", { "i_position" });
+      m_proxy_indices = render_api::create_index_buffer(s_cube_indices);
+      m_proxy = render_api::create_vertex_array(m_proxy_vertices, m_proxy_indices);
+    }
+
+    // The masks of the pass are put back afterwards, it may not be writing depth or every channel
+    auto masks = render_api::get_write_masks();
+    render_api::set_color_mask(false);
+    render_api::set_depth_mask(false);
+
+    for(auto& o : m_objects)
+    {
+      if(o.query == nullptr)
+        continue;
+
+      // Only results the GPU already produced are looked at, the draws never wait on them
+      if(o.issued && o.query->ready() && o.query->visible())
+        o.last_visible = m_frame;
+
+      auto min = o.min - m_padding;
+      auto max = o.max + m_padding;
+
+      // The box faces are clipped when the camera is inside, the query would report it hidden
+      if(glm::all(glm::greaterThanEqual(eye, min)) && glm::all(glm::lessThanEqual(eye, max)))
+      {
+        o.last_visible = m_frame;
+        o.issued = false;
+        continue;
+      }
+
+      render_api::set_program_uniform("box_min", min);
+      render_api::set_program_uniform("box_max", max);
+
+      o.query->begin();
+      m_proxy->render(mgl::platform::api::render_mode::TRIANGLES, 0, s_cube_indices.size());
+      o.query->end();
+      o.issued = true;
+    }
+
+    render_api::set_write_masks(masks);
+    render_api::disable_program();
+
+    m_frame++;
+  }
+
+  bool occlusion_culler::visible(uint32_t id) const
+  {
+    MGL_CORE_ASSERT(id < m_objects.size() && m_objects[id].query, "Invalid occlusion object");
+    return m_frame - m_objects[id].last_visible <= m_hysteresis;
+  }
+
+  bool occlusion_culler::conditional(uint32_t id) const
+  {
+    MGL_CORE_ASSERT(id < m_objects.size() && m_objects[id].query, "Invalid occlusion object");
+    return m_objects[id].conditional;
+  }
+
+  void occlusion_culler::release()
+  {
+    for(auto& o : m_objects)
+    {
+      if(o.query != nullptr)
+        o.query->release();
+    }
+
+    for(auto& query : m_free_queries)
+      query->release();
+
+    m_objects.clear();
+    m_free_ids.clear();
+    m_free_queries.clear();
+
+    if(m_proxy != nullptr)
+    {
+      m_proxy->release();
+      m_proxy_vertices->free();
+      m_proxy_indices->free();
+      m_proxy = nullptr;
+      m_proxy_vertices = nullptr;
+      m_proxy_indices = nullptr;
+    }
+  }
+
+} // namespace mgl::graphics
@@ -0,0 +1,51 @@
+#include "mgl_graphics/render_queue.hpp"
+
+#include "mgl_core/debug.hpp"
+#include "mgl_core/profiling.hpp"
+
+namespace mgl::graphics
+{
+  render_queue::render_queue(size_t threads)
+      : m_pool(threads)
+      , m_scripts()
+  { }
+
+  render_queue::~render_queue()
+  {
+    m_pool.wait();
+  }
+
+  render_script_ref render_queue::record(const render_script::recorder& record,
+                                         const mgl::platform::api::framebuffer_ref& target)
+  {
+    MGL_CORE_ASSERT(record != nullptr, "Recorder is null");
+    auto script = target != nullptr ? mgl::create_ref<render_script>(target)
+                                    : mgl::create_ref<render_script>();
+    m_scripts.push_back(script);
+    m_pool.enqueue([script, record]() { record(*script); });
+    return script;
+  }
+
+  void render_queue::wait()
+  {
+    m_pool.wait();
+  }
+
+  void render_queue::execute()
+  {
+    MGL_PROFILE_FUNCTION("RENDER_QUEUE");
+    m_pool.wait();
+    for(auto& script : m_scripts)
+    {
+      script->execute();
+    }
+    m_scripts.clear();
+  }
+
+  void render_queue::clear()
+  {
+    m_pool.wait();
+    m_scripts.clear();
+  }
+
+} // namespace mgl::graphics
@@ -0,0 +1,134 @@
+#include "mgl_graphics/ring_buffer.hpp"
+
+#include "mgl_platform/api/render_api.hpp"
+
+#include "mgl_core/debug.hpp"
+
+namespace mgl::graphics
+{
+  ring_buffer::ring_buffer(const std::string& layout,
+                           const mgl::string_list& attrs,
+                           size_t frame_size,
+                           uint32_t frames)
+      : m_layout(layout)
+      , m_attrs(attrs)
+      , m_frame_size(frame_size)
+      , m_used(0)
+      , m_frames(frames)
+      , m_index(0)
+      , m_frame(0)
+      , m_buffer(nullptr)
+      , m_fences(frames, nullptr)
+      , m_retired()
+  {
+    MGL_CORE_ASSERT(frame_size > 0, "Ring buffer frame size must be greater than zero");
+    MGL_CORE_ASSERT(frames > 0, "Ring buffer must have at least one frame");
+  }
+
+  void ring_buffer::allocate()
+  {
+    MGL_CORE_ASSERT(m_buffer == nullptr, "Ring buffer is already allocated");
+    m_buffer = mgl::platform::api::render_api::create_vertex_buffer(
+        m_frame_size * m_frames, m_layout, m_attrs, true);
+    m_buffer->allocate();
+  }
+
+  void ring_buffer::free()
+  {
+    MGL_CORE_ASSERT(m_buffer != nullptr, "Ring buffer is not allocated");
+
+    for(auto& fence : m_fences)
+    {
+      if(fence != nullptr)
+      {
+        fence->release();
+        fence = nullptr;
+      }
+    }
+
+    for(auto& retired : m_retired)
+    {
+      retired.buffer->free();
+    }
+    m_retired.clear();
+
+    m_buffer->free();
+    m_buffer = nullptr;
+  }
+
+  void ring_buffer::begin_frame()
+  {
+    MGL_CORE_ASSERT(m_buffer != nullptr, "Ring buffer is not allocated");
+    m_frame++;
+    m_index = m_frame % m_frames;
+    m_used = 0;
+
+    // The region is still being read by the GPU until the fence of the frame that used it signals
+    auto& fence = m_fences[m_index];
+    if(fence != nullptr)
+    {
+      fence->wait();
+      fence->release();
+      fence = nullptr;
+    }
+
+    std::erase_if(m_retired, [this](retired_buffer& retired) {
+      if(m_frame - retired.frame < m_frames)
+      {
+        return false;
+      }
+      retired.buffer->free();
+      return true;
+    });
+  }
+
+  void ring_buffer::end_frame()
+  {
+    MGL_CORE_ASSERT(m_buffer != nullptr, "Ring buffer is not allocated");
+    MGL_CORE_ASSERT(m_fences[m_index] == nullptr, "Ring buffer frame already ended");
+    m_fences[m_index] = mgl::platform::api::render_api::create_fence();
+  }
+
+  size_t ring_buffer::write(const void* data, size_t size)
+  {
+    MGL_CORE_ASSERT(m_buffer != nullptr, "Ring buffer is not allocated");
+
+    if(m_used + size > m_frame_size)
+    {
+      grow(m_used + size);
+    }
+
+    size_t offset = m_index * m_frame_size + m_used;
+    if(size > 0)
+    {
+      m_buffer->seek(offset);
+      m_buffer->write(data, size);
+      m_used += size;
+    }
+
+    return offset;
+  }
+
+  void ring_buffer::grow(size_t size)
+  {
+    // Keep the frame size a multiple of the original one so vertex offsets stay aligned
+    size_t frame_size = m_frame_size;
+    while(frame_size < size)
+    {
+      frame_size *= 2;
+    }
+
+    MGL_CORE_WARN("Ring buffer overflow, growing frame size from {} to {} bytes.",
+                  m_frame_size,
+                  frame_size);
+
+    // Draws already recorded this frame still reference the old buffer
+    m_retired.push_back({ m_buffer, m_frame });
+
+    m_frame_size = frame_size;
+    m_used = 0;
+    m_buffer = nullptr;
+    allocate();
+  }
+
+} // namespace mgl::graphics
@@ -0,0 +1,23 @@
+#include "shaders/fragment/occlusion.hpp"
+#include "shaders/vertex/occlusion.hpp"
+
+#include "mgl_graphics/shaders/occlusion.hpp"
+
+#include "mgl_platform/api/render_api.hpp"
+
+namespace mgl::graphics::builtins
+{
+  void occlusion_shader::load()
+  {
+    MGL_CORE_ASSERT(mgl::shaders::occlusion::vertex_shader_source().size() > 0,
+                    "Vertex shader source is empty");
+    MGL_CORE_ASSERT(mgl::shaders::occlusion::fragment_shader_source().size() > 0,
+                    "Fragment shader source is empty");
+    m_program = mgl::platform::api::render_api::create_program(
+        mgl::shaders::occlusion::vertex_shader_source(),
+        mgl::shaders::occlusion::fragment_shader_source());
+  }
+
+  void occlusion_shader::prepare() { }
+
+} // namespace mgl::graphics::builtins
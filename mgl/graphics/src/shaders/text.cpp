@@ -16,7 +16,6 @@ namespace mgl::graphics::builtins
     m_program = mgl::platform::api::render_api::create_program(
         mgl::shaders::text::vertex_shader_source(), mgl::shaders::text::fragment_shader_source());
     set_uniform_value("atlas", 0);
-    set_uniform_value("color", glm::vec4(1.0, 1.0, 1.0, 1.0));
     set_uniform_value("px_range", 64.f);
   }
 
@@ -0,0 +1,57 @@
+#include "mgl_graphics/manager.hpp"
+#include <gtest/gtest.h>
+
+class test_manager : public mgl::graphics::manager<mgl::ref<int32_t>>
+{
+public:
+  int32_t added = 0;
+  int32_t removed = 0;
+
+  virtual void on_add(const mgl::ref<int32_t>& item, const std::string& name) override final
+  {
+    added++;
+  }
+
+  virtual void on_remove(const mgl::ref<int32_t>& item, const std::string& name) override final
+  {
+    removed++;
+  }
+};
+
+TEST(ManagerTest, MissingItemsAreNull)
+{
+  test_manager manager;
+
+  // Nothing was added yet, there is no slot to read from
+  ASSERT_EQ(manager.get_item("missing"), nullptr);
+  ASSERT_EQ(manager.get_item(mgl::graphics::handle()), nullptr);
+
+  auto h = manager.add_item("a", mgl::create_ref<int32_t>(1));
+  ASSERT_TRUE(h.valid());
+  ASSERT_EQ(*manager.get_item("a"), 1);
+  ASSERT_EQ(*manager.get_item(h), 1);
+  ASSERT_EQ(manager.get_item("missing"), nullptr);
+  ASSERT_EQ(manager.added, 1);
+
+  // The slot is reused by the next item, the old handle must not resolve to it
+  manager.remove_item(h);
+  ASSERT_EQ(manager.removed, 1);
+  auto b = manager.add_item("b", mgl::create_ref<int32_t>(2));
+  ASSERT_EQ(b.index, h.index);
+  ASSERT_FALSE(manager.has_item(h));
+  ASSERT_EQ(manager.get_item(h), nullptr);
+  ASSERT_EQ(manager.get_item("a"), nullptr);
+  ASSERT_EQ(*manager.get_item(b), 2);
+
+  // An index past the end is stale as well
+  ASSERT_EQ(manager.get_item(mgl::graphics::handle(b.index + 10, b.generation)), nullptr);
+
+  manager.clear();
+  ASSERT_EQ(manager.get_item(b), nullptr);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
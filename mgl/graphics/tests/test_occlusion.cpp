@@ -0,0 +1,83 @@
+#include "mgl_graphics/graphics.hpp"
+#include "mgl_graphics/occlusion.hpp"
+#include "mgl_opengl/context.hpp"
+#include "mgl_platform/api/opengl/api.hpp"
+#include "mgl_platform/api/render_api.hpp"
+#include <gtest/gtest.h>
+
+using render_api = mgl::platform::api::render_api;
+
+TEST(OcclusionTest, HiddenObjectsAreConditional)
+{
+  auto standalone = mgl::opengl::create_context(mgl::opengl::context_mode::STANDALONE);
+  ASSERT_NE(standalone, nullptr);
+  ASSERT_TRUE(render_api::init_api());
+  mgl::graphics::init();
+
+  auto& ctx = mgl::platform::api::backends::ogl_api::current_context();
+  auto fbo = ctx->framebuffer({ ctx->renderbuffer(16, 16) }, ctx->depth_renderbuffer(16, 16));
+  fbo->use();
+  ctx->enable(mgl::opengl::enable_flag::DEPTH_TEST);
+
+  // Identity matrices, the box sits in the middle of the depth range
+  render_api::set_view_matrix(glm::mat4(1.0f));
+  render_api::set_projection_matrix(glm::mat4(1.0f));
+
+  const uint32_t hysteresis = 2;
+  const glm::vec3 eye(0.0f, 0.0f, -10.0f);
+  mgl::graphics::occlusion_culler culler(hysteresis, 0.0f);
+  auto id = culler.add(glm::vec3(-0.5f, -0.5f, 0.0f), glm::vec3(0.5f, 0.5f, 0.5f));
+
+  // A far depth buffer lets the box through, a near one hides it
+  auto frame = [&](float depth) {
+    fbo->clear(0, 0, 0, 0, depth, fbo->viewport());
+    culler.begin_draw(id);
+    bool conditional = culler.conditional(id);
+    culler.end_draw(id);
+    culler.render_proxies(eye);
+    ctx->finish();
+    return conditional;
+  };
+
+  ASSERT_FALSE(frame(1.0f));
+  ASSERT_FALSE(frame(1.0f));
+  ASSERT_TRUE(culler.visible(id));
+
+  // The object stays drawn for the hysteresis frames after it was last seen
+  for(uint32_t i = 0; i < hysteresis; i++)
+  {
+    ASSERT_FALSE(frame(0.0f));
+    ASSERT_TRUE(culler.visible(id));
+  }
+
+  frame(0.0f);
+  ASSERT_FALSE(culler.visible(id));
+  ASSERT_TRUE(frame(0.0f));
+
+  // One visible proxy brings it back
+  frame(1.0f);
+  frame(1.0f);
+  ASSERT_TRUE(culler.visible(id));
+  ASSERT_FALSE(frame(1.0f));
+
+  // The masks of the pass are restored after the proxies
+  fbo->set_color_mask(mgl::opengl::color_mask(true, false, true, false));
+  fbo->set_depth_mask(false);
+  culler.render_proxies(eye);
+  ASSERT_EQ(fbo->color_mask()[0], mgl::opengl::color_mask(true, false, true, false));
+  ASSERT_FALSE(fbo->depth_mask());
+
+  culler.release();
+  ASSERT_EQ(culler.size(), 0);
+
+  ctx->disable(mgl::opengl::enable_flag::DEPTH_TEST);
+  mgl::graphics::shutdown();
+  render_api::shutdown_api();
+  standalone->release();
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
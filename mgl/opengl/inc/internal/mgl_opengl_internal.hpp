@@ -4,8 +4,29 @@
 
 #include "mgl_core/debug.hpp"
 
+#include <algorithm>
+
+#if defined(MGL_DEBUG) && !defined(MGL_OPENGL_VALIDATION)
+#  define MGL_OPENGL_VALIDATION
+#endif
+
+// Reports the GL errors raised since the previous check, attributed to this call site
+#ifdef MGL_OPENGL_VALIDATION
+#  define MGL_GL_CHECK(site) mgl::opengl::internal::check_errors(site, __FILE__, __LINE__)
+#else
+#  define MGL_GL_CHECK(site)
+#endif
+
 namespace mgl::opengl::internal
 {
+  void check_errors(const char* site, const char* file, int32_t line);
+
+  // Drops the errors raised so far, for calls that are expected to fail on some drivers
+  void discard_errors();
+
+  // Routes the errors through the KHR_debug callback instead of polling glGetError
+  void enable_debug_output();
+
   inline void clean_glsl_name(char* name, int& name_len)
   {
     if(name_len && name[name_len - 1] == ']')
@@ -93,4 +114,91 @@ namespace mgl::opengl::internal
     return '?';
   }
 
-} // namespace mgl::opengl::internal
\ No newline at end of file
+  // Levels of a full mip chain down to 1x1(x1)
+  inline int32_t mip_levels(int32_t width, int32_t height, int32_t depth = 1)
+  {
+    int32_t size = std::max({ width, height, depth });
+    int32_t levels = 1;
+
+    while(size >>= 1)
+      levels++;
+
+    return levels;
+  }
+
+  // Requested levels clamped to the chain, 0 asks for the full chain
+  inline int32_t texture_levels(int32_t levels, int32_t width, int32_t height, int32_t depth = 1)
+  {
+    MGL_CORE_ASSERT(levels >= 0, "Levels must be positive or 0 for a full mip chain.");
+    int32_t full = mip_levels(width, height, depth);
+    return levels == 0 ? full : std::min(levels, full);
+  }
+
+  /**
+   * Allocates every level of a GL_TEXTURE_2D or GL_TEXTURE_CUBE_MAP bound to its target. The
+   * storage is immutable when supported, otherwise each level (and face) is defined with
+   * glTexImage2D so generating mipmaps later does not reallocate them.
+   */
+  inline void texture_storage_2d(int32_t target,
+                                 bool immutable,
+                                 int32_t levels,
+                                 int32_t internal_format,
+                                 int32_t width,
+                                 int32_t height,
+                                 int32_t base_format,
+                                 int32_t pixel_type)
+  {
+    if(immutable)
+    {
+      glTexStorage2D(target, levels, internal_format, width, height);
+      return;
+    }
+
+    int32_t faces = target == GL_TEXTURE_CUBE_MAP ? 6 : 1;
+    int32_t face_target = target == GL_TEXTURE_CUBE_MAP ? GL_TEXTURE_CUBE_MAP_POSITIVE_X : target;
+
+    for(int32_t lvl = 0; lvl < levels; lvl++)
+    {
+      int32_t w = std::max(width >> lvl, 1);
+      int32_t h = std::max(height >> lvl, 1);
+
+      for(int32_t face = 0; face < faces; face++)
+      {
+        glTexImage2D(
+            face_target + face, lvl, internal_format, w, h, 0, base_format, pixel_type, nullptr);
+      }
+    }
+
+    glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, levels - 1);
+  }
+
+  // Same as texture_storage_2d for GL_TEXTURE_3D and GL_TEXTURE_2D_ARRAY, layers are not halved
+  inline void texture_storage_3d(int32_t target,
+                                 bool immutable,
+                                 int32_t levels,
+                                 int32_t internal_format,
+                                 int32_t width,
+                                 int32_t height,
+                                 int32_t depth,
+                                 int32_t base_format,
+                                 int32_t pixel_type)
+  {
+    if(immutable)
+    {
+      glTexStorage3D(target, levels, internal_format, width, height, depth);
+      return;
+    }
+
+    for(int32_t lvl = 0; lvl < levels; lvl++)
+    {
+      int32_t w = std::max(width >> lvl, 1);
+      int32_t h = std::max(height >> lvl, 1);
+      int32_t d = target == GL_TEXTURE_3D ? std::max(depth >> lvl, 1) : depth;
+
+      glTexImage3D(target, lvl, internal_format, w, h, d, 0, base_format, pixel_type, nullptr);
+    }
+
+    glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, levels - 1);
+  }
+
+} // namespace mgl::opengl::internal
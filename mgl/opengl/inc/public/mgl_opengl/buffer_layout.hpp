@@ -2,191 +2,351 @@
 
 #include "mgl_core/string.hpp"
 
+#include <span>
+#include <string_view>
+
 namespace mgl::opengl
 {
+  namespace internal
+  {
+    // Values of the GL attribute types, the public headers do not include the GL loader
+    inline constexpr int32_t gl_byte = 0x1400;
+    inline constexpr int32_t gl_unsigned_byte = 0x1401;
+    inline constexpr int32_t gl_short = 0x1402;
+    inline constexpr int32_t gl_unsigned_short = 0x1403;
+    inline constexpr int32_t gl_int = 0x1404;
+    inline constexpr int32_t gl_unsigned_int = 0x1405;
+    inline constexpr int32_t gl_float = 0x1406;
+    inline constexpr int32_t gl_double = 0x140A;
+    inline constexpr int32_t gl_half_float = 0x140B;
+
+    // Not constexpr, calling it while compiling a layout makes an invalid layout a compile error
+    void invalid_buffer_layout();
+  } // namespace internal
+
   /*
   @brief
-  A buffer layout is a short string describing the layout of data in a vertex buffer object (VBO).
-  A VBO often contains a homogeneous array of C-like structures. 
-  The buffer info describes what each element of the array looks like. 
-  For example, a buffer containing an array of high-precision 2D vertex positions might have the info "2f8" - each element of the array consists of two floats, each float being 8 bytes wide, ie. a double.
+  An element is a single node in the buffer layout.
   */
-  class buffer_layout
+  struct layout_element
   {
-public:
-    /*
-    @brief
-    An element is a single node in the buffer layout.
-    */
-    struct element
+    int size = 0;
+    int count = 0;
+    int offset = 0;
+    int type = 0;
+    bool normalize = false;
+
+    constexpr layout_element() = default;
+
+    constexpr layout_element(int size, int count, int offset, int type, bool normalize)
+        : size(size)
+        , count(count)
+        , offset(offset)
+        , type(type)
+        , normalize(normalize)
+    { }
+
+    constexpr bool is_invalid() const
     {
-      int size;
-      int count;
-      int offset;
-      int type;
-      bool normalize;
-
-      element()
-          : size(0)
-          , count(0)
-          , offset(0)
-          , type(0)
-          , normalize(false)
-      { }
-
-      element(int size, int count, int offset, int type, bool normalize)
-          : size(size)
-          , count(count)
-          , offset(offset)
-          , type(type)
-          , normalize(normalize)
-      { }
-
-      element(const element& other)
-          : size(other.size)
-          , count(other.count)
-          , offset(other.offset)
-          , type(other.type)
-          , normalize(other.normalize)
-      { }
-
-      const bool is_invalid() const
-      {
-        return size == 0 && count == 0 && offset == 0 && type == 0 && normalize == false;
-      }
+      return size == 0 && count == 0 && offset == 0 && type == 0 && normalize == false;
+    }
 
-      element& operator=(const element& other)
-      {
-        size = other.size;
-        count = other.count;
-        offset = other.offset;
-        type = other.type;
-        normalize = other.normalize;
-        return *this;
-      }
+    constexpr bool operator==(const layout_element& other) const = default;
+  };
+
+  /*
+  @brief
+  The parsed form of a layout string, a fixed size value that can be built at compile time.
+  Descriptors compare and hash by their elements, stride and divisor, the source is informative.
+  */
+  struct layout_descriptor
+  {
+    // The minimum number of vertex attributes every GL implementation supports
+    static constexpr int32_t max_elements = 16;
+
+    layout_element elements[max_elements] = {};
+    int32_t size = 0;
+    int32_t stride = 0;
+    int32_t divisor = 0;
+    size_t hash = 0;
+    std::string_view source = {};
+
+    constexpr bool is_invalid() const { return size == 0; }
+
+    constexpr bool operator==(const layout_descriptor& other) const
+    {
+      if(hash != other.hash || size != other.size || stride != other.stride ||
+         divisor != other.divisor)
+        return false;
 
-      bool operator==(const element& other)
+      for(int32_t i = 0; i < size; i++)
       {
-        return size == other.size && count == other.count && offset == other.offset &&
-               type == other.type && normalize == other.normalize;
+        if(elements[i] != other.elements[i])
+          return false;
       }
 
-      bool operator!=(const element& other) { return !(*this == other); }
-    };
+      return true;
+    }
+  };
 
-public:
-    buffer_layout(const std::string& layout)
-        : m_layout()
-        , m_elements()
-        , m_stride(0)
-        , m_divisor(0)
+  namespace internal
+  {
+    constexpr bool is_space(char chr)
     {
-      parse_layout(layout);
+      return chr == ' ' || chr == '\t' || chr == '\n' || chr == '\r' || chr == '\f' || chr == '\v';
     }
 
-    buffer_layout(const buffer_layout& other)
-        : m_layout(other.m_layout)
-        , m_elements(other.m_elements)
-        , m_stride(other.m_stride)
-        , m_divisor(other.m_divisor)
-    { }
+    constexpr bool is_digit(char chr)
+    {
+      return chr >= '0' && chr <= '9';
+    }
 
-    buffer_layout(buffer_layout&& other)
-        : m_layout(std::move(other.m_layout))
-        , m_elements(std::move(other.m_elements))
-        , m_stride(other.m_stride)
-        , m_divisor(other.m_divisor)
-    { }
+    constexpr void mix_hash(size_t& seed, size_t value)
+    {
+      seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    }
 
-    const std::string& layout() const { return m_layout; }
+    // The GL type of a data type and size, 0 if the pair is not valid
+    constexpr int32_t layout_type(char data_type, int32_t size)
+    {
+      switch(data_type)
+      {
+        case 'f':
+          switch(size)
+          {
+            case 1: return gl_unsigned_byte;
+            case 2: return gl_half_float;
+            case 4: return gl_float;
+            case 8: return gl_double;
+          }
+          return 0;
+        case 'i':
+          switch(size)
+          {
+            case 1: return gl_byte;
+            case 2: return gl_short;
+            case 4: return gl_int;
+            case 8: return gl_double;
+          }
+          return 0;
+        case 'u':
+          switch(size)
+          {
+            case 1: return gl_unsigned_byte;
+            case 2: return gl_unsigned_short;
+            case 4: return gl_unsigned_int;
+          }
+          return 0;
+      }
+      return 0;
+    }
+  } // namespace internal
+
+  /**
+   * @brief Parses a layout string, the result is invalid (empty) if the string is malformed.
+   *
+   * The layout looks like: [count]type[size] [[count]type[size]...] [/usage]
+   * @param layout The layout string, the descriptor's source refers to it.
+   */
+  constexpr layout_descriptor parse_layout(std::string_view layout)
+  {
+    layout_descriptor result;
+    const layout_descriptor invalid;
+    size_t pos = 0;
+    int32_t offset = 0;
 
-    const mgl::list<element>& elements() const { return m_elements; }
+    while(true)
+    {
+      // Skip spaces and accumulate the count
+      int32_t count = 0;
+      while(pos < layout.size() && internal::is_space(layout[pos]))
+        pos++;
 
-    int stride() const { return m_stride; }
+      while(pos < layout.size() && internal::is_digit(layout[pos]))
+        count = count * 10 + (layout[pos++] - '0');
 
-    int divisor() const { return m_divisor; }
+      // The end of the string or a divisor where a data type is expected
+      if(pos == layout.size() || layout[pos] == '/')
+        return invalid;
 
-    size_t size() const { return m_elements.size(); }
+      count = count ? count : 1;
+      char data_type = layout[pos++];
+      int32_t size = -1;
 
-    bool is_invalid() const { return m_elements.empty(); }
+      if(pos < layout.size())
+      {
+        char chr = layout[pos];
+        if(internal::is_digit(chr))
+        {
+          size = chr - '0';
+          pos++;
+          // A size is followed by the end of the string, a space or a divisor
+          if(pos < layout.size() && layout[pos] != ' ' && layout[pos] != '/')
+            return invalid;
+        }
+        else if(chr == ' ')
+        {
+          pos++;
+        }
+        else if(chr != '/')
+        {
+          return invalid;
+        }
+      }
 
-    bool operator==(const buffer_layout& other) { return m_layout == other.m_layout; }
-    bool operator!=(const buffer_layout& other) { return !(*this == other); }
+      if(data_type == 'x')
+      {
+        // Padding only moves the offset of the next element
+        size = size == -1 ? 1 : size;
+        offset += size * count;
+        result.stride += size * count;
+      }
+      else
+      {
+        // If the size is 1, it's a normalized format
+        bool normalize = size == 1;
+        size = size == -1 ? 4 : size;
+        int32_t type = internal::layout_type(data_type, size);
 
-    buffer_layout& operator=(const buffer_layout& other)
-    {
-      m_layout = other.m_layout;
-      m_elements = other.m_elements;
-      m_stride = other.m_stride;
-      m_divisor = other.m_divisor;
-      return *this;
+        if(type == 0 || result.size == layout_descriptor::max_elements)
+          return invalid;
+
+        result.elements[result.size++] = { size * count, count, offset, type, normalize };
+        offset += size * count;
+        result.stride += size * count;
+      }
+
+      if(pos == layout.size() || layout[pos] == '/')
+        break;
     }
 
-    buffer_layout& operator=(buffer_layout&& other)
+    // The divisor is used to describe the usage of the data in the VBO
+    if(pos < layout.size())
     {
-      m_layout = std::move(other.m_layout);
-      m_elements = std::move(other.m_elements);
-      m_stride = other.m_stride;
-      m_divisor = other.m_divisor;
-      return *this;
+      auto usage = layout.substr(pos + 1);
+      if(usage == "i")
+      {
+        // /i per instance. Successive values from the buffer are passed to each instance.
+        result.divisor = 1;
+      }
+      else if(usage == "r")
+      {
+        // /r per render. The first value is passed to every vertex of every instance.
+        result.divisor = 0x7fffffff;
+      }
+      else if(usage != "v")
+      {
+        // /v per vertex is the default, anything else is invalid
+        return invalid;
+      }
     }
 
-    buffer_layout& operator=(const std::string& layout)
+    for(int32_t i = 0; i < result.size; i++)
     {
-      parse_layout(layout);
-      return *this;
+      internal::mix_hash(result.hash, result.elements[i].size);
+      internal::mix_hash(result.hash, result.elements[i].count);
+      internal::mix_hash(result.hash, result.elements[i].offset);
+      internal::mix_hash(result.hash, result.elements[i].type);
+      internal::mix_hash(result.hash, result.elements[i].normalize);
     }
+    internal::mix_hash(result.hash, result.stride);
+    internal::mix_hash(result.hash, result.divisor);
+
+    result.source = layout;
+    return result;
+  }
+
+  /**
+   * @brief Parses a layout string literal while compiling, a malformed layout does not compile.
+   *
+   * e.g. constexpr auto quad = mgl::opengl::compile_layout("2f 2f");
+   */
+  consteval layout_descriptor compile_layout(std::string_view layout)
+  {
+    auto result = parse_layout(layout);
+    if(result.is_invalid())
+      internal::invalid_buffer_layout();
+
+    return result;
+  }
+
+  struct layout_descriptor_hash
+  {
+    size_t operator()(const layout_descriptor& descriptor) const { return descriptor.hash; }
+  };
+
+  /*
+  @brief
+  A buffer layout is a short string describing the layout of data in a vertex buffer object (VBO).
+  A VBO often contains a homogeneous array of C-like structures.
+  The buffer info describes what each element of the array looks like.
+  For example, a buffer containing an array of high-precision 2D vertex positions might have the info "2f8" - each element of the array consists of two floats, each float being 8 bytes wide, ie. a double.
+
+  Layouts are interned, every layout built from the same string shares one parsed descriptor and
+  two layouts are equal if they refer to the same one.
+  */
+  class buffer_layout
+  {
+public:
+    using element = layout_element;
 
-    const element& operator[](size_t index) const { return m_elements[index]; }
+    buffer_layout(const std::string& layout);
 
-    bool operator==(const std::string& layout) { return m_layout == layout; }
+    // Interns a descriptor built with compile_layout, the string is not parsed again
+    buffer_layout(const layout_descriptor& descriptor);
 
-    bool operator!=(const std::string& layout) { return !(*this == layout); }
+    buffer_layout(const buffer_layout& other) = default;
 
-    bool operator==(const buffer_layout& other) const { return m_layout == other.m_layout; }
+    const std::string& layout() const { return m_entry->first; }
 
-    bool operator!=(const buffer_layout& other) const { return !(*this == other); }
+    const layout_descriptor& descriptor() const { return m_entry->second; }
 
-private:
-    /*
-    @brief
-    An iterator for the buffer layout. Helps parse the layout string.
-    */
-    struct iterator
+    std::span<const element> elements() const
     {
-      iterator(const char* str, int offset = 0);
+      return { descriptor().elements, static_cast<size_t>(descriptor().size) };
+    }
 
-      iterator& operator++();
+    int stride() const { return descriptor().stride; }
 
-      const element& value() const { return m_element; }
+    int divisor() const { return descriptor().divisor; }
 
-      iterator& operator=(const iterator& other)
-      {
-        m_ptr = other.m_ptr;
-        m_element = other.m_element;
-        m_offset = other.m_offset;
-        return *this;
-      }
+    size_t size() const { return descriptor().size; }
 
-      bool operator==(const iterator& other) { return m_ptr == other.m_ptr; }
+    size_t hash() const { return descriptor().hash; }
 
-      bool operator!=(const iterator& other) { return !(*this == other); }
+    bool is_invalid() const { return descriptor().is_invalid(); }
 
-  private:
-      const char* m_ptr;
-      element m_element;
-      int m_offset;
-    };
+    buffer_layout& operator=(const buffer_layout& other) = default;
 
-    iterator begin() { return iterator(m_layout.c_str()); }
-    iterator end() { return iterator(nullptr); }
-    void parse_layout(const std::string& layout);
+    buffer_layout& operator=(const std::string& layout)
+    {
+      *this = buffer_layout(layout);
+      return *this;
+    }
+
+    const element& operator[](size_t index) const { return descriptor().elements[index]; }
+
+    bool operator==(const std::string& layout) const { return m_entry->first == layout; }
+
+    bool operator!=(const std::string& layout) const { return !(*this == layout); }
+
+    bool operator==(const buffer_layout& other) const { return m_entry == other.m_entry; }
+
+    bool operator!=(const buffer_layout& other) const { return !(*this == other); }
+
+    // Number of distinct layout strings parsed so far
+    static size_t interned();
 
 private:
-    std::string m_layout;
-    mgl::list<element> m_elements;
-    int m_stride;
-    int m_divisor;
+    using entry = std::pair<const std::string, layout_descriptor>;
+
+    const entry* m_entry;
   };
 
-} // namespace  mgl::opengl
\ No newline at end of file
+} // namespace  mgl::opengl
+
+template <>
+struct std::hash<mgl::opengl::buffer_layout>
+{
+  size_t operator()(const mgl::opengl::buffer_layout& layout) const { return layout.hash(); }
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace mgl::opengl::call_counter
+{
+  /**
+   * @brief Starts counting the calls made to the entry points the context tracks state for.
+   *
+   * The loaded GL function pointers are swapped for counting ones, so it applies to every
+   * context and costs nothing while disabled. Creating a context reloads the pointers, enable it
+   * once the contexts exist.
+   */
+  void enable();
+
+  void disable();
+
+  bool enabled();
+
+  void reset();
+
+  /**
+   * @brief Calls made to a GL function since the last reset.
+   * @param function The GL name, e.g. "glBindTexture".
+   * @return The count, always zero for functions that are not counted.
+   */
+  uint64_t count(const std::string& function);
+
+} // namespace  mgl::opengl::call_counter
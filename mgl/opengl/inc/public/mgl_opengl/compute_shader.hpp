@@ -1,5 +1,7 @@
 #pragma once
 
+#include "buffer.hpp"
+#include "enums.hpp"
 #include "gl_object.hpp"
 #include "uniform.hpp"
 #include "uniform_block.hpp"
@@ -41,10 +43,36 @@ public:
      * @param x The number of work groups in the x direction.
      * @param y The number of work groups in the y direction.
      * @param z The number of work groups in the z direction.
-     * @param barrier Whether to insert a barrier after the compute shader.
+     * @param barrier Whether the results must be visible to every later use.
      */
     void run(int32_t x = 1, int32_t y = 1, int32_t z = 1, bool barrier = true);
 
+    /**
+     * @brief The dispatch method runs the compute shader, only the declared consumers of its
+     * writes are synchronized.
+     * 
+     * No barrier is issued here, the context issues the pending bits before the first use that
+     * depends on them, e.g. a draw reading the results as vertex attributes.
+     * 
+     * @param x The number of work groups in the x direction.
+     * @param y The number of work groups in the y direction.
+     * @param z The number of work groups in the z direction.
+     * @param consumers The barrier_bit mask of how the results will be read.
+     */
+    void dispatch(int32_t x, int32_t y, int32_t z, uint32_t consumers);
+
+    /**
+     * @brief The run_indirect method runs the compute shader with the number of work groups read
+     * from a buffer, three uint32 values at the offset.
+     * 
+     * @param buffer The buffer holding the number of work groups.
+     * @param offset The offset in bytes, a multiple of 4.
+     * @param consumers The barrier_bit mask of how the results will be read.
+     */
+    void run_indirect(const buffer_ref& buffer,
+                      size_t offset = 0,
+                      uint32_t consumers = barrier_bit::ALL_BARRIERS);
+
     /**
      * @brief The has_uniform method returns whether the compute shader has a uniform with the specified name.
      * 
@@ -7,6 +7,7 @@
 #include "conditional_render.hpp"
 #include "data_type.hpp"
 #include "enums.hpp"
+#include "fence.hpp"
 #include "framebuffer.hpp"
 #include "program.hpp"
 #include "query.hpp"
@@ -30,6 +31,9 @@
 
 #include "glm/vec4.hpp"
 
+#include <array>
+#include <unordered_map>
+
 namespace mgl::opengl
 {
 
@@ -73,6 +77,54 @@ public:
 
     const mgl::string_list& extensions() const { return m_extensions; }
 
+    // Textures created with more than one level use immutable storage (GL 4.2)
+    bool texture_storage() const { return m_texture_storage; }
+
+    // Texture parameters are edited without binding (GL 4.5)
+    bool direct_state_access() const { return m_direct_state_access; }
+
+    /**
+     * The texture bound to each unit and target is tracked, binding a texture that is already
+     * bound is a no-op. Code that binds textures behind the context's back must call
+     * reset_texture_bindings() before the next bind.
+     */
+    void bind_texture(int32_t unit, int32_t target, int32_t glo);
+
+    // Binds to the default unit and makes it active, for the calls that edit the bound texture
+    void select_texture(int32_t target, int32_t glo);
+
+    void texture_parameter(int32_t target, int32_t glo, int32_t pname, int32_t value);
+
+    void texture_parameter(int32_t target, int32_t glo, int32_t pname, float value);
+
+    // Deleted textures are unbound by GL, their names can be reused
+    void forget_texture(int32_t glo);
+
+    // Samplers are tracked the same way, per unit
+    void bind_sampler(int32_t unit, int32_t glo);
+
+    void forget_sampler(int32_t glo);
+
+    // Forgets the tracked texture and sampler bindings
+    void reset_texture_bindings();
+
+    // Whole buffers bound to indexed uniform and storage buffer points are tracked as well
+    void bind_buffer_base(int32_t target, int32_t index, int32_t glo);
+
+    // Ranges are always bound, the binding point is unknown afterwards
+    void bind_buffer_range(int32_t target, int32_t index, int32_t glo, size_t offset, size_t size);
+
+    void forget_buffer(int32_t glo);
+
+    void reset_buffer_bindings();
+
+    /**
+     * The bound framebuffers, viewport, scissor and write masks are tracked as well, framebuffer
+     * use() only emits what differs. Code that changes them behind the context's back must call
+     * reset_framebuffer_state() before the next use.
+     */
+    void reset_framebuffer_state();
+
     framebuffer& screen() { return *m_default_framebuffer; }
 
     framebuffer_ref& current_framebuffer() { return m_bound_framebuffer; }
@@ -89,6 +141,19 @@ public:
 
     void finish();
 
+    /**
+     * Shader writes are made visible lazily. A dispatch defers the barrier bits for the declared
+     * consumers and the first dependent use issues only the pending bits it needs, e.g. a buffer
+     * download only waits on BUFFER_UPDATE_BARRIER. Raw GL reads must call flush_barriers() first.
+     */
+    void defer_barrier(uint32_t bits) { m_pending_barriers |= bits; }
+
+    void require_barrier(uint32_t bits);
+
+    void flush_barriers() { require_barrier(barrier_bit::ALL_BARRIERS); }
+
+    uint32_t pending_barriers() const { return m_pending_barriers; }
+
     void clear_samplers(int32_t start = 0, int32_t end = -1);
 
     int32_t front_face() const { return m_front_face; }
@@ -207,6 +272,9 @@ public:
     // Create Shader
     static context_ref create_context(context_mode::mode mode, int32_t required = 330);
 
+    // Fence
+    fence_ref fence();
+
     // Framebuffer
     framebuffer_ref framebuffer(const attachments_ref& color_attachments,
                                 attachment_ref depth_attachment);
@@ -238,6 +306,9 @@ public:
                     bool time_elapsed = false,
                     bool primitives_generated = false);
 
+    // Shared pool for per-frame measurements, results never block
+    mgl::opengl::query_pool& query_pool() { return m_query_pool; }
+
     // Renderbuffer
     renderbuffer_ref renderbuffer(int32_t width,
                                   int32_t height,
@@ -249,6 +320,11 @@ public:
     // Sampler
     sampler_ref sampler();
 
+    // Shared immutable sampler for the state, created once per distinct state
+    sampler_ref sampler(const mgl::opengl::sampler::state& state);
+
+    const sampler_cache& cached_samplers() const { return m_sampler_cache; }
+
     // Scope
     scope_ref scope(framebuffer_ref framebuffer = nullptr,
                     int32_t enable_flags = 0,
@@ -257,7 +333,17 @@ public:
                     const buffer_bindings& storage_buffers = {},
                     const sampler_bindings& samplers = {});
 
-    // Texture
+    /**
+     * Ended scopes stay applied so the next scope only binds what differs. Code that needs the
+     * state from before the scope, e.g. raw GL calls, must call restore_scope() first.
+     */
+    void restore_scope();
+
+    /**
+     * Textures are created with a single mutable level by default, which build_mipmaps() and
+     * resize() can redefine. Passing levels (0 for the full chain) allocates every mip level up
+     * front, with immutable storage when texture_storage() is supported.
+     */
     texture_2d_ref texture2d(int32_t width,
                              int32_t height,
                              int32_t components,
@@ -265,7 +351,8 @@ public:
                              int32_t samples = 0,
                              int32_t alignment = 1,
                              const std::string& dtype = "f1",
-                             int32_t internal_format_override = 0);
+                             int32_t internal_format_override = 0,
+                             int32_t levels = 1);
 
     texture_2d_ref texture2d(int32_t width,
                              int32_t height,
@@ -274,7 +361,8 @@ public:
                              int32_t samples = 0,
                              int32_t alignment = 1,
                              const std::string& dtype = "f1",
-                             int32_t internal_format_override = 0)
+                             int32_t internal_format_override = 0,
+                             int32_t levels = 1)
     {
       return texture2d(width,
                        height,
@@ -283,7 +371,8 @@ public:
                        samples,
                        alignment,
                        dtype,
-                       internal_format_override);
+                       internal_format_override,
+                       levels);
     }
 
     texture_2d_ref depth_texture2d(int32_t width,
@@ -299,7 +388,8 @@ public:
                              int32_t components,
                              const void* data = nullptr,
                              int32_t alignment = 1,
-                             const std::string& dtype = "f1");
+                             const std::string& dtype = "f1",
+                             int32_t levels = 1);
 
     // TextureArray
     texture_array_ref texture_array(int32_t width,
@@ -308,7 +398,8 @@ public:
                                     int32_t components,
                                     const void* data = nullptr,
                                     int32_t alignment = 1,
-                                    const std::string& dtype = "f1");
+                                    const std::string& dtype = "f1",
+                                    int32_t levels = 1);
 
     // TextureCube
     texture_cube_ref texture_cube(int32_t width,
@@ -317,7 +408,8 @@ public:
                                   const void* data = nullptr,
                                   int32_t alignment = 1,
                                   const std::string& dtype = "f1",
-                                  int32_t internal_format_override = 0);
+                                  int32_t internal_format_override = 0,
+                                  int32_t levels = 1);
 
     // VertexArray
     vertex_array_ref vertex_array(program_ref program,
@@ -333,11 +425,23 @@ public:
     virtual bool is_current() = 0;
 
 protected:
+    // Releases the cached samplers and the query objects of the pool before the context goes away
+    void clear_caches();
+
     bool m_released;
     context_mode::mode m_mode;
 
 private:
     friend class framebuffer;
+    friend class scope;
+
+    void bind_draw_framebuffer(int32_t glo);
+    void bind_read_framebuffer(int32_t glo);
+    void forget_framebuffer(int32_t glo);
+    void apply_viewport(const mgl::rect& r);
+    void apply_scissor(bool enabled, const mgl::rect& r);
+    void apply_color_mask(int32_t index, const color_mask& mask);
+    void apply_depth_mask(bool value);
 
     int32_t m_version;
     int32_t m_max_samples;
@@ -346,6 +450,16 @@ private:
     int32_t m_max_texture_units;
     int32_t m_default_texture_unit;
     float m_max_anisotropy;
+    bool m_texture_storage;
+    bool m_direct_state_access;
+    int32_t m_active_texture_unit;
+    mgl::list<std::array<int32_t, 5>> m_texture_bindings;
+    mgl::list<int32_t> m_sampler_bindings;
+    std::unordered_map<uint64_t, int32_t> m_buffer_bindings;
+    mgl::opengl::scope* m_active_scope;
+    uint32_t m_pending_barriers;
+    mgl::opengl::sampler_cache m_sampler_cache;
+    mgl::opengl::query_pool m_query_pool;
     int32_t m_enable_flags;
     int32_t m_front_face;
     int32_t m_cull_face;
@@ -360,6 +474,13 @@ private:
     mgl::string_list m_extensions;
     framebuffer_ref m_default_framebuffer;
     framebuffer_ref m_bound_framebuffer;
+    int32_t m_draw_framebuffer;
+    int32_t m_read_framebuffer;
+    mgl::rect m_current_viewport;
+    int32_t m_scissor_test;
+    mgl::rect m_current_scissor;
+    mgl::list<int32_t> m_color_mask_bits;
+    int32_t m_depth_write;
   };
 
 #ifdef MGL_OPENGL_EGL
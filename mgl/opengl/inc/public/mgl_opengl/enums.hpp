@@ -45,6 +45,24 @@ namespace mgl::opengl
     ALWAYS = 0x0207,
   };
 
+  enum texture_filter
+  {
+    NEAREST = 0x2600,
+    LINEAR = 0x2601,
+    NEAREST_MIPMAP_NEAREST = 0x2700,
+    LINEAR_MIPMAP_NEAREST = 0x2701,
+    NEAREST_MIPMAP_LINEAR = 0x2702,
+    LINEAR_MIPMAP_LINEAR = 0x2703,
+  };
+
+  enum wrap_mode
+  {
+    REPEAT = 0x2901,
+    MIRRORED_REPEAT = 0x8370,
+    CLAMP_TO_EDGE = 0x812F,
+    CLAMP_TO_BORDER = 0x812D,
+  };
+
   enum blend_equation_mode
   {
     ADD = 0x8006,
@@ -77,4 +95,23 @@ namespace mgl::opengl
     ONE_MINUS_SRC1_ALPHA = 0x88FB,
   };
 
+  // How the results of shader writes are consumed, see compute_shader::dispatch()
+  enum barrier_bit : uint32_t
+  {
+    VERTEX_ATTRIB_ARRAY_BARRIER = 0x00000001,
+    ELEMENT_ARRAY_BARRIER = 0x00000002,
+    UNIFORM_BARRIER = 0x00000004,
+    TEXTURE_FETCH_BARRIER = 0x00000008,
+    SHADER_IMAGE_ACCESS_BARRIER = 0x00000020,
+    COMMAND_BARRIER = 0x00000040,
+    PIXEL_BUFFER_BARRIER = 0x00000080,
+    TEXTURE_UPDATE_BARRIER = 0x00000100,
+    BUFFER_UPDATE_BARRIER = 0x00000200,
+    FRAMEBUFFER_BARRIER = 0x00000400,
+    TRANSFORM_FEEDBACK_BARRIER = 0x00000800,
+    ATOMIC_COUNTER_BARRIER = 0x00001000,
+    SHADER_STORAGE_BARRIER = 0x00002000,
+    ALL_BARRIERS = 0xFFFFFFFF,
+  };
+
 } // namespace  mgl::opengl
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "mgl_core/memory.hpp"
+
+namespace mgl::opengl
+{
+  class context;
+  using context_ref = mgl::ref<context>;
+
+  /**
+   * @class fence
+   * @brief Represents an OpenGL sync object inserted in the command stream.
+   */
+  class fence
+  {
+public:
+    ~fence() = default;
+
+    /**
+     * @brief Deletes the sync object.
+     */
+    void release();
+
+    /**
+     * @brief Checks, without blocking, if the GPU has reached the fence.
+     * @return True if all the commands issued before the fence have completed.
+     */
+    bool signaled();
+
+    /**
+     * @brief Blocks until the GPU reaches the fence or the timeout expires.
+     * @param timeout The timeout in nanoseconds.
+     * @return True if the fence was signaled before the timeout.
+     */
+    bool wait(uint64_t timeout = UINT64_MAX);
+
+    bool released() const { return m_sync == nullptr; }
+
+    context_ref& ctx() { return m_ctx; }
+
+private:
+    friend class context;
+    fence(const context_ref& ctx);
+
+    context_ref m_ctx;
+    void* m_sync;
+  };
+
+  using fence_ref = mgl::ref<fence>;
+
+} // namespace  mgl::opengl
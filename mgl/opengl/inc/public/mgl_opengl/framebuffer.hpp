@@ -22,9 +22,9 @@ public:
 
     const mgl::rect& scissor() const { return m_scissor; }
 
-    void enable_scissor() { m_scissor_enabled = true; }
+    void enable_scissor();
 
-    void disable_scissor() { m_scissor_enabled = false; }
+    void disable_scissor();
 
     void clear(const glm::vec4& color, float depth, const mgl::rect& viewport)
     {
@@ -95,6 +95,9 @@ private:
                 const attachments_ref& color_attachments,
                 attachment_ref depth_attachment);
 
+    // Applies the viewport, scissor and masks through the context's state cache
+    void apply_state();
+
     mgl::rect m_viewport;
     bool m_scissor_enabled;
     mgl::rect m_scissor;
@@ -1,6 +1,10 @@
 #pragma once
 
+#include "mgl_core/containers.hpp"
 #include "mgl_core/memory.hpp"
+
+#include <unordered_map>
+
 namespace mgl::opengl
 {
   class context;
@@ -25,10 +29,18 @@ public:
     void begin_render();
     void end_render();
 
+    void release();
+
     int32_t samples();
     int32_t primitives();
     int32_t elapsed();
 
+    // True once the occlusion result can be read without waiting for the GPU
+    bool ready();
+
+    // Whether any sample passed, waits for the result if it is not ready yet
+    bool any_samples();
+
     bool released() const
     {
       return m_glo[0] == 0 && m_glo[1] == 0 && m_glo[2] == 0 && m_glo[3] == 0;
@@ -52,4 +64,79 @@ private:
 
   using query_ref = mgl::ref<query>;
 
+  /**
+   * @class query_pool
+   * @brief Recycles query objects over the frames in flight and collects their results without
+   * blocking.
+   *
+   * Measurements are identified by a query kind and an id chosen by the caller, e.g. one id per
+   * render pass. A result becomes visible once the GPU has produced it, usually a frame or two
+   * after it was recorded. Results still pending when their frame comes around again are dropped
+   * rather than waited for.
+   */
+  class query_pool
+  {
+public:
+    // Needs at least two frames in flight, results are collected when their frame comes around
+    query_pool(int32_t frames = 3, bool no_wait = false);
+    ~query_pool() = default;
+
+    /**
+     * @brief Starts a measurement in the current frame.
+     * @param kind The query target, only one measurement per kind can be active at a time.
+     * @param id The caller's id for the measurement.
+     */
+    void begin(query::keys kind, int32_t id);
+
+    void end(query::keys kind);
+
+    /**
+     * @brief Collects the results that are ready and moves on to the next frame.
+     *
+     * Call once per frame, after the last measurement was ended.
+     */
+    void next_frame();
+
+    /**
+     * @brief The last collected result of a measurement.
+     * @param kind The query kind.
+     * @param id The caller's id for the measurement.
+     * @param value Receives the result, nanoseconds for TIME_ELAPSED.
+     * @return False if no result has arrived yet.
+     */
+    bool result(query::keys kind, int32_t id, uint64_t& value) const;
+
+    int32_t frames() const { return m_frames.size(); }
+
+    // Measurements whose results were not ready in time
+    uint64_t dropped() const { return m_dropped; }
+
+    // Deletes every query object, the collected results are kept
+    void release();
+
+private:
+    struct pending
+    {
+      query::keys kind;
+      int32_t id;
+      uint32_t glo;
+    };
+
+    struct frame
+    {
+      mgl::list<uint32_t> queries[query::keys::COUNT];
+      int32_t used[query::keys::COUNT] = {};
+      mgl::list<pending> pending;
+    };
+
+    void collect(frame& f, bool last_chance);
+
+    mgl::list<frame> m_frames;
+    int32_t m_current;
+    bool m_no_wait;
+    uint64_t m_dropped;
+    pending m_active[query::keys::COUNT];
+    std::unordered_map<uint64_t, uint64_t> m_results;
+  };
+
 } // namespace  mgl::opengl
\ No newline at end of file
@@ -6,6 +6,8 @@
 
 #include "glm/vec4.hpp"
 
+#include <unordered_map>
+
 namespace mgl::opengl
 {
 
@@ -18,6 +20,28 @@ public:
       int32_t mag_filter;
     };
 
+    // Every parameter of a sampler object, the key of the context's sampler cache
+    struct state
+    {
+      int32_t min_filter = texture_filter::LINEAR;
+      int32_t mag_filter = texture_filter::LINEAR;
+      wrap_mode wrap_x = wrap_mode::REPEAT;
+      wrap_mode wrap_y = wrap_mode::REPEAT;
+      wrap_mode wrap_z = wrap_mode::REPEAT;
+      mgl::opengl::compare_func compare_func = mgl::opengl::compare_func::NONE;
+      float anisotropy = 1.0f;
+      float min_lod = -1000.0f;
+      float max_lod = 1000.0f;
+      glm::vec4 border_color = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+      bool operator==(const state& other) const = default;
+    };
+
+    struct state_hash
+    {
+      size_t operator()(const state& s) const;
+    };
+
     ~sampler() = default;
 
 public:
@@ -26,31 +50,36 @@ public:
 
     virtual void release() override final;
 
+    // Cached samplers are shared, their parameters cannot be changed
+    bool immutable() const { return m_immutable; }
+
+    const state& sampler_state() const { return m_state; }
+
     void set_repeat_x(bool value);
 
-    bool repeat_x() const { return m_repeat_x; }
+    bool repeat_x() const { return m_state.wrap_x == wrap_mode::REPEAT; }
 
     void set_repeat_y(bool value);
 
-    bool repeat_y() const { return m_repeat_y; }
+    bool repeat_y() const { return m_state.wrap_y == wrap_mode::REPEAT; }
 
     void set_repeat_z(bool value);
 
-    bool repeat_z() const { return m_repeat_z; }
+    bool repeat_z() const { return m_state.wrap_z == wrap_mode::REPEAT; }
 
     void set_anisotropy(float value);
 
-    float anisotropy() const { return m_anisotropy; }
+    float anisotropy() const { return m_state.anisotropy; }
 
-    float min_lod() const { return m_min_lod; }
+    float min_lod() const { return m_state.min_lod; }
 
     void set_min_lod(float value);
 
-    float max_lod() const { return m_max_lod; }
+    float max_lod() const { return m_state.max_lod; }
 
     void set_max_lod(float value);
 
-    const glm::vec4& border_color() const { return m_border_color; }
+    const glm::vec4& border_color() const { return m_state.border_color; }
 
     void set_border_color(const glm::vec4& value);
 
@@ -58,28 +87,46 @@ public:
 
     void set_filter(const filter& value);
 
-    const filter& sampler_filter() const { return m_filter; }
+    filter sampler_filter() const { return { m_state.min_filter, m_state.mag_filter }; }
 
     void set_compare_func(mgl::opengl::compare_func value);
 
-    mgl::opengl::compare_func compare_func() { return m_compare_func; }
+    mgl::opengl::compare_func compare_func() { return m_state.compare_func; }
 
 private:
     friend class context;
+    friend class sampler_cache;
     sampler(const context_ref& ctx);
+    sampler(const context_ref& ctx, const state& state, bool immutable);
 
-    float m_anisotropy;
-    bool m_repeat_x;
-    bool m_repeat_y;
-    bool m_repeat_z;
-    float m_min_lod;
-    float m_max_lod;
-    filter m_filter;
-    glm::vec4 m_border_color;
-    mgl::opengl::compare_func m_compare_func;
+    state m_state;
+    bool m_immutable;
   };
 
   using sampler_ref = mgl::ref<sampler>;
   using samplers = mgl::ref_list<sampler>;
 
+  /**
+   * @class sampler_cache
+   * @brief Shares one immutable sampler object per distinct sampler state.
+   */
+  class sampler_cache
+  {
+public:
+    /**
+     * @brief Returns the sampler for a state, creating it with every parameter applied.
+     * @param ctx The context that owns the cache.
+     * @param state The sampler state, the anisotropy is clamped to what the context supports.
+     */
+    sampler_ref get(const context_ref& ctx, const sampler::state& state);
+
+    size_t size() const { return m_samplers.size(); }
+
+    // Releases every cached sampler, references still held elsewhere become invalid
+    void clear();
+
+private:
+    std::unordered_map<sampler::state, sampler_ref, sampler::state_hash> m_samplers;
+  };
+
 } // namespace  mgl::opengl
@@ -47,7 +47,15 @@ public:
 
     ~scope();
 
+    /**
+     * @brief Applies the scope, only binding what the active scope did not already bind.
+     */
     void begin();
+
+    /**
+     * @brief Ends the scope, its state stays applied until the next scope begins or the context's
+     * restore_scope() is called. Nested scopes restore the enclosing scope right away.
+     */
     void end();
 
 private:
@@ -91,7 +99,13 @@ private:
       bool operator!=(const state* other) const { return !(*this == other); }
     };
 
+    void apply();
+    void apply_flags(int32_t flags);
+    void unbind(const scope* next);
+    void restore();
+
     bool m_begin;
+    scope* m_outer;
     context_ref m_ctx;
     sampler_bindings m_samplers;
     mgl::list<scope::binding_data> m_textures;
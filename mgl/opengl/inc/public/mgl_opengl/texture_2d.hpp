@@ -33,6 +33,12 @@ public:
 
     virtual int32_t components() const override { return m_components; }
 
+    // Mip levels allocated at creation
+    int32_t levels() const { return m_levels; }
+
+    // Immutable storage cannot be resized or redefined level by level
+    bool immutable() const { return m_immutable; }
+
     virtual int32_t glo() const override { return gl_object::glo(); }
 
     virtual const context_ref& ctx() const override { return gl_object::ctx(); }
@@ -74,6 +80,9 @@ public:
 
     void write(const buffer_ref& src, int32_t lvl = 0, int32_t align = 1);
 
+    // Defines the storage of a mip level and fills it, levels up to lvl become sampleable
+    void write_level(const void* src, int32_t lvl, int32_t align = 1);
+
     void resize(int32_t w, int32_t h, int32_t components = 4, const mgl::uint8_buffer& data = {});
 
     void bind_to_image(
@@ -94,7 +103,8 @@ private:
                int32_t samples,
                int32_t align,
                const std::string& dtype,
-               int32_t internal_format_override);
+               int32_t internal_format_override,
+               int32_t levels);
 
     texture_2d(const context_ref& ctx,
                int32_t w,
@@ -111,6 +121,8 @@ private:
     int32_t m_components;
     texture::filter m_filter;
     int32_t m_max_lvl;
+    int32_t m_levels;
+    bool m_immutable;
     mgl::opengl::compare_func m_compare_func;
     float m_anisotropy;
     bool m_repeat_x;
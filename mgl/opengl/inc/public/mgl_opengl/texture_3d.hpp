@@ -34,6 +34,12 @@ public:
 
     int32_t depth() const { return m_depth; }
 
+    // Mip levels allocated at creation
+    int32_t levels() const { return m_levels; }
+
+    // Immutable storage cannot be redefined level by level
+    bool immutable() const { return m_immutable; }
+
     bool repeat_x() const { return m_repeat_x; }
 
     void set_repeat_x(bool value);
@@ -81,7 +87,8 @@ private:
                int32_t components,
                const void* data,
                int32_t align,
-               const std::string& dtype);
+               const std::string& dtype,
+               int32_t levels);
 
     data_type* m_data_type;
     int32_t m_width;
@@ -90,6 +97,8 @@ private:
     int32_t m_components;
     texture::filter m_filter;
     int32_t m_max_lvl;
+    int32_t m_levels;
+    bool m_immutable;
     bool m_repeat_x;
     bool m_repeat_y;
     bool m_repeat_z;
@@ -26,6 +26,12 @@ public:
 
     int32_t components() const { return m_components; }
 
+    // Mip levels allocated at creation
+    int32_t levels() const { return m_levels; }
+
+    // Immutable storage cannot be redefined level by level
+    bool immutable() const { return m_immutable; }
+
     bool repeat_x() const { return m_repeat_x; }
 
     void set_repeat_x(bool value);
@@ -75,7 +81,8 @@ private:
                   int32_t components,
                   const void* data,
                   int32_t align,
-                  const std::string& dtype);
+                  const std::string& dtype,
+                  int32_t levels);
 
     data_type* m_data_type;
     int32_t m_width;
@@ -84,6 +91,8 @@ private:
     int32_t m_components;
     texture::filter m_filter;
     int32_t m_max_level;
+    int32_t m_levels;
+    bool m_immutable;
     bool m_repeat_x;
     bool m_repeat_y;
     float m_anisotropy;
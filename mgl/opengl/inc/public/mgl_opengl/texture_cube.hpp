@@ -25,6 +25,12 @@ public:
 
     virtual int32_t components() const override { return m_components; }
 
+    // Mip levels allocated at creation
+    int32_t levels() const { return m_levels; }
+
+    // Immutable storage cannot be redefined level by level
+    bool immutable() const { return m_immutable; }
+
     virtual int32_t glo() const override { return gl_object::glo(); }
 
     virtual const context_ref& ctx() const override { return gl_object::ctx(); }
@@ -57,6 +63,8 @@ public:
     void bind_to_image(
         int32_t unit, bool read = true, bool write = true, int32_t lvl = 0, int32_t format = 0);
 
+    void build_mipmaps(int32_t base = 0, int32_t max_lvl = 1000);
+
     virtual void use(int32_t index = 0) override;
 
 private:
@@ -69,7 +77,8 @@ private:
                  const void* data,
                  int32_t align,
                  const std::string& dtype,
-                 int32_t internal_format_override);
+                 int32_t internal_format_override,
+                 int32_t levels);
 
     data_type* m_data_type;
     int32_t m_width;
@@ -77,6 +86,8 @@ private:
     int32_t m_components;
     texture::filter m_filter;
     int32_t m_max_lvl;
+    int32_t m_levels;
+    bool m_immutable;
     float m_anisotropy;
   };
 
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+namespace mgl::opengl::validation
+{
+  /**
+   * @brief Whether the error checks are compiled in.
+   *
+   * They are in debug builds, or when the library is built with MGL_OPENGL_VALIDATION. Otherwise
+   * every check compiles to nothing and the rest of this namespace has no effect.
+   */
+  bool available();
+
+  /**
+   * @brief Turns the compiled in checks on or off at runtime, they start enabled.
+   *
+   * With GL_KHR_debug the errors are collected by the debug output callback and a check only
+   * reports what was collected since the previous one. Without it the checks poll glGetError.
+   */
+  void set_enabled(bool value);
+
+  bool enabled();
+
+  // Errors reported by the checks since the last reset
+  uint64_t error_count();
+
+  void reset();
+
+} // namespace  mgl::opengl::validation
@@ -3,6 +3,8 @@
 
 #include "mgl_core/debug.hpp"
 
+#include "mgl_opengl_internal.hpp"
+
 #include "glad/gl.h"
 
 namespace mgl::opengl
@@ -23,7 +25,7 @@ namespace mgl::opengl
     gl_object::set_glo(glo);
     glBindBuffer(GL_ARRAY_BUFFER, gl_object::glo());
     glBufferData(GL_ARRAY_BUFFER, reserve, data, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[Program] Error on creating buffer.");
+    MGL_GL_CHECK("[Program] Error on creating buffer.");
   }
 
   void buffer::release()
@@ -32,6 +34,7 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Buffer] Resource context not current.");
     GLuint glo = gl_object::glo();
     glDeleteBuffers(1, &glo);
+    gl_object::ctx()->forget_buffer(glo);
     gl_object::set_glo(ZERO);
     m_size = 0;
     m_pos = 0;
@@ -50,12 +53,13 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(m_size >= off + n_bytes, "[Buffer] Source out of bounds.")
     MGL_CORE_ASSERT(dst_sz >= dst_off + n_bytes, "[Buffer] Destination out of bounds.")
 
+    gl_object::ctx()->require_barrier(barrier_bit::BUFFER_UPDATE_BARRIER);
     glBindBuffer(GL_ARRAY_BUFFER, gl_object::glo());
     auto map = glMapBufferRange(GL_ARRAY_BUFFER, off, n_bytes, GL_MAP_READ_BIT);
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[Buffer] Error mapping buffer.");
+    MGL_GL_CHECK("[Buffer] Error mapping buffer.");
     std::copy((char*)map, (char*)map + n_bytes, (char*)dst + dst_off);
     glUnmapBuffer(GL_ARRAY_BUFFER);
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[Buffer] Error writing to buffer.");
+    MGL_GL_CHECK("[Buffer] Error writing to buffer.");
   }
 
   void buffer::upload(const void* src, size_t src_sz, size_t off)
@@ -64,9 +68,10 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Buffer] Resource context not current.");
     MGL_CORE_ASSERT(src_sz + off <= m_size, "[Buffer] Source out of bounds.")
 
+    gl_object::ctx()->require_barrier(barrier_bit::BUFFER_UPDATE_BARRIER);
     glBindBuffer(GL_ARRAY_BUFFER, gl_object::glo());
     glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)off, src_sz, src);
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[Buffer] Error writing to buffer.");
+    MGL_GL_CHECK("[Buffer] Error writing to buffer.");
     m_pos = off + src_sz;
   }
 
@@ -75,12 +80,13 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(!gl_object::released(), "[Buffer] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Buffer] Resource context not current.");
 
+    gl_object::ctx()->require_barrier(barrier_bit::BUFFER_UPDATE_BARRIER);
     glBindBuffer(GL_ARRAY_BUFFER, gl_object::glo());
     char* map = (char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, m_size, GL_MAP_WRITE_BIT);
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[Buffer] Error mapping buffer.");
+    MGL_GL_CHECK("[Buffer] Error mapping buffer.");
     std::fill(map, map + m_size, 0);
     glUnmapBuffer(GL_ARRAY_BUFFER);
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[Buffer] Error writing to buffer.");
+    MGL_GL_CHECK("[Buffer] Error writing to buffer.");
     m_pos = 0;
   }
 
@@ -94,6 +100,7 @@ namespace mgl::opengl
       size = m_size;
     }
 
+    gl_object::ctx()->require_barrier(barrier_bit::BUFFER_UPDATE_BARRIER);
     glBindBuffer(GL_ARRAY_BUFFER, gl_object::glo());
     glBufferData(GL_ARRAY_BUFFER, size, 0, m_dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
     m_size = size;
@@ -112,7 +119,7 @@ namespace mgl::opengl
       size = m_size - off;
     }
 
-    glBindBufferRange(GL_UNIFORM_BUFFER, binding, gl_object::glo(), off, size);
+    gl_object::ctx()->bind_buffer_range(GL_UNIFORM_BUFFER, binding, gl_object::glo(), off, size);
   }
 
   void buffer::bind_to_storage_buffer(int binding, size_t size, size_t off)
@@ -127,7 +134,8 @@ namespace mgl::opengl
       size = m_size - off;
     }
 
-    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, binding, gl_object::glo(), off, size);
+    gl_object::ctx()->bind_buffer_range(
+        GL_SHADER_STORAGE_BUFFER, binding, gl_object::glo(), off, size);
   }
 
   void buffer::copy_to(const buffer_ref& dst, size_t size, size_t off, size_t dst_off)
@@ -145,10 +153,11 @@ namespace mgl::opengl
     MGL_CORE_ASSERT((off + size <= m_size && dst_off + size <= dst->m_size),
                     "[Buffer] Buffer overflow.");
 
+    ctx()->require_barrier(barrier_bit::BUFFER_UPDATE_BARRIER);
     glBindBuffer(GL_COPY_READ_BUFFER, glo());
     glBindBuffer(GL_COPY_WRITE_BUFFER, dst->glo());
     glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, off, dst_off, size);
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[Buffer] Error copying buffer.");
+    MGL_GL_CHECK("[Buffer] Error copying buffer.");
   }
 
   void buffer::copy(
@@ -167,10 +176,11 @@ namespace mgl::opengl
     MGL_CORE_ASSERT((off + size <= src->m_size && dst_off + size <= dst->m_size),
                     "[Buffer] Buffer overflow.");
 
+    src->ctx()->require_barrier(barrier_bit::BUFFER_UPDATE_BARRIER);
     glBindBuffer(GL_COPY_READ_BUFFER, src->glo());
     glBindBuffer(GL_COPY_WRITE_BUFFER, dst->glo());
     glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, off, dst_off, size);
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[Buffer] Error copying buffer.");
+    MGL_GL_CHECK("[Buffer] Error copying buffer.");
   }
 
 } // namespace  mgl::opengl
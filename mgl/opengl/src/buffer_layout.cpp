@@ -1,212 +1,62 @@
+#include "mgl_core/debug.hpp"
 #include "mgl_core/string.hpp"
 
 #include "mgl_opengl/buffer_layout.hpp"
 
 #include "glad/gl.h"
 
+#include <mutex>
+#include <unordered_map>
+
 namespace mgl::opengl
 {
-  // A buffer layout is a short string describing the layout of data in a vertex buffer object (VBO).
-  // The buffer layout looks like: [count]type[size] [[count]type[size]...] [/usage]
-  void buffer_layout::parse_layout(const std::string& layout)
-  {
-    m_layout = layout;
-
-    // The format is used to describe the layout of the data in the VBO
-    for(buffer_layout::iterator it = begin(); it != end(); ++it)
-    {
-      if(it.value().is_invalid())
-      {
-        m_layout = "";
-        m_elements.clear();
-        m_stride = 0;
-        m_divisor = 0;
-        return;
-      }
+  static_assert(internal::gl_byte == GL_BYTE && internal::gl_unsigned_byte == GL_UNSIGNED_BYTE);
+  static_assert(internal::gl_short == GL_SHORT && internal::gl_unsigned_short == GL_UNSIGNED_SHORT);
+  static_assert(internal::gl_int == GL_INT && internal::gl_unsigned_int == GL_UNSIGNED_INT);
+  static_assert(internal::gl_float == GL_FLOAT && internal::gl_double == GL_DOUBLE);
+  static_assert(internal::gl_half_float == GL_HALF_FLOAT);
 
-      m_stride += it.value().size;
+  // Every layout string seen so far, the nodes never move so layouts can keep a pointer to them
+  static std::unordered_map<std::string, layout_descriptor> s_layouts;
+  static std::mutex s_layouts_mutex;
 
-      if(it.value().type != 0)
-      {
-        m_elements.push_back(it.value());
-      }
-    }
+  void internal::invalid_buffer_layout()
+  {
+    MGL_CORE_ASSERT(false, "[BufferLayout] Invalid layout.");
+  }
 
-    // The divisor is used to describe the usage of the data in the VBO
-    mgl::string_list split = mgl::split(layout, '/');
+  buffer_layout::buffer_layout(const std::string& layout)
+  {
+    std::lock_guard<std::mutex> lock(s_layouts_mutex);
 
-    if(split.size() > 1)
-    {
-      std::string divisor = split[1];
-      if(divisor == "i")
-      {
-        // /i per instance. Successive values from the buffer are passed to each instance.
-        m_divisor = 1;
-      }
-      else if(divisor == "r")
-      {
-        // /r per render. . the first buffer value is passed to every vertex of every instance. ie. behaves like a uniform.
-        m_divisor = 0x7fffffff;
-      }
-      else if(divisor == "v")
-      {
-        // /v per vertex. Successive values from the buffer are passed to each vertex. This is the default behavior if usage is omitted.
-        m_divisor = 0;
-      }
-      else
-      {
-        // Invalid divisor
-        m_layout = "";
-        m_elements.clear();
-        m_stride = 0;
-        m_divisor = 0;
-      }
-    }
-    else
+    auto it = s_layouts.find(layout);
+    if(it == s_layouts.end())
     {
-      m_divisor = 0;
+      it = s_layouts.emplace(layout, layout_descriptor()).first;
+      it->second = parse_layout(it->first);
     }
+
+    m_entry = &*it;
   }
 
-  // The iterator is used to parse the layout string and return the next element in the layout
-  buffer_layout::iterator::iterator(const char* ptr, int offset)
-      : m_ptr(ptr)
-      , m_offset(offset)
+  buffer_layout::buffer_layout(const layout_descriptor& descriptor)
   {
-    if(ptr == nullptr)
-    {
-      m_element = { 0, 0, 0, 0, false };
-      return;
-    }
+    std::lock_guard<std::mutex> lock(s_layouts_mutex);
 
-    m_element.count = 0;
-    while(true)
+    auto it = s_layouts.find(std::string(descriptor.source));
+    if(it == s_layouts.end())
     {
-      char chr = *m_ptr++;
-
-      // Skip spaces
-      if(isspace(chr))
-      {
-        continue;
-      }
-
-      // While it's a digit, accumulate it
-      if(isdigit(chr))
-      {
-        m_element.count = m_element.count * 10 + (chr - '0');
-        continue;
-      }
-
-      // If it's the end of the string or a divisor the element is invalid, return
-      if(chr == 0 || chr == '/')
-      {
-        --m_ptr;
-        m_element = { 0, 0, 0, 0, false };
-        return;
-      }
-
-      // it's a data type, if there's no count, it's 1 by default
-      m_element.count = m_element.count ? m_element.count : 1;
-
-      char data_type = chr;
-      int size = -1;
-
-      // Now we need to check if there's a size
-      chr = *m_ptr++;
-
-      switch(chr)
-      {
-        // If it's a digit, accumulate it
-        case '0' ... '9':
-          size = chr - '0';
-          // It is mandoatory that the if there is a next character, it's a divisor or a space
-          if(*m_ptr && *m_ptr != ' ' && *m_ptr != '/')
-          {
-            m_element = { 0, 0, 0, 0, false };
-            return;
-          }
-          break;
-        // If it's a space, it's the end of the element
-        // If it's the end of the string or a divisor the size it's the default for the data type
-        case 0:
-        case '/': --m_ptr; break;
-        case ' ': break;
-        // Otherwise it's invalid
-        default: m_element = { 0, 0, 0, 0, false }; return;
-      }
-
-      // If the size is 1, it's a normalized format
-      m_element.normalize = size == 1;
-      m_element.offset = m_offset;
-
-      switch(data_type)
-      {
-        // float
-        case 'f':
-          // If the size is -1, it's the default for the data type
-          size = size == -1 ? 4 : size;
-          switch(size)
-          {
-            case 1: m_element.type = GL_UNSIGNED_BYTE; break;
-            case 2: m_element.type = GL_HALF_FLOAT; break;
-            case 4: m_element.type = GL_FLOAT; break;
-            case 8: m_element.type = GL_DOUBLE; break;
-            default: m_element = { 0, 0, 0, 0, false }; return;
-          }
-          m_element.size = size * m_element.count;
-          m_offset += m_element.size;
-          return;
-        // signed integer
-        case 'i':
-          // If the size is -1, it's the default for the data type
-          size = size == -1 ? 4 : size;
-          switch(size)
-          {
-            case 1: m_element.type = GL_BYTE; break;
-            case 2: m_element.type = GL_SHORT; break;
-            case 4: m_element.type = GL_INT; break;
-            case 8: m_element.type = GL_DOUBLE; break;
-            default: m_element = { 0, 0, 0, 0, false }; return;
-          }
-          m_element.size = size * m_element.count;
-          m_offset += m_element.size;
-          return;
-        // unsigned int
-        case 'u':
-          size = size == -1 ? 4 : size;
-          switch(size)
-          {
-            case 1: m_element.type = GL_UNSIGNED_BYTE; break;
-            case 2: m_element.type = GL_UNSIGNED_SHORT; break;
-            case 4: m_element.type = GL_UNSIGNED_INT; break;
-            default: m_element = { 0, 0, 0, 0, false }; return;
-          }
-          m_element.size = size * m_element.count;
-          return;
-        // padding
-        case 'x':
-          size = size == -1 ? 1 : size;
-          m_element.size = size * m_element.count;
-          m_element.type = 0;
-          m_offset += m_element.size;
-          return;
-        default: m_element = { 0, 0, 0, 0, false }; return;
-      }
+      it = s_layouts.emplace(descriptor.source, descriptor).first;
+      it->second.source = it->first;
     }
+
+    m_entry = &*it;
   }
 
-  // Returns the next element in the layout
-  buffer_layout::iterator& buffer_layout::iterator::operator++()
+  size_t buffer_layout::interned()
   {
-    if(*m_ptr == 0 || *m_ptr == '/')
-    {
-      m_ptr = nullptr;
-      m_element = { 0, 0, 0, 0, false };
-      return *this;
-    }
-
-    *this = iterator(m_ptr, m_offset);
-    return *this;
+    std::lock_guard<std::mutex> lock(s_layouts_mutex);
+    return s_layouts.size();
   }
 
-} // namespace mgl::opengl
\ No newline at end of file
+} // namespace mgl::opengl
@@ -0,0 +1,126 @@
+#include "mgl_opengl/call_counter.hpp"
+
+#include "glad/gl.h"
+
+#include <type_traits>
+
+namespace mgl::opengl::call_counter
+{
+  template <auto* Slot,
+            typename Fn = std::remove_pointer_t<std::remove_reference_t<decltype(*Slot)>>>
+  struct hook;
+
+  // Stands in for the GL function stored in Slot, counting and forwarding every call
+  template <auto* Slot, typename R, typename... Args>
+  struct hook<Slot, R GLAD_API_PTR(Args...)>
+  {
+    static inline std::remove_reference_t<decltype(*Slot)> original = nullptr;
+    static inline uint64_t calls = 0;
+
+    static R GLAD_API_PTR call(Args... args)
+    {
+      calls++;
+      return original(args...);
+    }
+
+    static void install()
+    {
+      // Entry points the driver does not expose stay null
+      if(*Slot == nullptr || *Slot == &call)
+        return;
+
+      original = *Slot;
+      *Slot = &call;
+    }
+
+    static void remove()
+    {
+      if(*Slot == &call)
+        *Slot = original;
+    }
+  };
+
+  struct entry
+  {
+    const char* name;
+    void (*install)();
+    void (*remove)();
+    uint64_t* calls;
+  };
+
+  template <auto* Slot>
+  static entry counted(const char* name)
+  {
+    return { name, &hook<Slot>::install, &hook<Slot>::remove, &hook<Slot>::calls };
+  }
+
+#define MGL_COUNTED(fn) counted<&glad_##fn>(#fn)
+
+  static entry s_entries[] = {
+    MGL_COUNTED(glActiveTexture),
+    MGL_COUNTED(glBindTexture),
+    MGL_COUNTED(glTexParameteri),
+    MGL_COUNTED(glTexParameterf),
+    MGL_COUNTED(glTextureParameteri),
+    MGL_COUNTED(glTextureParameterf),
+    MGL_COUNTED(glBindSampler),
+    MGL_COUNTED(glBindFramebuffer),
+    MGL_COUNTED(glBindBufferBase),
+    MGL_COUNTED(glDrawBuffers),
+    MGL_COUNTED(glViewport),
+    MGL_COUNTED(glScissor),
+    MGL_COUNTED(glEnable),
+    MGL_COUNTED(glDisable),
+    MGL_COUNTED(glColorMaski),
+    MGL_COUNTED(glDepthMask),
+    MGL_COUNTED(glGenQueries),
+    MGL_COUNTED(glGetQueryObjectui64v),
+    MGL_COUNTED(glDispatchCompute),
+    MGL_COUNTED(glDispatchComputeIndirect),
+    MGL_COUNTED(glMemoryBarrier),
+    MGL_COUNTED(glGetError),
+  };
+
+#undef MGL_COUNTED
+
+  static bool s_enabled = false;
+
+  void enable()
+  {
+    for(auto&& e : s_entries)
+      e.install();
+
+    s_enabled = true;
+  }
+
+  void disable()
+  {
+    for(auto&& e : s_entries)
+      e.remove();
+
+    s_enabled = false;
+  }
+
+  bool enabled()
+  {
+    return s_enabled;
+  }
+
+  void reset()
+  {
+    for(auto&& e : s_entries)
+      *e.calls = 0;
+  }
+
+  uint64_t count(const std::string& function)
+  {
+    for(auto&& e : s_entries)
+    {
+      if(function == e.name)
+        return *e.calls;
+    }
+
+    return 0;
+  }
+
+} // namespace  mgl::opengl::call_counter
@@ -126,16 +126,43 @@ namespace mgl::opengl
     gl_object::set_glo(GL_ZERO);
   }
 
+  // Writes from earlier dispatches that the dispatch itself may read
+  static const uint32_t s_dispatch_barriers =
+      barrier_bit::UNIFORM_BARRIER | barrier_bit::TEXTURE_FETCH_BARRIER |
+      barrier_bit::SHADER_IMAGE_ACCESS_BARRIER | barrier_bit::SHADER_STORAGE_BARRIER |
+      barrier_bit::ATOMIC_COUNTER_BARRIER;
+
   void compute_shader::run(int32_t x, int32_t y, int32_t z, bool barrier)
+  {
+    dispatch(x, y, z, barrier ? barrier_bit::ALL_BARRIERS : 0);
+  }
+
+  void compute_shader::dispatch(int32_t x, int32_t y, int32_t z, uint32_t consumers)
   {
     MGL_CORE_ASSERT(!released(), "[Compute] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Compute] Resource context not current.");
+    gl_object::ctx()->require_barrier(s_dispatch_barriers);
     glUseProgram(gl_object::glo());
     glDispatchCompute(x, y, z);
-    if(barrier)
-    {
-      glMemoryBarrier(GL_ALL_BARRIER_BITS);
-    }
+    gl_object::ctx()->defer_barrier(consumers);
+  }
+
+  void compute_shader::run_indirect(const buffer_ref& buffer, size_t offset, uint32_t consumers)
+  {
+    MGL_CORE_ASSERT(!released(), "[Compute] Resource already released or not valid.");
+    MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Compute] Resource context not current.");
+    MGL_CORE_ASSERT(buffer, "[Compute] Invalid buffer.");
+    MGL_CORE_ASSERT(offset % 4 == 0, "[Compute] Offset must be a multiple of 4.");
+    MGL_CORE_ASSERT(offset + 3 * sizeof(uint32_t) <= buffer->size(),
+                    "[Compute] Buffer out of bounds.");
+
+    gl_object::ctx()->require_barrier(s_dispatch_barriers | barrier_bit::COMMAND_BARRIER);
+    glUseProgram(gl_object::glo());
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, buffer->glo());
+    glDispatchComputeIndirect((GLintptr)offset);
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0);
+    MGL_GL_CHECK("[Compute] OpenGL error.");
+    gl_object::ctx()->defer_barrier(consumers);
   }
 
 } // namespace  mgl::opengl
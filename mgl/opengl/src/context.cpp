@@ -3,6 +3,7 @@
 #include "mgl_opengl/buffer_layout.hpp"
 #include "mgl_opengl/compute_shader.hpp"
 #include "mgl_opengl/data_type.hpp"
+#include "mgl_opengl/fence.hpp"
 #include "mgl_opengl/framebuffer.hpp"
 #include "mgl_opengl/program.hpp"
 #include "mgl_opengl/query.hpp"
@@ -28,74 +29,6 @@
 namespace mgl::opengl
 {
 
-#ifdef MGL_DEBUG
-  const static std::string opengl_debug_source_str[6] = {
-    "API", "WINDOW_SYSTEM", "SHADER_COMPILER", "THIRD_PARTY", "APPLICATION", "OTHER",
-  };
-
-  const static std::string opengl_debug_type_str[6] = {
-    "ERROR", "DEPRECATED BEHAVIOR", "UNDEFINED BEHAVIOR", "PORTABILITY", "PERFORMANCE", "OTHER"
-  };
-
-  const char* opengl_debug_severity_str[4] = { "HIGH", "MEDIUM", "LOW", "INFO" };
-
-  void opengl_message_callback(GLenum source,
-                               GLenum type,
-                               GLuint id,
-                               GLenum severity,
-                               GLsizei length,
-                               const GLchar* message,
-                               const void* userParam)
-  {
-    int sev_idx, t_idx, src_idx;
-
-    switch(severity)
-    {
-      case GL_DEBUG_SEVERITY_HIGH: sev_idx = 0; break;
-      case GL_DEBUG_SEVERITY_MEDIUM: sev_idx = 1; break;
-      case GL_DEBUG_SEVERITY_LOW: sev_idx = 2; break;
-      default: sev_idx = 3; break;
-    }
-
-    switch(type)
-    {
-      case GL_DEBUG_TYPE_ERROR: t_idx = 0; break;
-      case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: t_idx = 1; break;
-      case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR: t_idx = 2; break;
-      case GL_DEBUG_TYPE_PORTABILITY: t_idx = 3; break;
-      case GL_DEBUG_TYPE_PERFORMANCE: t_idx = 4; break;
-      default: t_idx = 5; break;
-    }
-
-    switch(source)
-    {
-      case GL_DEBUG_SOURCE_API: src_idx = 0; break;
-      case GL_DEBUG_SOURCE_WINDOW_SYSTEM: src_idx = 1; break;
-      case GL_DEBUG_SOURCE_SHADER_COMPILER: src_idx = 2; break;
-      case GL_DEBUG_SOURCE_THIRD_PARTY: src_idx = 3; break;
-      case GL_DEBUG_SOURCE_APPLICATION: src_idx = 4; break;
-      default: src_idx = 5; break;
-    }
-
-    if(t_idx == 0)
-    {
-      MGL_CORE_ERROR("[GL DEBUG] ({0}) {1}, {2}: {3}",
-                     opengl_debug_severity_str[sev_idx],
-                     opengl_debug_source_str[src_idx],
-                     opengl_debug_type_str[t_idx],
-                     message);
-    }
-    else
-    {
-      MGL_CORE_ERROR("[GL DEBUG] ({0}) {1}, {2}: {3}\n",
-                     opengl_debug_severity_str[sev_idx],
-                     opengl_debug_source_str[src_idx],
-                     opengl_debug_type_str[t_idx],
-                     message);
-    }
-  }
-#endif
-
   context_ref context::create_context(context_mode::mode mode, int32_t required)
   {
 
@@ -170,22 +103,6 @@ namespace mgl::opengl
       return nullptr;
     }
 
-#ifdef MGL_DEBUG
-    if(ctx->m_version >= 430)
-    {
-      glEnable(GL_DEBUG_OUTPUT);
-      glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
-      glDebugMessageCallback(opengl_message_callback, nullptr);
-      glDebugMessageControl(
-          GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);
-    }
-    else
-    {
-      MGL_CORE_WARN("[GL Context] Debug output not supported in OpenGL version {0}",
-                    ctx->m_version);
-    }
-#endif
-
     // Load extensions
     int32_t num_extensions = 0;
     glGetIntegerv(GL_NUM_EXTENSIONS, &num_extensions);
@@ -196,6 +113,23 @@ namespace mgl::opengl
       ctx->m_extensions.push_back(ext);
     }
 
+#ifdef MGL_OPENGL_VALIDATION
+    if(ctx->m_version >= 430 || mgl::in("GL_KHR_debug", ctx->m_extensions))
+    {
+      internal::enable_debug_output();
+    }
+    else
+    {
+      MGL_CORE_WARN("[GL Context] Debug output not supported in OpenGL version {0}",
+                    ctx->m_version);
+    }
+#endif
+
+    ctx->m_texture_storage =
+        ctx->m_version >= 420 || mgl::in("GL_ARB_texture_storage", ctx->m_extensions);
+    ctx->m_direct_state_access =
+        ctx->m_version >= 450 || mgl::in("GL_ARB_direct_state_access", ctx->m_extensions);
+
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
@@ -223,6 +157,19 @@ namespace mgl::opengl
     glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, (GLint*)&ctx->m_max_texture_units);
     ctx->m_default_texture_unit = ctx->m_max_texture_units - 1;
 
+    // The state left by whoever owned the context before is unknown
+    ctx->m_texture_bindings.resize(ctx->m_max_texture_units);
+    ctx->m_sampler_bindings.resize(ctx->m_max_texture_units);
+    ctx->reset_texture_bindings();
+    ctx->reset_buffer_bindings();
+    ctx->m_active_scope = nullptr;
+    ctx->m_pending_barriers = 0;
+
+    // Results can be polled in a single call instead of checking availability first
+    bool query_no_wait =
+        ctx->m_version >= 440 || mgl::in("GL_ARB_query_buffer_object", ctx->m_extensions);
+    ctx->m_query_pool = mgl::opengl::query_pool(3, query_no_wait);
+
     ctx->m_max_anisotropy = 0.0;
     glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, (GLfloat*)&ctx->m_max_anisotropy);
 
@@ -230,6 +177,9 @@ namespace mgl::opengl
 
     ctx->m_bound_framebuffer = ctx->m_default_framebuffer;
 
+    ctx->m_color_mask_bits.resize(ctx->m_max_color_attachments);
+    ctx->reset_framebuffer_state();
+
     ctx->m_enable_flags = 0;
     ctx->m_front_face = GL_CCW;
 
@@ -245,7 +195,7 @@ namespace mgl::opengl
     ctx->m_polygon_offset_factor = 0.0f;
     ctx->m_polygon_offset_units = 0.0f;
 
-    glGetError(); // clear errors
+    internal::discard_errors();
 
     return ctx;
   }
@@ -266,6 +216,14 @@ namespace mgl::opengl
     return compute_shader_ref(shader);
   }
 
+  fence_ref context::fence()
+  {
+    MGL_CORE_ASSERT(!released(), "[GL Context] Context already released or not valid.");
+    MGL_CORE_ASSERT(is_current(), "[GL Context] Resource context not current.");
+    auto fence = new mgl::opengl::fence(shared_from_this());
+    return fence_ref(fence);
+  }
+
   framebuffer_ref context::framebuffer(const attachments_ref& color_attachments,
                                        attachment_ref depth_attachment)
   {
@@ -325,6 +283,19 @@ namespace mgl::opengl
     return sampler_ref(sampler);
   }
 
+  sampler_ref context::sampler(const mgl::opengl::sampler::state& state)
+  {
+    MGL_CORE_ASSERT(!released(), "[GL Context] Context already released or not valid.");
+    MGL_CORE_ASSERT(is_current(), "[GL Context] Resource context not current.");
+    return m_sampler_cache.get(shared_from_this(), state);
+  }
+
+  void context::clear_caches()
+  {
+    m_sampler_cache.clear();
+    m_query_pool.release();
+  }
+
   scope_ref context::scope(framebuffer_ref framebuffer,
                            int32_t enable_flags,
                            const texture_bindings& textures,
@@ -344,6 +315,18 @@ namespace mgl::opengl
     return scope_ref(scope);
   }
 
+  void context::restore_scope()
+  {
+    MGL_CORE_ASSERT(!released(), "[GL Context] Context already released or not valid.");
+    MGL_CORE_ASSERT(is_current(), "[GL Context] Resource context not current.");
+
+    if(m_active_scope == nullptr)
+      return;
+
+    MGL_CORE_ASSERT(!m_active_scope->m_begin, "[GL Context] Scope not ended.");
+    m_active_scope->restore();
+  }
+
   texture_2d_ref context::texture2d(int32_t width,
                                     int32_t height,
                                     int32_t components,
@@ -351,7 +334,8 @@ namespace mgl::opengl
                                     int32_t samples,
                                     int32_t alignment,
                                     const std::string& dtype,
-                                    int32_t internal_format_override)
+                                    int32_t internal_format_override,
+                                    int32_t levels)
   {
     MGL_CORE_ASSERT(!released(), "[GL Context] Context already released or not valid.");
     MGL_CORE_ASSERT(is_current(), "[GL Context] Resource context not current.");
@@ -363,7 +347,8 @@ namespace mgl::opengl
                                                samples,
                                                alignment,
                                                dtype,
-                                               internal_format_override);
+                                               internal_format_override,
+                                               levels);
     return texture_2d_ref(texture);
   }
 
@@ -383,12 +368,13 @@ namespace mgl::opengl
                                     int32_t components,
                                     const void* data,
                                     int32_t alignment,
-                                    const std::string& dtype)
+                                    const std::string& dtype,
+                                    int32_t levels)
   {
     MGL_CORE_ASSERT(!released(), "[GL Context] Context already released or not valid.");
     MGL_CORE_ASSERT(is_current(), "[GL Context] Resource context not current.");
     auto texture = new mgl::opengl::texture_3d(
-        shared_from_this(), width, height, depth, components, data, alignment, dtype);
+        shared_from_this(), width, height, depth, components, data, alignment, dtype, levels);
     return texture_3d_ref(texture);
   }
 
@@ -398,12 +384,13 @@ namespace mgl::opengl
                                            int32_t components,
                                            const void* data,
                                            int32_t alignment,
-                                           const std::string& dtype)
+                                           const std::string& dtype,
+                                           int32_t levels)
   {
     MGL_CORE_ASSERT(!released(), "[GL Context] Context already released or not valid.");
     MGL_CORE_ASSERT(is_current(), "[GL Context] Resource context not current.");
     auto texture = new mgl::opengl::texture_array(
-        shared_from_this(), width, height, layers, components, data, alignment, dtype);
+        shared_from_this(), width, height, layers, components, data, alignment, dtype, levels);
     return texture_array_ref(texture);
   }
 
@@ -413,7 +400,8 @@ namespace mgl::opengl
                                          const void* data,
                                          int32_t alignment,
                                          const std::string& dtype,
-                                         int32_t internal_format_override)
+                                         int32_t internal_format_override,
+                                         int32_t levels)
   {
     MGL_CORE_ASSERT(!released(), "[GL Context] Context already released or not valid.");
     MGL_CORE_ASSERT(is_current(), "[GL Context] Resource context not current.");
@@ -424,7 +412,8 @@ namespace mgl::opengl
                                                  data,
                                                  alignment,
                                                  dtype,
-                                                 internal_format_override);
+                                                 internal_format_override,
+                                                 levels);
     return texture_cube_ref(texture);
   }
 
@@ -449,39 +438,37 @@ namespace mgl::opengl
     if(flags & mgl::opengl::enable_flag::BLEND)
     {
       glEnable(GL_BLEND);
-      MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Context] Fail on enabling GL_BLEND");
+      MGL_GL_CHECK("[GL Context] Fail on enabling GL_BLEND");
     }
 
     if(flags & mgl::opengl::enable_flag::DEPTH_TEST)
     {
       glEnable(GL_DEPTH_TEST);
-      MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Context] Fail on enabling GL_DEPTH_TEST");
+      MGL_GL_CHECK("[GL Context] Fail on enabling GL_DEPTH_TEST");
     }
 
     if(flags & mgl::opengl::enable_flag::CULL_FACE)
     {
       glEnable(GL_CULL_FACE);
-      MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Context] Fail on enabling GL_CULL_FACE");
+      MGL_GL_CHECK("[GL Context] Fail on enabling GL_CULL_FACE");
     }
 
     if(flags & mgl::opengl::enable_flag::STENCIL_TEST)
     {
       glEnable(GL_STENCIL_TEST);
-      MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Context] Fail on enabling GL_STENCIL_TEST");
+      MGL_GL_CHECK("[GL Context] Fail on enabling GL_STENCIL_TEST");
     }
 
     if(flags & mgl::opengl::enable_flag::RASTERIZER_DISCARD)
     {
       glEnable(GL_RASTERIZER_DISCARD);
-      MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR,
-                      "[GL Context] Fail on enabling RASTERIZER_DISCARD");
+      MGL_GL_CHECK("[GL Context] Fail on enabling RASTERIZER_DISCARD");
     }
 
     if(flags & mgl::opengl::enable_flag::PROGRAM_POINT_SIZE)
     {
       glEnable(GL_PROGRAM_POINT_SIZE);
-      MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR,
-                      "[GL Context] Fail on enabling GL_PROGRAM_POINT_SIZE");
+      MGL_GL_CHECK("[GL Context] Fail on enabling GL_PROGRAM_POINT_SIZE");
     }
   }
 
@@ -495,40 +482,37 @@ namespace mgl::opengl
     if(flags & mgl::opengl::enable_flag::BLEND)
     {
       glDisable(GL_BLEND);
-      MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Context] Fail on disabling GL_BLEND");
+      MGL_GL_CHECK("[GL Context] Fail on disabling GL_BLEND");
     }
 
     if(flags & mgl::opengl::enable_flag::DEPTH_TEST)
     {
       glDisable(GL_DEPTH_TEST);
-      MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Context] Fail on disabling GL_DEPTH_TEST");
+      MGL_GL_CHECK("[GL Context] Fail on disabling GL_DEPTH_TEST");
     }
 
     if(flags & mgl::opengl::enable_flag::CULL_FACE)
     {
       glDisable(GL_CULL_FACE);
-      MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Context] Fail on disabling GL_CULL_FACE");
+      MGL_GL_CHECK("[GL Context] Fail on disabling GL_CULL_FACE");
     }
 
     if(flags & mgl::opengl::enable_flag::STENCIL_TEST)
     {
       glDisable(GL_STENCIL_TEST);
-      MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR,
-                      "[GL Context] Fail on disabling GL_STENCIL_TEST");
+      MGL_GL_CHECK("[GL Context] Fail on disabling GL_STENCIL_TEST");
     }
 
     if(flags & mgl::opengl::enable_flag::RASTERIZER_DISCARD)
     {
       glDisable(GL_RASTERIZER_DISCARD);
-      MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR,
-                      "[GL Context] Fail on disabling RASTERIZER_DISCARD");
+      MGL_GL_CHECK("[GL Context] Fail on disabling RASTERIZER_DISCARD");
     }
 
     if(flags & mgl::opengl::enable_flag::PROGRAM_POINT_SIZE)
     {
       glDisable(GL_PROGRAM_POINT_SIZE);
-      MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR,
-                      "[GL Context] Fail on disabling GL_PROGRAM_POINT_SIZE");
+      MGL_GL_CHECK("[GL Context] Fail on disabling GL_PROGRAM_POINT_SIZE");
     }
   }
 
@@ -537,7 +521,7 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(!released(), "[GL Context] Context already released or not valid.");
     MGL_CORE_ASSERT(is_current(), "[GL Context] Resource context not current.");
     glEnable(value);
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Context] Fail on enable_direct");
+    MGL_GL_CHECK("[GL Context] Fail on enable_direct");
   }
 
   void context::disable_direct(int32_t value)
@@ -545,7 +529,7 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(!released(), "[GL Context] Context already released or not valid.");
     MGL_CORE_ASSERT(is_current(), "[GL Context] Resource context not current.");
     glDisable(value);
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Context] Fail on disable_direct");
+    MGL_GL_CHECK("[GL Context] Fail on disable_direct");
   }
 
   void context::finish()
@@ -553,7 +537,17 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(!released(), "[GL Context] Context already released or not valid.");
     MGL_CORE_ASSERT(is_current(), "[GL Context] Resource context not current.");
     glFinish();
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Context] Fail on glFinish");
+    MGL_GL_CHECK("[GL Context] Fail on glFinish");
+  }
+
+  void context::require_barrier(uint32_t bits)
+  {
+    bits &= m_pending_barriers;
+    if(!bits)
+      return;
+
+    glMemoryBarrier(bits);
+    m_pending_barriers &= ~bits;
   }
 
   void context::clear_samplers(int32_t start, int32_t end)
@@ -573,10 +567,249 @@ namespace mgl::opengl
 
     for(int32_t i = start; i < end; i++)
     {
-      glBindSampler(i, 0);
+      bind_sampler(i, 0);
+    }
+  }
+
+  // Targets with a slot in the binding cache, the others are always bound
+  static int32_t texture_slot(int32_t target)
+  {
+    switch(target)
+    {
+      case GL_TEXTURE_2D: return 0;
+      case GL_TEXTURE_2D_MULTISAMPLE: return 1;
+      case GL_TEXTURE_3D: return 2;
+      case GL_TEXTURE_2D_ARRAY: return 3;
+      case GL_TEXTURE_CUBE_MAP: return 4;
+      default: return -1;
+    }
+  }
+
+  void context::bind_texture(int32_t unit, int32_t target, int32_t glo)
+  {
+    int32_t slot = texture_slot(target);
+    bool cached = slot != -1 && unit >= 0 && unit < m_max_texture_units;
+
+    if(cached && m_texture_bindings[unit][slot] == glo)
+      return;
+
+    if(m_active_texture_unit != unit)
+    {
+      glActiveTexture(GL_TEXTURE0 + unit);
+      m_active_texture_unit = unit;
+    }
+
+    glBindTexture(target, glo);
+
+    if(cached)
+      m_texture_bindings[unit][slot] = glo;
+  }
+
+  void context::select_texture(int32_t target, int32_t glo)
+  {
+    bind_texture(m_default_texture_unit, target, glo);
+
+    if(m_active_texture_unit != m_default_texture_unit)
+    {
+      glActiveTexture(GL_TEXTURE0 + m_default_texture_unit);
+      m_active_texture_unit = m_default_texture_unit;
     }
   }
 
+  void context::texture_parameter(int32_t target, int32_t glo, int32_t pname, int32_t value)
+  {
+    if(m_direct_state_access)
+    {
+      glTextureParameteri(glo, pname, value);
+      return;
+    }
+
+    select_texture(target, glo);
+    glTexParameteri(target, pname, value);
+  }
+
+  void context::texture_parameter(int32_t target, int32_t glo, int32_t pname, float value)
+  {
+    if(m_direct_state_access)
+    {
+      glTextureParameterf(glo, pname, value);
+      return;
+    }
+
+    select_texture(target, glo);
+    glTexParameterf(target, pname, value);
+  }
+
+  void context::forget_texture(int32_t glo)
+  {
+    for(auto&& unit : m_texture_bindings)
+    {
+      for(auto&& bound : unit)
+      {
+        if(bound == glo)
+          bound = 0;
+      }
+    }
+  }
+
+  void context::bind_sampler(int32_t unit, int32_t glo)
+  {
+    bool cached = unit >= 0 && unit < m_max_texture_units;
+
+    if(cached && m_sampler_bindings[unit] == glo)
+      return;
+
+    glBindSampler(unit, glo);
+
+    if(cached)
+      m_sampler_bindings[unit] = glo;
+  }
+
+  void context::forget_sampler(int32_t glo)
+  {
+    for(auto&& bound : m_sampler_bindings)
+    {
+      if(bound == glo)
+        bound = 0;
+    }
+  }
+
+  void context::reset_texture_bindings()
+  {
+    m_active_texture_unit = -1;
+
+    for(auto&& unit : m_texture_bindings)
+      unit.fill(-1);
+
+    std::fill(m_sampler_bindings.begin(), m_sampler_bindings.end(), -1);
+  }
+
+  static uint64_t buffer_slot(int32_t target, int32_t index)
+  {
+    return (uint64_t)(uint32_t)target << 32 | (uint32_t)index;
+  }
+
+  void context::bind_buffer_base(int32_t target, int32_t index, int32_t glo)
+  {
+    auto& bound = m_buffer_bindings.try_emplace(buffer_slot(target, index), -1).first->second;
+    if(bound == glo)
+      return;
+
+    glBindBufferBase(target, index, glo);
+    bound = glo;
+  }
+
+  void context::bind_buffer_range(
+      int32_t target, int32_t index, int32_t glo, size_t offset, size_t size)
+  {
+    glBindBufferRange(target, index, glo, offset, size);
+    m_buffer_bindings.insert_or_assign(buffer_slot(target, index), -1);
+  }
+
+  void context::forget_buffer(int32_t glo)
+  {
+    for(auto&& [slot, bound] : m_buffer_bindings)
+    {
+      if(bound == glo)
+        bound = 0;
+    }
+  }
+
+  void context::reset_buffer_bindings()
+  {
+    m_buffer_bindings.clear();
+  }
+
+  // A negative size is never applied, it marks the tracked rectangle as unknown
+  static const mgl::rect s_unknown_rect = { 0, 0, -1, -1 };
+
+  void context::reset_framebuffer_state()
+  {
+    m_draw_framebuffer = -1;
+    m_read_framebuffer = -1;
+    m_current_viewport = s_unknown_rect;
+    m_scissor_test = -1;
+    m_current_scissor = s_unknown_rect;
+    m_depth_write = -1;
+    std::fill(m_color_mask_bits.begin(), m_color_mask_bits.end(), -1);
+  }
+
+  void context::bind_draw_framebuffer(int32_t glo)
+  {
+    if(m_draw_framebuffer == glo)
+      return;
+
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, glo);
+    m_draw_framebuffer = glo;
+  }
+
+  void context::bind_read_framebuffer(int32_t glo)
+  {
+    if(m_read_framebuffer == glo)
+      return;
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, glo);
+    m_read_framebuffer = glo;
+  }
+
+  void context::forget_framebuffer(int32_t glo)
+  {
+    // Deleting a bound framebuffer reverts the binding to the default one
+    if(m_draw_framebuffer == glo)
+      m_draw_framebuffer = 0;
+
+    if(m_read_framebuffer == glo)
+      m_read_framebuffer = 0;
+  }
+
+  void context::apply_viewport(const mgl::rect& r)
+  {
+    if(m_current_viewport == r)
+      return;
+
+    glViewport(r.x, r.y, r.width, r.height);
+    m_current_viewport = r;
+  }
+
+  void context::apply_scissor(bool enabled, const mgl::rect& r)
+  {
+    if(m_scissor_test != enabled)
+    {
+      enabled ? glEnable(GL_SCISSOR_TEST) : glDisable(GL_SCISSOR_TEST);
+      m_scissor_test = enabled;
+    }
+
+    // The rectangle is kept while the test is off
+    if(!enabled || m_current_scissor == r)
+      return;
+
+    glScissor(r.x, r.y, r.width, r.height);
+    m_current_scissor = r;
+  }
+
+  void context::apply_color_mask(int32_t index, const color_mask& mask)
+  {
+    int32_t bits = mask.r | mask.g << 1 | mask.b << 2 | mask.a << 3;
+    bool cached = index >= 0 && index < m_color_mask_bits.size();
+
+    if(cached && m_color_mask_bits[index] == bits)
+      return;
+
+    glColorMaski(index, mask.r, mask.g, mask.b, mask.a);
+
+    if(cached)
+      m_color_mask_bits[index] = bits;
+  }
+
+  void context::apply_depth_mask(bool value)
+  {
+    if(m_depth_write == value)
+      return;
+
+    glDepthMask(value);
+    m_depth_write = value;
+  }
+
   void context::clear(const glm::vec4& color, float depth, const mgl::rect& viewport)
   {
     MGL_CORE_ASSERT(!released(), "[GL Context] Context already released or not valid.");
@@ -596,7 +829,7 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(!released(), "[GL Context] Context already released or not valid.");
     MGL_CORE_ASSERT(is_current(), "[GL Context] Resource context not current.");
     glBlendEquationSeparate(modeRGB, modeAlpha);
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Context] Fail on glBlendEquationSeparate");
+    MGL_GL_CHECK("[GL Context] Fail on glBlendEquationSeparate");
   }
 
   void context::set_blend_func(blend_factor srcRGB,
@@ -607,7 +840,7 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(!released(), "[GL Context] Context already released or not valid.");
     MGL_CORE_ASSERT(is_current(), "[GL Context] Resource context not current.");
     glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Context] Fail on glBlendFuncSeparate");
+    MGL_GL_CHECK("[GL Context] Fail on glBlendFuncSeparate");
   }
 
 } // namespace  mgl::opengl
@@ -177,6 +177,8 @@ namespace mgl::opengl
     if(!m_context)
       return;
 
+    clear_caches();
+
     auto self = (CGLContextData*)m_context;
     CGLSetCurrentContext(nullptr);
     CGLDestroyContext(self->ctx);
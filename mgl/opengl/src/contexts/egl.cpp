@@ -329,6 +329,8 @@ namespace mgl::opengl
     if(!m_context)
       return;
 
+    clear_caches();
+
     auto self = (EGLContextData*)m_context;
     eglDestroyContext(self->dpy, self->ctx);
     m_released = true;
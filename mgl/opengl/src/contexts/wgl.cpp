@@ -265,6 +265,8 @@ namespace mgl::opengl
     if(!m_context)
       return;
 
+    clear_caches();
+
     auto self = (WGLContextData*)m_context;
 
     if(self->ctx)
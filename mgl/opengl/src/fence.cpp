@@ -0,0 +1,46 @@
+#include "mgl_opengl/fence.hpp"
+#include "mgl_opengl/context.hpp"
+
+#include "mgl_core/debug.hpp"
+
+#include "glad/gl.h"
+
+namespace mgl::opengl
+{
+  fence::fence(const context_ref& ctx)
+      : m_ctx(ctx)
+      , m_sync(nullptr)
+  {
+    m_sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    MGL_CORE_ASSERT(m_sync, "[Fence] Error creating sync object.");
+  }
+
+  void fence::release()
+  {
+    MGL_CORE_ASSERT(!released(), "[Fence] Resource already released or not valid.");
+    MGL_CORE_ASSERT(m_ctx->is_current(), "[Fence] Resource context not current.");
+    glDeleteSync((GLsync)m_sync);
+    m_sync = nullptr;
+  }
+
+  bool fence::signaled()
+  {
+    MGL_CORE_ASSERT(!released(), "[Fence] Resource already released or not valid.");
+    MGL_CORE_ASSERT(m_ctx->is_current(), "[Fence] Resource context not current.");
+    GLint status = GL_UNSIGNALED;
+    glGetSynciv((GLsync)m_sync, GL_SYNC_STATUS, sizeof(status), nullptr, &status);
+    return status == GL_SIGNALED;
+  }
+
+  bool fence::wait(uint64_t timeout)
+  {
+    MGL_CORE_ASSERT(!released(), "[Fence] Resource already released or not valid.");
+    MGL_CORE_ASSERT(m_ctx->is_current(), "[Fence] Resource context not current.");
+
+    // The flush bit guarantees the fence reaches the GPU, otherwise the wait could never end.
+    GLenum result = glClientWaitSync((GLsync)m_sync, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+    MGL_CORE_ASSERT(result != GL_WAIT_FAILED, "[Fence] Error waiting on sync object.");
+    return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+  }
+
+} // namespace  mgl::opengl
@@ -76,8 +76,7 @@ namespace mgl::opengl
     m_height = scissor_box[3];
     m_dynamic = true;
 
-    // clear any errors
-    glGetError();
+    internal::discard_errors();
   }
 
   framebuffer::framebuffer(const context_ref& ctx,
@@ -103,7 +102,7 @@ namespace mgl::opengl
     }
 
     gl_object::set_glo(glo);
-    glBindFramebuffer(GL_FRAMEBUFFER, gl_object::glo());
+    gl_object::ctx()->bind_draw_framebuffer(glo);
 
     if(!color_attachments.size())
     {
@@ -153,7 +152,7 @@ namespace mgl::opengl
         switch(attachment->attachment_type())
         {
           case attachment::type::TEXTURE: {
-            glFramebufferTexture2D(GL_FRAMEBUFFER,
+            glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER,
                                    draw_buffer,
                                    attachment->samples() ? GL_TEXTURE_2D_MULTISAMPLE
                                                          : GL_TEXTURE_2D,
@@ -163,7 +162,7 @@ namespace mgl::opengl
           break;
           case attachment::type::RENDERBUFFER: {
             glFramebufferRenderbuffer(
-                GL_FRAMEBUFFER, draw_buffer, GL_RENDERBUFFER, attachment->glo());
+                GL_DRAW_FRAMEBUFFER, draw_buffer, GL_RENDERBUFFER, attachment->glo());
           }
           break;
           default: MGL_CORE_ASSERT(false, "[Framebuffer] Invalid attachment type."); return;
@@ -172,8 +171,11 @@ namespace mgl::opengl
         i++;
       }
 
-      // clear any errors
-      glGetError();
+      // Draw buffers belong to the framebuffer object, they only need to be set once
+      if(m_draw_buffers.size() > 1)
+        glDrawBuffers(m_draw_buffers.size(), m_draw_buffers.data());
+
+      MGL_GL_CHECK("[Framebuffer] Error on creating framebuffer.");
     }
 
     if(depth_attachment)
@@ -202,7 +204,7 @@ namespace mgl::opengl
       switch(depth_attachment->attachment_type())
       {
         case attachment::type::TEXTURE: {
-          glFramebufferTexture2D(GL_FRAMEBUFFER,
+          glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER,
                                  GL_DEPTH_ATTACHMENT,
                                  depth_attachment->samples() ? GL_TEXTURE_2D_MULTISAMPLE
                                                              : GL_TEXTURE_2D,
@@ -212,7 +214,7 @@ namespace mgl::opengl
         break;
         case attachment::type::RENDERBUFFER: {
           glFramebufferRenderbuffer(
-              GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth_attachment->glo());
+              GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth_attachment->glo());
         }
         break;
         default: MGL_CORE_ASSERT(false, "[Framebuffer] Invalid attachment. type"); return;
@@ -234,12 +236,12 @@ namespace mgl::opengl
     m_samples = samples;
 
 #ifdef MGL_CORE_ENABLE_ASSERTS
-    int32_t status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    int32_t status = glCheckFramebufferStatus(GL_DRAW_FRAMEBUFFER);
     MGL_CORE_ASSERT(status == GL_FRAMEBUFFER_COMPLETE,
                     "[Framebuffer] Framebuffer is not complete.");
 #endif
 
-    glBindFramebuffer(GL_FRAMEBUFFER, gl_object::ctx()->m_bound_framebuffer->glo());
+    gl_object::ctx()->bind_draw_framebuffer(gl_object::ctx()->m_bound_framebuffer->glo());
   }
 
   void framebuffer::release()
@@ -249,6 +251,7 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Framebuffer] Resource context not current.");
     GLuint glo = gl_object::glo();
     glDeleteFramebuffers(1, &glo);
+    gl_object::ctx()->forget_framebuffer(glo);
     m_draw_buffers.clear();
     gl_object::set_glo(GL_ZERO);
   }
@@ -259,57 +262,64 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(!m_dynamic && !gl_object::released() || m_dynamic,
                     "[Framebuffer] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Framebuffer] Resource context not current.");
-    glBindFramebuffer(GL_FRAMEBUFFER, gl_object::glo());
-
-    if(m_dynamic)
-    {
-      glDrawBuffers(m_draw_buffers.size(), m_draw_buffers.data());
-    }
-
-    glClearColor(r, g, b, a);
-    glClearDepth(depth);
+    auto& ctx = gl_object::ctx();
 
+    // Clears honour the write masks and the scissor, not the viewport
     for(int32_t i = 0; i < m_color_masks.size(); ++i)
     {
-      glColorMaski(
-          i, m_color_masks[i].r, m_color_masks[i].g, m_color_masks[i].b, m_color_masks[i].a);
+      ctx->apply_color_mask(i, m_color_masks[i]);
     }
 
-    glDepthMask(m_depth_mask);
+    ctx->apply_depth_mask(m_depth_mask);
 
     // Respect the passed in viewport even with scissor enabled
     if(viewport != mgl::null_viewport_2d)
     {
-      glEnable(GL_SCISSOR_TEST);
-      glScissor(viewport.x, viewport.y, viewport.width, viewport.height);
-      glClear(GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
+      ctx->apply_scissor(true, viewport);
+    }
+    else
+    {
+      ctx->apply_scissor(m_scissor_enabled, m_scissor);
+    }
+
+    const float color[4] = { r, g, b, a };
+
+    // Attachments may have just been written by a dispatch through image stores
+    ctx->require_barrier(barrier_bit::FRAMEBUFFER_BARRIER);
 
-      // restore scissor if enabled
-      if(m_scissor_enabled)
+    if(ctx->m_direct_state_access)
+    {
+      for(int32_t i = 0; i < m_draw_buffers.size(); ++i)
       {
-        glScissor(m_scissor.x, m_scissor.y, m_scissor.width, m_scissor.height);
+        glClearNamedFramebufferfv(gl_object::glo(), GL_COLOR, i, color);
       }
-      else
+
+      if(m_depth_mask)
       {
-        glDisable(GL_SCISSOR_TEST);
+        glClearNamedFramebufferfv(gl_object::glo(), GL_DEPTH, 0, &depth);
       }
     }
     else
     {
-      // clear with scissor if enabled
-      if(m_scissor_enabled)
+      ctx->bind_draw_framebuffer(gl_object::glo());
+
+      for(int32_t i = 0; i < m_draw_buffers.size(); ++i)
+      {
+        glClearBufferfv(GL_COLOR, i, color);
+      }
+
+      if(m_depth_mask)
       {
-        glEnable(GL_SCISSOR_TEST);
-        glScissor(m_scissor.x, m_scissor.y, m_scissor.width, m_scissor.height);
+        glClearBufferfv(GL_DEPTH, 0, &depth);
       }
 
-      glClear(GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
+      ctx->bind_draw_framebuffer(ctx->m_bound_framebuffer->glo());
     }
 
-    glBindFramebuffer(GL_FRAMEBUFFER, gl_object::ctx()->m_bound_framebuffer->glo());
+    // Only what the clear changed is put back
+    ctx->m_bound_framebuffer->apply_state();
 
-    // clear any errors
-    glGetError();
+    MGL_GL_CHECK("[Framebuffer] Error on clearing framebuffer.");
   }
 
   void framebuffer::use()
@@ -317,37 +327,37 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(!m_dynamic && !gl_object::released() || m_dynamic,
                     "[Framebuffer] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Framebuffer] Resource context not current.");
-    glBindFramebuffer(GL_FRAMEBUFFER, gl_object::glo());
+    auto& ctx = gl_object::ctx();
 
-    if(m_dynamic)
+    if(ctx->m_draw_framebuffer != gl_object::glo())
     {
-      glDrawBuffers(m_draw_buffers.size(), m_draw_buffers.data());
+      ctx->bind_draw_framebuffer(gl_object::glo());
+
+      if(m_dynamic)
+      {
+        glDrawBuffers(m_draw_buffers.size(), m_draw_buffers.data());
+      }
     }
 
-    glViewport(m_viewport.x, m_viewport.y, m_viewport.width, m_viewport.height);
+    apply_state();
 
-    if(m_scissor_enabled)
-    {
-      glEnable(GL_SCISSOR_TEST);
-      glScissor(m_scissor.x, m_scissor.y, m_scissor.width, m_scissor.height);
-    }
-    else
-    {
-      glDisable(GL_SCISSOR_TEST);
-    }
+    ctx->m_bound_framebuffer = shared_from_this();
+
+    MGL_GL_CHECK("[Framebuffer] Error on using framebuffer.");
+  }
+
+  void framebuffer::apply_state()
+  {
+    auto& ctx = gl_object::ctx();
+    ctx->apply_viewport(m_viewport);
+    ctx->apply_scissor(m_scissor_enabled, m_scissor);
 
     for(int32_t i = 0; i < m_color_masks.size(); ++i)
     {
-      glColorMaski(
-          i, m_color_masks[i].r, m_color_masks[i].g, m_color_masks[i].b, m_color_masks[i].a);
+      ctx->apply_color_mask(i, m_color_masks[i]);
     }
 
-    glDepthMask(m_depth_mask);
-
-    gl_object::ctx()->m_bound_framebuffer = shared_from_this();
-
-    // clear any error
-    glGetError();
+    ctx->apply_depth_mask(m_depth_mask);
   }
 
   void framebuffer::read(mgl::uint8_buffer& dst,
@@ -398,12 +408,12 @@ namespace mgl::opengl
 
     char* ptr = (char*)dst.data() + dst_off;
 
-    glBindFramebuffer(GL_FRAMEBUFFER, gl_object::glo());
+    gl_object::ctx()->require_barrier(barrier_bit::FRAMEBUFFER_BARRIER);
+    gl_object::ctx()->bind_read_framebuffer(gl_object::glo());
     glReadBuffer(read_depth ? GL_NONE : (GL_COLOR_ATTACHMENT0 + attachment));
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
     glReadPixels(view.x, view.y, view.width, view.height, base_format, pixel_type, ptr);
-    glBindFramebuffer(GL_FRAMEBUFFER, gl_object::ctx()->m_bound_framebuffer->glo());
   }
 
   void framebuffer::read(buffer_ref dst,
@@ -447,12 +457,13 @@ namespace mgl::opengl
     int32_t base_format = read_depth ? GL_DEPTH_COMPONENT : data_type->base_format[components];
 
     glBindBuffer(GL_PIXEL_PACK_BUFFER, dst->glo());
-    glBindFramebuffer(GL_FRAMEBUFFER, gl_object::glo());
+    gl_object::ctx()->require_barrier(
+        barrier_bit::FRAMEBUFFER_BARRIER | barrier_bit::PIXEL_BUFFER_BARRIER);
+    gl_object::ctx()->bind_read_framebuffer(gl_object::glo());
     glReadBuffer(read_depth ? GL_NONE : (GL_COLOR_ATTACHMENT0 + attachment));
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
     glReadPixels(view.x, view.y, view.width, view.height, base_format, pixel_type, (void*)dst_off);
-    glBindFramebuffer(GL_FRAMEBUFFER, gl_object::ctx()->m_bound_framebuffer->glo());
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
   }
 
@@ -468,7 +479,7 @@ namespace mgl::opengl
     }
 
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Framebuffer] Resource context not current.");
-    glColorMask(mask.r, mask.g, mask.b, mask.a);
+    gl_object::ctx()->apply_color_mask(0, mask);
   }
 
   void framebuffer::set_color_mask(const color_masks& masks)
@@ -485,8 +496,7 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Framebuffer] Resource context not current.");
     for(int32_t i = 0; i < m_color_masks.size(); ++i)
     {
-      glColorMaski(
-          i, m_color_masks[i].r, m_color_masks[i].g, m_color_masks[i].b, m_color_masks[i].a);
+      gl_object::ctx()->apply_color_mask(i, m_color_masks[i]);
     }
   }
 
@@ -500,7 +510,7 @@ namespace mgl::opengl
     }
 
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Framebuffer] Resource context not current.");
-    glDepthMask(m_depth_mask);
+    gl_object::ctx()->apply_depth_mask(m_depth_mask);
   }
 
   void framebuffer::bits(int32_t& red_bits,
@@ -513,21 +523,20 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(!m_dynamic && !gl_object::released() || m_dynamic,
                     "[Framebuffer] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Framebuffer] Resource context not current.");
-    glBindFramebuffer(GL_FRAMEBUFFER, gl_object::glo());
+    gl_object::ctx()->bind_read_framebuffer(gl_object::glo());
     glGetFramebufferAttachmentParameteriv(
-        GL_FRAMEBUFFER, GL_BACK_LEFT, GL_FRAMEBUFFER_ATTACHMENT_RED_SIZE, &red_bits);
+        GL_READ_FRAMEBUFFER, GL_BACK_LEFT, GL_FRAMEBUFFER_ATTACHMENT_RED_SIZE, &red_bits);
     glGetFramebufferAttachmentParameteriv(
-        GL_FRAMEBUFFER, GL_BACK_LEFT, GL_FRAMEBUFFER_ATTACHMENT_GREEN_SIZE, &green_bits);
+        GL_READ_FRAMEBUFFER, GL_BACK_LEFT, GL_FRAMEBUFFER_ATTACHMENT_GREEN_SIZE, &green_bits);
     glGetFramebufferAttachmentParameteriv(
-        GL_FRAMEBUFFER, GL_BACK_LEFT, GL_FRAMEBUFFER_ATTACHMENT_BLUE_SIZE, &blue_bits);
+        GL_READ_FRAMEBUFFER, GL_BACK_LEFT, GL_FRAMEBUFFER_ATTACHMENT_BLUE_SIZE, &blue_bits);
     glGetFramebufferAttachmentParameteriv(
-        GL_FRAMEBUFFER, GL_BACK_LEFT, GL_FRAMEBUFFER_ATTACHMENT_ALPHA_SIZE, &alpha_bits);
+        GL_READ_FRAMEBUFFER, GL_BACK_LEFT, GL_FRAMEBUFFER_ATTACHMENT_ALPHA_SIZE, &alpha_bits);
     glGetFramebufferAttachmentParameteriv(
-        GL_FRAMEBUFFER, GL_DEPTH, GL_FRAMEBUFFER_ATTACHMENT_DEPTH_SIZE, &depth_bits);
+        GL_READ_FRAMEBUFFER, GL_DEPTH, GL_FRAMEBUFFER_ATTACHMENT_DEPTH_SIZE, &depth_bits);
     glGetFramebufferAttachmentParameteriv(
-        GL_FRAMEBUFFER, GL_STENCIL, GL_FRAMEBUFFER_ATTACHMENT_STENCIL_SIZE, &stencil_bits);
-    glBindFramebuffer(GL_FRAMEBUFFER, gl_object::ctx()->m_bound_framebuffer->glo());
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "OpenGL error");
+        GL_READ_FRAMEBUFFER, GL_STENCIL, GL_FRAMEBUFFER_ATTACHMENT_STENCIL_SIZE, &stencil_bits);
+    MGL_GL_CHECK("[Framebuffer] Error on reading the framebuffer bits.");
   }
 
   void framebuffer::set_viewport(const mgl::rect& r)
@@ -540,7 +549,7 @@ namespace mgl::opengl
     }
 
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Framebuffer] Resource context not current.");
-    glViewport(m_viewport.x, m_viewport.y, m_viewport.width, m_viewport.height);
+    gl_object::ctx()->apply_viewport(m_viewport);
   }
 
   void framebuffer::set_scissor(const mgl::rect& r)
@@ -553,7 +562,33 @@ namespace mgl::opengl
     }
 
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Framebuffer] Resource context not current.");
-    glScissor(m_scissor.x, m_scissor.y, m_scissor.width, m_scissor.height);
+    gl_object::ctx()->apply_scissor(m_scissor_enabled, m_scissor);
+  }
+
+  void framebuffer::enable_scissor()
+  {
+    m_scissor_enabled = true;
+
+    if(gl_object::ctx()->m_bound_framebuffer.get() != this)
+    {
+      return;
+    }
+
+    MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Framebuffer] Resource context not current.");
+    gl_object::ctx()->apply_scissor(m_scissor_enabled, m_scissor);
+  }
+
+  void framebuffer::disable_scissor()
+  {
+    m_scissor_enabled = false;
+
+    if(gl_object::ctx()->m_bound_framebuffer.get() != this)
+    {
+      return;
+    }
+
+    MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Framebuffer] Resource context not current.");
+    gl_object::ctx()->apply_scissor(m_scissor_enabled, m_scissor);
   }
 
 } // namespace  mgl::opengl
@@ -400,7 +400,7 @@ namespace mgl::opengl
         }
       }
     }
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[Program] Error on creating program.");
+    MGL_GL_CHECK("[Program] Error on creating program.");
   }
 
   void program::release()
@@ -416,7 +416,7 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(!gl_object::released(), "[Program] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Program] Resource context not current.");
     glUseProgram(gl_object::glo());
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[Program] Error on binding program.");
+    MGL_GL_CHECK("[Program] Error on binding program.");
   }
 
   void program::unbind()
@@ -120,6 +120,20 @@ namespace mgl::opengl
     glEndConditionalRender();
   }
 
+  void query::release()
+  {
+    MGL_CORE_ASSERT(!released(), "[Query] Resource already released or not valid.");
+    MGL_CORE_ASSERT(m_ctx->is_current(), "[Query] Resource context not current.");
+    for(int32_t i = 0; i < query::keys::COUNT; i++)
+    {
+      if(m_glo[i])
+      {
+        glDeleteQueries(1, (GLuint*)&m_glo[i]);
+        m_glo[i] = 0;
+      }
+    }
+  }
+
   int query::samples()
   {
     MGL_CORE_ASSERT(m_glo[query::keys::SAMPLES_PASSED], "[Query] No samples query.");
@@ -147,4 +161,178 @@ namespace mgl::opengl
     return elapsed;
   }
 
+  static uint32_t occlusion_glo(const int32_t* glo)
+  {
+    if(glo[query::keys::ANY_SAMPLES_PASSED])
+      return glo[query::keys::ANY_SAMPLES_PASSED];
+
+    return glo[query::keys::SAMPLES_PASSED];
+  }
+
+  bool query::ready()
+  {
+    MGL_CORE_ASSERT(m_ctx->is_current(), "[Query] Resource context not current.");
+    auto glo = occlusion_glo(m_glo);
+    MGL_CORE_ASSERT(glo, "[Query] No samples query.");
+    GLuint available = GL_FALSE;
+    glGetQueryObjectuiv(glo, GL_QUERY_RESULT_AVAILABLE, &available);
+    return available == GL_TRUE;
+  }
+
+  bool query::any_samples()
+  {
+    MGL_CORE_ASSERT(m_ctx->is_current(), "[Query] Resource context not current.");
+    auto glo = occlusion_glo(m_glo);
+    MGL_CORE_ASSERT(glo, "[Query] No samples query.");
+    GLuint samples = 0;
+    glGetQueryObjectuiv(glo, GL_QUERY_RESULT, &samples);
+    return samples > 0;
+  }
+
+  static int32_t query_target(query::keys kind)
+  {
+    switch(kind)
+    {
+      case query::keys::SAMPLES_PASSED: return GL_SAMPLES_PASSED;
+      case query::keys::ANY_SAMPLES_PASSED: return GL_ANY_SAMPLES_PASSED;
+      case query::keys::TIME_ELAPSED: return GL_TIME_ELAPSED;
+      case query::keys::PRIMITIVES_GENERATED: return GL_PRIMITIVES_GENERATED;
+      default: MGL_CORE_ASSERT(false, "[Query] Invalid query kind."); return GL_NONE;
+    }
+  }
+
+  static uint64_t result_key(query::keys kind, int32_t id)
+  {
+    return (uint64_t)kind << 32 | (uint32_t)id;
+  }
+
+  query_pool::query_pool(int32_t frames, bool no_wait)
+      : m_current(0)
+      , m_no_wait(no_wait)
+      , m_dropped(0)
+  {
+    // With a single frame the last chance collect would run on the frame just submitted
+    MGL_CORE_ASSERT(frames >= 2, "[Query] A query pool needs at least two frames.");
+    m_frames.resize(frames);
+
+    for(auto&& active : m_active)
+      active = { query::keys::COUNT, 0, 0 };
+  }
+
+  void query_pool::begin(query::keys kind, int32_t id)
+  {
+    MGL_CORE_ASSERT(kind >= 0 && kind < query::keys::COUNT, "[Query] Invalid query kind.");
+    MGL_CORE_ASSERT(m_active[kind].glo == 0, "[Query] A query of this kind is already active.");
+    auto& f = m_frames[m_current];
+    auto& queries = f.queries[kind];
+
+    // Objects are only created the first time a frame needs more than before
+    if(f.used[kind] == queries.size())
+    {
+      GLuint glo = 0;
+      glGenQueries(1, &glo);
+      queries.push_back(glo);
+    }
+
+    uint32_t glo = queries[f.used[kind]++];
+    glBeginQuery(query_target(kind), glo);
+    m_active[kind] = { kind, id, glo };
+  }
+
+  void query_pool::end(query::keys kind)
+  {
+    MGL_CORE_ASSERT(kind >= 0 && kind < query::keys::COUNT, "[Query] Invalid query kind.");
+    MGL_CORE_ASSERT(m_active[kind].glo != 0, "[Query] No query of this kind is active.");
+    glEndQuery(query_target(kind));
+    m_frames[m_current].pending.push_back(m_active[kind]);
+    m_active[kind].glo = 0;
+  }
+
+  void query_pool::next_frame()
+  {
+    m_current = (m_current + 1) % m_frames.size();
+
+    // The frame being recycled is the oldest, it is collected first so a newer result always
+    // overwrites an older one. The frame just submitted is left for the next call.
+    auto& f = m_frames[m_current];
+    collect(f, true);
+
+    for(int32_t i = 1; i + 1 < m_frames.size(); i++)
+      collect(m_frames[(m_current + i) % m_frames.size()], false);
+
+    for(auto&& used : f.used)
+      used = 0;
+  }
+
+  bool query_pool::result(query::keys kind, int32_t id, uint64_t& value) const
+  {
+    auto it = m_results.find(result_key(kind, id));
+    if(it == m_results.end())
+      return false;
+
+    value = it->second;
+    return true;
+  }
+
+  void query_pool::release()
+  {
+    for(auto&& f : m_frames)
+    {
+      for(auto&& queries : f.queries)
+      {
+        if(queries.size())
+          glDeleteQueries(queries.size(), queries.data());
+
+        queries.clear();
+      }
+
+      for(auto&& used : f.used)
+        used = 0;
+
+      f.pending.clear();
+    }
+
+    for(auto&& active : m_active)
+      active.glo = 0;
+  }
+
+  void query_pool::collect(frame& f, bool last_chance)
+  {
+    // Queries complete in submission order, polling stops at the first one still running
+    size_t ready = 0;
+    for(; ready < f.pending.size(); ready++)
+    {
+      auto& p = f.pending[ready];
+      uint64_t value = UINT64_MAX;
+
+      if(m_no_wait)
+      {
+        // Left untouched while the result is not available
+        glGetQueryObjectui64v(p.glo, GL_QUERY_RESULT_NO_WAIT, &value);
+        if(value == UINT64_MAX)
+          break;
+      }
+      else
+      {
+        GLuint available = GL_FALSE;
+        glGetQueryObjectuiv(p.glo, GL_QUERY_RESULT_AVAILABLE, &available);
+        if(!available)
+          break;
+
+        glGetQueryObjectui64v(p.glo, GL_QUERY_RESULT, &value);
+      }
+
+      m_results.insert_or_assign(result_key(p.kind, p.id), value);
+    }
+
+    if(last_chance)
+    {
+      m_dropped += f.pending.size() - ready;
+      f.pending.clear();
+      return;
+    }
+
+    f.pending.erase(f.pending.begin(), f.pending.begin() + ready);
+  }
+
 } // namespace  mgl::opengl
@@ -3,6 +3,7 @@
 
 #include "mgl_core/debug.hpp"
 #include "mgl_core/math.hpp"
+#include "mgl_core/utils.hpp"
 
 #include "mgl_opengl_internal.hpp"
 
@@ -10,22 +11,32 @@
 
 namespace mgl::opengl
 {
+  size_t sampler::state_hash::operator()(const state& s) const
+  {
+    size_t seed = 0;
+    mgl::hash_combine(seed, s.min_filter);
+    mgl::hash_combine(seed, s.mag_filter);
+    mgl::hash_combine(seed, static_cast<int>(s.wrap_x));
+    mgl::hash_combine(seed, static_cast<int>(s.wrap_y));
+    mgl::hash_combine(seed, static_cast<int>(s.wrap_z));
+    mgl::hash_combine(seed, static_cast<int>(s.compare_func));
+    mgl::hash_combine(seed, s.anisotropy);
+    mgl::hash_combine(seed, s.min_lod);
+    mgl::hash_combine(seed, s.max_lod);
+    for(int i = 0; i < 4; i++)
+      mgl::hash_combine(seed, s.border_color[i]);
+    return seed;
+  }
+
   sampler::sampler(const context_ref& ctx)
+      : sampler(ctx, state(), false)
+  { }
+
+  sampler::sampler(const context_ref& ctx, const state& state, bool immutable)
       : gl_object(ctx)
+      , m_state(state)
+      , m_immutable(immutable)
   {
-    m_filter = { GL_LINEAR, GL_LINEAR };
-    m_anisotropy = 0.0;
-    m_repeat_x = true;
-    m_repeat_y = true;
-    m_repeat_z = true;
-    m_compare_func = mgl::opengl::compare_func::NONE;
-    m_border_color[0] = 0.0;
-    m_border_color[1] = 0.0;
-    m_border_color[2] = 0.0;
-    m_border_color[3] = 0.0;
-    m_min_lod = -1000.0;
-    m_max_lod = 1000.0;
-
     GLuint glo = 0;
     glGenSamplers(1, &glo);
 
@@ -36,6 +47,25 @@ namespace mgl::opengl
     }
 
     gl_object::set_glo(glo);
+
+    // The whole state is applied once, the reported parameters always match the object
+    glSamplerParameteri(glo, GL_TEXTURE_MIN_FILTER, m_state.min_filter);
+    glSamplerParameteri(glo, GL_TEXTURE_MAG_FILTER, m_state.mag_filter);
+    glSamplerParameteri(glo, GL_TEXTURE_WRAP_S, m_state.wrap_x);
+    glSamplerParameteri(glo, GL_TEXTURE_WRAP_T, m_state.wrap_y);
+    glSamplerParameteri(glo, GL_TEXTURE_WRAP_R, m_state.wrap_z);
+    glSamplerParameterf(glo, GL_TEXTURE_MIN_LOD, m_state.min_lod);
+    glSamplerParameterf(glo, GL_TEXTURE_MAX_LOD, m_state.max_lod);
+    glSamplerParameterfv(glo, GL_TEXTURE_BORDER_COLOR, (GLfloat*)&m_state.border_color);
+
+    if(m_state.compare_func != mgl::opengl::compare_func::NONE)
+    {
+      glSamplerParameteri(glo, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+      glSamplerParameteri(glo, GL_TEXTURE_COMPARE_FUNC, m_state.compare_func);
+    }
+
+    if(ctx->max_anisotropy() > 0 && m_state.anisotropy > 1.0f)
+      glSamplerParameterf(glo, GL_TEXTURE_MAX_ANISOTROPY, m_state.anisotropy);
   }
 
   void sampler::release()
@@ -44,6 +74,7 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Sampler] Resource context not current.");
     GLuint glo = gl_object::glo();
     glDeleteSamplers(1, &glo);
+    gl_object::ctx()->forget_sampler(glo);
     gl_object::set_glo(GL_ZERO);
   }
 
@@ -51,126 +82,150 @@ namespace mgl::opengl
   {
     MGL_CORE_ASSERT(!gl_object::released(), "[Sampler] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Sampler] Resource context not current.");
-    glBindSampler(index, gl_object::glo());
+    gl_object::ctx()->bind_sampler(index, gl_object::glo());
   }
 
   void sampler::clear(int index)
   {
     MGL_CORE_ASSERT(!gl_object::released(), "[Sampler] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Sampler] Resource context not current.");
-    glBindSampler(index, 0);
+    gl_object::ctx()->bind_sampler(index, 0);
   }
 
   void sampler::set_repeat_x(bool value)
   {
     MGL_CORE_ASSERT(!gl_object::released(), "[Sampler] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Sampler] Resource context not current.");
-    m_repeat_x = value;
-
-    if(value)
-    {
-      glSamplerParameteri(gl_object::glo(), GL_TEXTURE_WRAP_S, GL_REPEAT);
-      return;
-    }
-
-    glSamplerParameteri(gl_object::glo(), GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    MGL_CORE_ASSERT(!m_immutable, "[Sampler] Cached samplers are immutable.");
+    m_state.wrap_x = value ? wrap_mode::REPEAT : wrap_mode::CLAMP_TO_EDGE;
+    glSamplerParameteri(gl_object::glo(), GL_TEXTURE_WRAP_S, m_state.wrap_x);
   }
 
   void sampler::set_repeat_y(bool value)
   {
     MGL_CORE_ASSERT(!gl_object::released(), "[Sampler] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Sampler] Resource context not current.");
-    m_repeat_y = value;
-
-    if(value)
-    {
-      glSamplerParameteri(gl_object::glo(), GL_TEXTURE_WRAP_T, GL_REPEAT);
-      return;
-    }
-
-    glSamplerParameteri(gl_object::glo(), GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    MGL_CORE_ASSERT(!m_immutable, "[Sampler] Cached samplers are immutable.");
+    m_state.wrap_y = value ? wrap_mode::REPEAT : wrap_mode::CLAMP_TO_EDGE;
+    glSamplerParameteri(gl_object::glo(), GL_TEXTURE_WRAP_T, m_state.wrap_y);
   }
 
   void sampler::set_repeat_z(bool value)
   {
     MGL_CORE_ASSERT(!gl_object::released(), "[Sampler] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Sampler] Resource context not current.");
-    m_repeat_z = value;
-
-    if(value)
-    {
-      glSamplerParameteri(gl_object::glo(), GL_TEXTURE_WRAP_R, GL_REPEAT);
-      return;
-    }
-
-    glSamplerParameteri(gl_object::glo(), GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    MGL_CORE_ASSERT(!m_immutable, "[Sampler] Cached samplers are immutable.");
+    m_state.wrap_z = value ? wrap_mode::REPEAT : wrap_mode::CLAMP_TO_EDGE;
+    glSamplerParameteri(gl_object::glo(), GL_TEXTURE_WRAP_R, m_state.wrap_z);
   }
 
   void sampler::set_filter(const sampler::filter& value)
   {
     MGL_CORE_ASSERT(!gl_object::released(), "[Sampler] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Sampler] Resource context not current.");
-    m_filter = value;
-    glSamplerParameteri(gl_object::glo(), GL_TEXTURE_MIN_FILTER, m_filter.min_filter);
-    glSamplerParameteri(gl_object::glo(), GL_TEXTURE_MAG_FILTER, m_filter.mag_filter);
+    MGL_CORE_ASSERT(!m_immutable, "[Sampler] Cached samplers are immutable.");
+    m_state.min_filter = value.min_filter;
+    m_state.mag_filter = value.mag_filter;
+    glSamplerParameteri(gl_object::glo(), GL_TEXTURE_MIN_FILTER, m_state.min_filter);
+    glSamplerParameteri(gl_object::glo(), GL_TEXTURE_MAG_FILTER, m_state.mag_filter);
   }
 
   void sampler::set_compare_func(mgl::opengl::compare_func value)
   {
     MGL_CORE_ASSERT(!gl_object::released(), "[Sampler] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Sampler] Resource context not current.");
-    m_compare_func = value;
-    if(m_compare_func == mgl::opengl::compare_func::NONE)
+    MGL_CORE_ASSERT(!m_immutable, "[Sampler] Cached samplers are immutable.");
+    m_state.compare_func = value;
+    if(m_state.compare_func == mgl::opengl::compare_func::NONE)
     {
       glSamplerParameteri(gl_object::glo(), GL_TEXTURE_COMPARE_MODE, GL_NONE);
       return;
     }
 
     glSamplerParameteri(gl_object::glo(), GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
-    glSamplerParameteri(gl_object::glo(), GL_TEXTURE_COMPARE_FUNC, m_compare_func);
+    glSamplerParameteri(gl_object::glo(), GL_TEXTURE_COMPARE_FUNC, m_state.compare_func);
   }
 
   void sampler::set_anisotropy(float value)
   {
     MGL_CORE_ASSERT(!gl_object::released(), "[Sampler] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Sampler] Resource context not current.");
+    MGL_CORE_ASSERT(!m_immutable, "[Sampler] Cached samplers are immutable.");
 
     if(gl_object::ctx()->max_anisotropy() == 0)
     {
       return;
     }
 
-    m_anisotropy = (float)MGL_MIN(MGL_MAX(value, 1.0), gl_object::ctx()->max_anisotropy());
+    m_state.anisotropy =
+        (float)MGL_MIN(MGL_MAX(value, 1.0), gl_object::ctx()->max_anisotropy());
 
-    glSamplerParameterf(gl_object::glo(), GL_TEXTURE_MAX_ANISOTROPY, m_anisotropy);
+    glSamplerParameterf(gl_object::glo(), GL_TEXTURE_MAX_ANISOTROPY, m_state.anisotropy);
   }
 
   void sampler::set_border_color(const glm::vec4& value)
   {
     MGL_CORE_ASSERT(!gl_object::released(), "[Sampler] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Sampler] Resource context not current.");
+    MGL_CORE_ASSERT(!m_immutable, "[Sampler] Cached samplers are immutable.");
 
-    m_border_color = value;
+    m_state.border_color = value;
+    m_state.wrap_x = wrap_mode::CLAMP_TO_BORDER;
+    m_state.wrap_y = wrap_mode::CLAMP_TO_BORDER;
+    m_state.wrap_z = wrap_mode::CLAMP_TO_BORDER;
     glSamplerParameteri(gl_object::glo(), GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
     glSamplerParameteri(gl_object::glo(), GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
     glSamplerParameteri(gl_object::glo(), GL_TEXTURE_WRAP_R, GL_CLAMP_TO_BORDER);
-    glSamplerParameterfv(gl_object::glo(), GL_TEXTURE_BORDER_COLOR, (GLfloat*)&m_border_color);
+    glSamplerParameterfv(
+        gl_object::glo(), GL_TEXTURE_BORDER_COLOR, (GLfloat*)&m_state.border_color);
   }
 
   void sampler::set_min_lod(float value)
   {
     MGL_CORE_ASSERT(!gl_object::released(), "[Sampler] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Sampler] Resource context not current.");
-    m_min_lod = value;
-    glSamplerParameterf(gl_object::glo(), GL_TEXTURE_MIN_LOD, m_min_lod);
+    MGL_CORE_ASSERT(!m_immutable, "[Sampler] Cached samplers are immutable.");
+    m_state.min_lod = value;
+    glSamplerParameterf(gl_object::glo(), GL_TEXTURE_MIN_LOD, m_state.min_lod);
   }
 
   void sampler::set_max_lod(float value)
   {
     MGL_CORE_ASSERT(!gl_object::released(), "[Sampler] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Sampler] Resource context not current.");
-    m_max_lod = value;
-    glSamplerParameterf(gl_object::glo(), GL_TEXTURE_MAX_LOD, m_max_lod);
+    MGL_CORE_ASSERT(!m_immutable, "[Sampler] Cached samplers are immutable.");
+    m_state.max_lod = value;
+    glSamplerParameterf(gl_object::glo(), GL_TEXTURE_MAX_LOD, m_state.max_lod);
+  }
+
+  sampler_ref sampler_cache::get(const context_ref& ctx, const sampler::state& state)
+  {
+    MGL_CORE_ASSERT(ctx->is_current(), "[Sampler] Resource context not current.");
+
+    // States that only differ by an unsupported anisotropy share the same object
+    auto key = state;
+    key.anisotropy = ctx->max_anisotropy() > 0
+                         ? (float)MGL_MIN(MGL_MAX(key.anisotropy, 1.0), ctx->max_anisotropy())
+                         : 1.0f;
+
+    auto it = m_samplers.find(key);
+    if(it != m_samplers.end() && !it->second->released())
+      return it->second;
+
+    auto sampler = sampler_ref(new mgl::opengl::sampler(ctx, key, true));
+    m_samplers.insert_or_assign(key, sampler);
+    return sampler;
+  }
+
+  void sampler_cache::clear()
+  {
+    for(auto&& [state, sampler] : m_samplers)
+    {
+      if(!sampler->released())
+        sampler->release();
+    }
+
+    m_samplers.clear();
   }
 
 } // namespace  mgl::opengl
@@ -5,6 +5,8 @@
 
 #include "mgl_core/debug.hpp"
 
+#include <algorithm>
+
 #include "glad/gl.h"
 
 namespace mgl::opengl
@@ -59,8 +61,7 @@ namespace mgl::opengl
         default: MGL_CORE_ASSERT(false, "[Scope] Invalid texture type."); return;
       }
 
-      int32_t binding = t.binding;
-      m_textures[i].binding = GL_TEXTURE0 + binding;
+      m_textures[i].binding = t.binding;
       m_textures[i].type = texture_type;
       m_textures[i].gl_object = texture_obj;
       i++;
@@ -88,11 +89,17 @@ namespace mgl::opengl
     }
 
     m_begin = false;
+    m_outer = nullptr;
   }
 
   scope::~scope()
   {
     MGL_CORE_ASSERT(!m_begin, "[Scope] Scope not ended.");
+
+    // A scope still applied leaves behind the state it replaced
+    if(m_ctx->m_active_scope == this && !m_ctx->released())
+      restore();
+
     m_scope_state = { enable_flag::INVALID, nullptr };
     m_previous_state = { enable_flag::INVALID, nullptr };
     m_samplers.clear();
@@ -104,24 +111,67 @@ namespace mgl::opengl
   {
     MGL_CORE_ASSERT(!m_begin, "[Scope] Scope already started.");
     MGL_CORE_ASSERT(m_ctx->is_current(), "[Scope] Resource context not current.");
+
+    auto active = m_ctx->m_active_scope;
+    m_outer = nullptr;
+
+    if(active != nullptr && active != this && active->m_begin)
+    {
+      // Nested, the enclosing scope is applied again on end
+      m_outer = active;
+      m_previous_state = { m_ctx->enable_flags(), m_ctx->current_framebuffer() };
+    }
+    else if(active != nullptr && active != this)
+    {
+      // An ended scope is still applied, drop what this one does not bind over
+      m_previous_state = active->m_previous_state;
+      active->unbind(this);
+      active->m_previous_state = { enable_flag::INVALID, nullptr };
+    }
+    else if(active == nullptr)
+    {
+      m_previous_state = { m_ctx->enable_flags(), m_ctx->current_framebuffer() };
+    }
+
+    m_ctx->m_active_scope = this;
     m_begin = true;
+    apply();
+  }
+
+  void scope::end()
+  {
+    MGL_CORE_ASSERT(m_begin, "[Scope] Scope not started.");
+    MGL_CORE_ASSERT(m_ctx->is_current(), "[Scope] Resource context not current.");
+    m_begin = false;
 
-    const int32_t& flags = m_scope_state.enable_flags;
+    if(m_outer == nullptr)
+      return;
 
-    m_previous_state = { m_ctx->enable_flags(), m_ctx->current_framebuffer() };
-    m_ctx->enable(flags);
+    unbind(m_outer);
+    apply_flags(m_previous_state.enable_flags);
+    m_previous_state.framebuffer->use();
+    m_previous_state = { enable_flag::INVALID, nullptr };
 
+    m_outer->apply();
+    m_ctx->m_active_scope = m_outer;
+    m_outer = nullptr;
+  }
+
+  void scope::apply()
+  {
+    apply_flags(m_previous_state.enable_flags | m_scope_state.enable_flags);
+
+    // Every bind below is skipped by the context when the object is already bound
     m_scope_state.framebuffer->use();
 
     for(auto&& texture : m_textures)
     {
-      glActiveTexture(texture.binding);
-      glBindTexture(texture.type, texture.gl_object);
+      m_ctx->bind_texture(texture.binding, texture.type, texture.gl_object);
     }
 
     for(auto&& buffer : m_buffers)
     {
-      glBindBufferBase(buffer.type, buffer.binding, buffer.gl_object);
+      m_ctx->bind_buffer_base(buffer.type, buffer.binding, buffer.gl_object);
     }
 
     for(auto&& sampler : m_samplers)
@@ -131,36 +181,67 @@ namespace mgl::opengl
     }
   }
 
-  void scope::end()
+  void scope::apply_flags(int32_t flags)
   {
-    MGL_CORE_ASSERT(m_begin, "[Scope] Scope not started.");
-    MGL_CORE_ASSERT(m_ctx->is_current(), "[Scope] Resource context not current.");
-    const int32_t& flags = m_previous_state.enable_flags;
+    int32_t current = m_ctx->enable_flags();
 
-    m_ctx->enable(flags);
+    if(flags & ~current)
+      m_ctx->enable(flags & ~current);
 
-    m_previous_state.framebuffer->use();
-
-    m_previous_state = { enable_flag::INVALID, nullptr };
+    if(current & ~flags)
+      m_ctx->disable(current & ~flags);
+  }
 
+  // Unbinds what the next scope does not bind to the same point, everything if there is none
+  void scope::unbind(const scope* next)
+  {
     for(auto&& sampler : m_samplers)
     {
-      MGL_CORE_ASSERT(sampler.sampler, "[Scope] Invalid sampler.");
-      sampler.sampler->clear(sampler.binding);
+      bool kept = next && std::any_of(next->m_samplers.begin(),
+                                      next->m_samplers.end(),
+                                      [&](const sampler_binding& other) {
+                                        return other.binding == sampler.binding;
+                                      });
+      if(!kept)
+        m_ctx->bind_sampler(sampler.binding, 0);
     }
 
     for(auto&& buffer : m_buffers)
     {
-      glBindBufferBase(buffer.type, buffer.binding, 0);
+      bool kept = next && std::any_of(next->m_buffers.begin(),
+                                      next->m_buffers.end(),
+                                      [&](const binding_data& other) {
+                                        return other.binding == buffer.binding &&
+                                               other.type == buffer.type;
+                                      });
+      if(!kept)
+        m_ctx->bind_buffer_base(buffer.type, buffer.binding, 0);
     }
 
     for(auto&& texture : m_textures)
     {
-      glActiveTexture(texture.binding);
-      glBindTexture(texture.type, 0);
+      bool kept = next && std::any_of(next->m_textures.begin(),
+                                      next->m_textures.end(),
+                                      [&](const binding_data& other) {
+                                        return other.binding == texture.binding &&
+                                               other.type == texture.type;
+                                      });
+      if(!kept)
+        m_ctx->bind_texture(texture.binding, texture.type, 0);
     }
+  }
 
-    m_begin = false;
+  void scope::restore()
+  {
+    MGL_CORE_ASSERT(m_ctx->is_current(), "[Scope] Resource context not current.");
+    unbind(nullptr);
+    apply_flags(m_previous_state.enable_flags);
+
+    if(m_previous_state.framebuffer)
+      m_previous_state.framebuffer->use();
+
+    m_previous_state = { enable_flag::INVALID, nullptr };
+    m_ctx->m_active_scope = nullptr;
   }
 
 } // namespace  mgl::opengl
@@ -21,7 +21,8 @@ namespace mgl::opengl
                          int32_t samples,
                          int32_t align,
                          const std::string& dtype,
-                         int32_t internal_format_override)
+                         int32_t internal_format_override,
+                         int32_t levels)
       : gl_object(ctx)
   {
     MGL_CORE_ASSERT(components > 0 && components <= 4,
@@ -38,6 +39,7 @@ namespace mgl::opengl
                     "[Texture2D] Alignment must be 1, 2, 4 or 8.");
     MGL_CORE_ASSERT(!samples || !data,
                     "[Texture2D] Multisample textures are not writable directly.");
+    MGL_CORE_ASSERT(!samples || levels == 1, "[Texture2D] Multisample textures have one level.");
 
     auto data_type = from_dtype(dtype);
 
@@ -53,14 +55,14 @@ namespace mgl::opengl
     int32_t internal_format = internal_format_override ? internal_format_override
                                                        : data_type->internal_format[components];
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-
     m_width = w;
     m_height = h;
     m_components = components;
     m_samples = samples;
     m_data_type = data_type;
-    m_max_lvl = 0;
+    m_levels = samples ? 1 : internal::texture_levels(levels, w, h);
+    m_immutable = m_levels > 1 && gl_object::ctx()->texture_storage();
+    m_max_lvl = m_levels - 1;
     m_compare_func = mgl::opengl::compare_func::NONE;
     m_anisotropy = 1.0f;
     m_depth = false;
@@ -83,7 +85,7 @@ namespace mgl::opengl
 
     gl_object::set_glo(glo);
 
-    glBindTexture(texture_target, gl_object::glo());
+    gl_object::ctx()->select_texture(texture_target, gl_object::glo());
 
     if(samples)
     {
@@ -93,7 +95,26 @@ namespace mgl::opengl
     {
       glPixelStorei(GL_PACK_ALIGNMENT, align);
       glPixelStorei(GL_UNPACK_ALIGNMENT, align);
-      glTexImage2D(texture_target, 0, internal_format, w, h, 0, base_format, pixel_type, data);
+
+      if(m_levels > 1)
+      {
+        internal::texture_storage_2d(texture_target,
+                                     m_immutable,
+                                     m_levels,
+                                     internal_format,
+                                     w,
+                                     h,
+                                     base_format,
+                                     pixel_type);
+        if(data)
+          glTexSubImage2D(texture_target, 0, 0, 0, w, h, base_format, pixel_type, data);
+      }
+      else
+      {
+        glTexImage2D(
+            texture_target, 0, internal_format, w, h, 0, base_format, pixel_type, data);
+      }
+
       if(data_type->float_type)
       {
         glTexParameteri(texture_target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -105,7 +126,7 @@ namespace mgl::opengl
         glTexParameteri(texture_target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
       }
     }
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Texture2D] Error on creating texture 2d.");
+    MGL_GL_CHECK("[GL Texture2D] Error on creating texture 2d.");
   }
 
   texture_2d::texture_2d(const context_ref& ctx,
@@ -136,6 +157,8 @@ namespace mgl::opengl
     m_samples = samples;
     m_data_type = from_dtype("f4", 2);
     m_max_lvl = 0;
+    m_levels = 1;
+    m_immutable = false;
     m_compare_func = mgl::opengl::compare_func::EQUAL;
     m_anisotropy = 1.0f;
     m_depth = true;
@@ -145,7 +168,6 @@ namespace mgl::opengl
 
     GLuint glo = 0;
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
     glGenTextures(1, (GLuint*)&glo);
 
     if(!glo)
@@ -159,7 +181,7 @@ namespace mgl::opengl
     int32_t texture_target = samples ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
     int32_t pixel_type = GL_FLOAT;
 
-    glBindTexture(texture_target, gl_object::glo());
+    gl_object::ctx()->select_texture(texture_target, gl_object::glo());
 
     if(samples)
     {
@@ -176,7 +198,7 @@ namespace mgl::opengl
       glTexParameteri(texture_target, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
       glTexParameteri(texture_target, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
     }
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Texture2D] Error on creating texture 2d.");
+    MGL_GL_CHECK("[GL Texture2D] Error on creating texture 2d.");
   }
 
   void texture_2d::release()
@@ -185,6 +207,7 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Texture2D] Resource context not current.");
     GLuint glo = gl_object::glo();
     glDeleteTextures(1, &glo);
+    gl_object::ctx()->forget_texture(glo);
     gl_object::set_glo(GL_ZERO);
   }
 
@@ -215,8 +238,8 @@ namespace mgl::opengl
 
     char* ptr = (char*)dst.data() + dst_off;
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_2D, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_2D, gl_object::glo());
+    gl_object::ctx()->require_barrier(barrier_bit::TEXTURE_UPDATE_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -242,8 +265,9 @@ namespace mgl::opengl
     int base_format = m_depth ? GL_DEPTH_COMPONENT : m_data_type->base_format[m_components];
 
     glBindBuffer(GL_PIXEL_PACK_BUFFER, dst->glo());
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_2D, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_2D, gl_object::glo());
+    gl_object::ctx()->require_barrier(
+        barrier_bit::TEXTURE_UPDATE_BARRIER | barrier_bit::PIXEL_BUFFER_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -274,8 +298,8 @@ namespace mgl::opengl
     int pixel_type = m_data_type->gl_type;
     int format = m_depth ? GL_DEPTH_COMPONENT : m_data_type->base_format[m_components];
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_2D, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_2D, gl_object::glo());
+    gl_object::ctx()->require_barrier(barrier_bit::TEXTURE_UPDATE_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -308,8 +332,8 @@ namespace mgl::opengl
     int pixel_type = m_data_type->gl_type;
     int format = m_depth ? GL_DEPTH_COMPONENT : m_data_type->base_format[m_components];
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_2D, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_2D, gl_object::glo());
+    gl_object::ctx()->require_barrier(barrier_bit::TEXTURE_UPDATE_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -334,8 +358,9 @@ namespace mgl::opengl
     int format = m_depth ? GL_DEPTH_COMPONENT : m_data_type->base_format[m_components];
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, src->glo());
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_2D, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_2D, gl_object::glo());
+    gl_object::ctx()->require_barrier(
+        barrier_bit::TEXTURE_UPDATE_BARRIER | barrier_bit::PIXEL_BUFFER_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -364,8 +389,9 @@ namespace mgl::opengl
     int format = m_depth ? GL_DEPTH_COMPONENT : m_data_type->base_format[m_components];
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, src->glo());
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_2D, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_2D, gl_object::glo());
+    gl_object::ctx()->require_barrier(
+        barrier_bit::TEXTURE_UPDATE_BARRIER | barrier_bit::PIXEL_BUFFER_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -373,6 +399,51 @@ namespace mgl::opengl
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
   }
 
+  void texture_2d::write_level(const void* src, int lvl, int align)
+  {
+    MGL_CORE_ASSERT(!gl_object::released(), "[Texture2D] Resource already released or not valid.");
+    MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Texture2D] Resource context not current.");
+    MGL_CORE_ASSERT(align == 1 || align == 2 || align == 4 || align == 8,
+                    "[Texture2D] Alignment must be 1, 2, 4 or 8.");
+    MGL_CORE_ASSERT(lvl >= 0, "[Texture2D] Invalid level.");
+    MGL_CORE_ASSERT(!m_samples, "[Texture2D] Multisample textures cannot be written directly.");
+    MGL_CORE_ASSERT(!m_depth, "[Texture2D] Depth textures do not have mip levels.");
+
+    int width = m_width >> lvl;
+    int height = m_height >> lvl;
+
+    width = width > 1 ? width : 1;
+    height = height > 1 ? height : 1;
+
+    int pixel_type = m_data_type->gl_type;
+    int base_format = m_data_type->base_format[m_components];
+    int internal_format = m_data_type->internal_format[m_components];
+
+    gl_object::ctx()->select_texture(GL_TEXTURE_2D, gl_object::glo());
+    gl_object::ctx()->require_barrier(barrier_bit::TEXTURE_UPDATE_BARRIER);
+
+    glPixelStorei(GL_PACK_ALIGNMENT, align);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, align);
+
+    // Allocated levels are only filled, the others are defined on the mutable path
+    if(lvl < m_levels)
+    {
+      glTexSubImage2D(GL_TEXTURE_2D, lvl, 0, 0, width, height, base_format, pixel_type, src);
+      return;
+    }
+
+    MGL_CORE_ASSERT(!m_immutable, "[Texture2D] Level is out of the immutable storage.");
+
+    glTexImage2D(
+        GL_TEXTURE_2D, lvl, internal_format, width, height, 0, base_format, pixel_type, src);
+
+    if(lvl > m_max_lvl)
+    {
+      m_max_lvl = lvl;
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, m_max_lvl);
+    }
+  }
+
   void texture_2d::bind_to_image(int unit, bool read, bool write, int lvl, int format)
   {
     MGL_CORE_ASSERT(!gl_object::released(), "[Texture2D] Resource already released or not valid.");
@@ -397,9 +468,8 @@ namespace mgl::opengl
 
     int texture_target = m_samples ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
 
-    glActiveTexture(GL_TEXTURE0 + index);
-    glBindTexture(texture_target, gl_object::glo());
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Texture2D] Error on binding texture 2d.");
+    gl_object::ctx()->bind_texture(index, texture_target, gl_object::glo());
+    MGL_GL_CHECK("[GL Texture2D] Error on binding texture 2d.");
   }
 
   void texture_2d::build_mipmaps(int base, int max_level)
@@ -410,12 +480,19 @@ namespace mgl::opengl
 
     int texture_target = m_samples ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(texture_target, gl_object::glo());
+    // Allocated chains are filled in place, single level textures grow on the mutable path
+    if(m_levels > 1)
+    {
+      max_level = MGL_MIN(max_level, m_levels - 1);
+    }
+
+    gl_object::ctx()->select_texture(texture_target, gl_object::glo());
 
     glTexParameteri(texture_target, GL_TEXTURE_BASE_LEVEL, base);
     glTexParameteri(texture_target, GL_TEXTURE_MAX_LEVEL, max_level);
 
+    gl_object::ctx()->require_barrier(barrier_bit::TEXTURE_UPDATE_BARRIER |
+                                      barrier_bit::TEXTURE_FETCH_BARRIER);
     glGenerateMipmap(texture_target);
 
     glTexParameteri(texture_target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
@@ -423,7 +500,7 @@ namespace mgl::opengl
 
     m_filter = { GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR };
     m_max_lvl = max_level;
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Texture2D] Error on binding texture 2d.");
+    MGL_GL_CHECK("[GL Texture2D] Error on binding texture 2d.");
   }
 
   void texture_2d::set_repeat_x(bool value)
@@ -433,19 +510,18 @@ namespace mgl::opengl
 
     int texture_target = m_samples ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(texture_target, gl_object::glo());
-
     m_repeat_x = value;
 
     if(m_repeat_x)
     {
-      glTexParameteri(texture_target, GL_TEXTURE_WRAP_S, GL_REPEAT);
+      gl_object::ctx()->texture_parameter(
+          texture_target, gl_object::glo(), GL_TEXTURE_WRAP_S, GL_REPEAT);
       return;
     }
 
-    glTexParameteri(texture_target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Texture2D] Error on binding texture 2d.");
+    gl_object::ctx()->texture_parameter(
+        texture_target, gl_object::glo(), GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    MGL_GL_CHECK("[GL Texture2D] Error on binding texture 2d.");
   }
 
   void texture_2d::set_repeat_y(bool value)
@@ -455,19 +531,18 @@ namespace mgl::opengl
 
     int texture_target = m_samples ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(texture_target, gl_object::glo());
-
     m_repeat_y = value;
 
     if(m_repeat_y)
     {
-      glTexParameteri(texture_target, GL_TEXTURE_WRAP_T, GL_REPEAT);
+      gl_object::ctx()->texture_parameter(
+          texture_target, gl_object::glo(), GL_TEXTURE_WRAP_T, GL_REPEAT);
       return;
     }
 
-    glTexParameteri(texture_target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Texture2D] Error on binding texture 2d.");
+    gl_object::ctx()->texture_parameter(
+        texture_target, gl_object::glo(), GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    MGL_GL_CHECK("[GL Texture2D] Error on binding texture 2d.");
   }
 
   void texture_2d::set_filter(const texture::filter& value)
@@ -479,11 +554,11 @@ namespace mgl::opengl
 
     int texture_target = m_samples ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(texture_target, gl_object::glo());
-    glTexParameteri(texture_target, GL_TEXTURE_MIN_FILTER, m_filter.min_filter);
-    glTexParameteri(texture_target, GL_TEXTURE_MAG_FILTER, m_filter.mag_filter);
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Texture2D] Error on binding texture 2d.");
+    gl_object::ctx()->texture_parameter(
+        texture_target, gl_object::glo(), GL_TEXTURE_MIN_FILTER, m_filter.min_filter);
+    gl_object::ctx()->texture_parameter(
+        texture_target, gl_object::glo(), GL_TEXTURE_MAG_FILTER, m_filter.mag_filter);
+    MGL_GL_CHECK("[GL Texture2D] Error on binding texture 2d.");
   }
 
   std::string texture_2d::swizzle() const
@@ -494,8 +569,7 @@ namespace mgl::opengl
 
     int texture_target = m_samples ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(texture_target, gl_object::glo());
+    gl_object::ctx()->select_texture(texture_target, gl_object::glo());
 
     int swizzle_r = 0;
     int swizzle_g = 0;
@@ -515,7 +589,7 @@ namespace mgl::opengl
       0,
     };
 
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Texture2D] Error on binding texture 2d.");
+    MGL_GL_CHECK("[GL Texture2D] Error on binding texture 2d.");
     return swizzle;
   }
 
@@ -538,23 +612,24 @@ namespace mgl::opengl
 
     int texture_target = m_samples ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(texture_target, gl_object::glo());
-
-    glTexParameteri(texture_target, GL_TEXTURE_SWIZZLE_R, tex_swizzle[0]);
+    gl_object::ctx()->texture_parameter(
+        texture_target, gl_object::glo(), GL_TEXTURE_SWIZZLE_R, tex_swizzle[0]);
     if(tex_swizzle[1] != -1)
     {
-      glTexParameteri(texture_target, GL_TEXTURE_SWIZZLE_G, tex_swizzle[1]);
+      gl_object::ctx()->texture_parameter(
+          texture_target, gl_object::glo(), GL_TEXTURE_SWIZZLE_G, tex_swizzle[1]);
       if(tex_swizzle[2] != -1)
       {
-        glTexParameteri(texture_target, GL_TEXTURE_SWIZZLE_B, tex_swizzle[2]);
+        gl_object::ctx()->texture_parameter(
+            texture_target, gl_object::glo(), GL_TEXTURE_SWIZZLE_B, tex_swizzle[2]);
         if(tex_swizzle[3] != -1)
         {
-          glTexParameteri(texture_target, GL_TEXTURE_SWIZZLE_A, tex_swizzle[3]);
+          gl_object::ctx()->texture_parameter(
+              texture_target, gl_object::glo(), GL_TEXTURE_SWIZZLE_A, tex_swizzle[3]);
         }
       }
     }
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Texture2D] Error on binding texture 2d.");
+    MGL_GL_CHECK("[GL Texture2D] Error on binding texture 2d.");
   }
 
   void texture_2d::set_compare_func(mgl::opengl::compare_func value)
@@ -566,19 +641,20 @@ namespace mgl::opengl
     m_compare_func = value;
 
     int texture_target = m_samples ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(texture_target, gl_object::glo());
 
     if(m_compare_func == 0)
     {
-      glTexParameteri(texture_target, GL_TEXTURE_COMPARE_MODE, GL_NONE);
+      gl_object::ctx()->texture_parameter(
+          texture_target, gl_object::glo(), GL_TEXTURE_COMPARE_MODE, GL_NONE);
     }
     else
     {
-      glTexParameteri(texture_target, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
-      glTexParameteri(texture_target, GL_TEXTURE_COMPARE_FUNC, m_compare_func);
+      gl_object::ctx()->texture_parameter(
+          texture_target, gl_object::glo(), GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+      gl_object::ctx()->texture_parameter(
+          texture_target, gl_object::glo(), GL_TEXTURE_COMPARE_FUNC, m_compare_func);
     }
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Texture2D] Error on binding texture 2d.");
+    MGL_GL_CHECK("[GL Texture2D] Error on binding texture 2d.");
   }
 
   void texture_2d::set_anisotropy(float value)
@@ -589,11 +665,9 @@ namespace mgl::opengl
     m_anisotropy = (float)MGL_MIN(MGL_MAX(value, 1.0), gl_object::ctx()->max_anisotropy());
     int texture_target = m_samples ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(texture_target, gl_object::glo());
-
-    glTexParameterf(texture_target, GL_TEXTURE_MAX_ANISOTROPY, m_anisotropy);
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Texture2D] Error on binding texture 2d.");
+    gl_object::ctx()->texture_parameter(
+        texture_target, gl_object::glo(), GL_TEXTURE_MAX_ANISOTROPY, m_anisotropy);
+    MGL_GL_CHECK("[GL Texture2D] Error on binding texture 2d.");
   }
 
   void texture_2d::resize(int width, int height, int components, const mgl::uint8_buffer& data)
@@ -606,13 +680,13 @@ namespace mgl::opengl
                     "[Texture2D] components must be between 1 and 4");
     MGL_CORE_ASSERT(!m_samples, "[Texture2D] Cannot resize multisample textures.");
     MGL_CORE_ASSERT(!m_depth, "[Texture2D] Cannot resize depth textures.");
+    MGL_CORE_ASSERT(m_levels == 1, "[Texture2D] Cannot resize textures with allocated levels.");
 
     int texture_target = m_samples ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
 
     if(m_width == width && m_height == height && m_components == components)
     {
-      glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-      glBindTexture(texture_target, gl_object::glo());
+      gl_object::ctx()->select_texture(texture_target, gl_object::glo());
 
       if(data.size() > 0)
       {
@@ -624,14 +698,14 @@ namespace mgl::opengl
         glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, format, pixel_type, data.data());
       }
 
-      MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Texture2D] Error on binding texture 2d.");
+      MGL_GL_CHECK("[GL Texture2D] Error on binding texture 2d.");
+      return;
     }
 
     int internal_format = m_data_type->internal_format[components];
     int format = m_data_type->base_format[components];
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(texture_target, gl_object::glo());
+    gl_object::ctx()->select_texture(texture_target, gl_object::glo());
 
     glTexImage2D(GL_TEXTURE_2D,
                  0,
@@ -646,7 +720,7 @@ namespace mgl::opengl
     m_width = width;
     m_height = height;
     m_components = components;
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[GL Texture2D] Error on binding texture 2d.");
+    MGL_GL_CHECK("[GL Texture2D] Error on binding texture 2d.");
   }
 
 } // namespace  mgl::opengl
@@ -6,6 +6,7 @@
 #include "mgl_opengl_internal.hpp"
 
 #include "mgl_core/debug.hpp"
+#include "mgl_core/math.hpp"
 
 #include "glad/gl.h"
 
@@ -18,7 +19,8 @@ namespace mgl::opengl
                          int32_t components,
                          const void* data,
                          int32_t align,
-                         const std::string& dtype)
+                         const std::string& dtype,
+                         int32_t levels)
       : gl_object(ctx)
   {
     MGL_CORE_ASSERT(w > 0, "[Texture3D] Width must be greater than 0.");
@@ -42,7 +44,9 @@ namespace mgl::opengl
     m_depth = depth;
     m_components = components;
     m_data_type = data_type;
-    m_max_lvl = 0;
+    m_levels = internal::texture_levels(levels, w, h, depth);
+    m_immutable = m_levels > 1 && gl_object::ctx()->texture_storage();
+    m_max_lvl = m_levels - 1;
 
     auto filter = data_type->float_type ? GL_LINEAR : GL_NEAREST;
     m_filter = { filter, filter };
@@ -53,7 +57,6 @@ namespace mgl::opengl
 
     GLuint glo = 0;
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->max_texture_units());
     glGenTextures(1, &glo);
 
     if(!glo)
@@ -68,11 +71,30 @@ namespace mgl::opengl
     int32_t base_format = data_type->base_format[components];
     int32_t internal_format = data_type->internal_format[components];
 
-    glBindTexture(GL_TEXTURE_3D, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_3D, gl_object::glo());
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
-    glTexImage3D(GL_TEXTURE_3D, 0, internal_format, w, h, depth, 0, base_format, pixel_type, data);
+
+    if(m_levels > 1)
+    {
+      internal::texture_storage_3d(GL_TEXTURE_3D,
+                                   m_immutable,
+                                   m_levels,
+                                   internal_format,
+                                   w,
+                                   h,
+                                   depth,
+                                   base_format,
+                                   pixel_type);
+      if(data)
+        glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, 0, w, h, depth, base_format, pixel_type, data);
+    }
+    else
+    {
+      glTexImage3D(
+          GL_TEXTURE_3D, 0, internal_format, w, h, depth, 0, base_format, pixel_type, data);
+    }
 
     if(data_type->float_type)
     {
@@ -92,6 +114,7 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Texture3D] Resource context not current.");
     GLuint glo = gl_object::glo();
     glDeleteTextures(1, &glo);
+    gl_object::ctx()->forget_texture(glo);
     gl_object::set_glo(GL_ZERO);
   }
 
@@ -113,8 +136,8 @@ namespace mgl::opengl
 
     char* ptr = (char*)dst.data() + dst_offset;
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_3D, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_3D, gl_object::glo());
+    gl_object::ctx()->require_barrier(barrier_bit::TEXTURE_UPDATE_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -132,8 +155,9 @@ namespace mgl::opengl
     int32_t base_format = m_data_type->base_format[m_components];
 
     glBindBuffer(GL_PIXEL_PACK_BUFFER, dst->glo());
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_3D, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_3D, gl_object::glo());
+    gl_object::ctx()->require_barrier(
+        barrier_bit::TEXTURE_UPDATE_BARRIER | barrier_bit::PIXEL_BUFFER_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -163,8 +187,8 @@ namespace mgl::opengl
     int32_t base_format = m_data_type->base_format[m_components];
     int32_t pixel_type = m_data_type->gl_type;
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_3D, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_3D, gl_object::glo());
+    gl_object::ctx()->require_barrier(barrier_bit::TEXTURE_UPDATE_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -194,8 +218,8 @@ namespace mgl::opengl
     int32_t pixel_type = m_data_type->gl_type;
     int32_t base_format = m_data_type->base_format[m_components];
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_3D, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_3D, gl_object::glo());
+    gl_object::ctx()->require_barrier(barrier_bit::TEXTURE_UPDATE_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -221,8 +245,9 @@ namespace mgl::opengl
     int32_t base_format = m_data_type->base_format[m_components];
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, src->glo());
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_3D, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_3D, gl_object::glo());
+    gl_object::ctx()->require_barrier(
+        barrier_bit::TEXTURE_UPDATE_BARRIER | barrier_bit::PIXEL_BUFFER_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -248,8 +273,9 @@ namespace mgl::opengl
     int32_t base_format = m_data_type->base_format[m_components];
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, src->glo());
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_3D, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_3D, gl_object::glo());
+    gl_object::ctx()->require_barrier(
+        barrier_bit::TEXTURE_UPDATE_BARRIER | barrier_bit::PIXEL_BUFFER_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -279,8 +305,7 @@ namespace mgl::opengl
   {
     MGL_CORE_ASSERT(!gl_object::released(), "[Texture3D] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Texture3D] Resource context not current.");
-    glActiveTexture(GL_TEXTURE0 + index);
-    glBindTexture(GL_TEXTURE_3D, gl_object::glo());
+    gl_object::ctx()->bind_texture(index, GL_TEXTURE_3D, gl_object::glo());
   }
 
   void texture_3d::build_mipmaps(int32_t base, int32_t max_lvl)
@@ -289,10 +314,17 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Texture3D] Resource context not current.");
     MGL_CORE_ASSERT(base <= max_lvl, "[Texture3D] Invalid base.");
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_3D, gl_object::glo());
+    // Allocated chains are filled in place, single level textures grow on the mutable path
+    if(m_levels > 1)
+    {
+      max_lvl = MGL_MIN(max_lvl, m_levels - 1);
+    }
+
+    gl_object::ctx()->select_texture(GL_TEXTURE_3D, gl_object::glo());
     glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_BASE_LEVEL, base);
-    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAX_LEVEL, m_max_lvl);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAX_LEVEL, max_lvl);
+    gl_object::ctx()->require_barrier(barrier_bit::TEXTURE_UPDATE_BARRIER |
+                                      barrier_bit::TEXTURE_FETCH_BARRIER);
     glGenerateMipmap(GL_TEXTURE_3D);
     glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -306,18 +338,17 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(!gl_object::released(), "[Texture3D] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Texture3D] Resource context not current.");
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_3D, gl_object::glo());
-
     m_repeat_x = value;
 
     if(m_repeat_x)
     {
-      glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+      gl_object::ctx()->texture_parameter(
+          GL_TEXTURE_3D, gl_object::glo(), GL_TEXTURE_WRAP_S, GL_REPEAT);
       return;
     }
 
-    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    gl_object::ctx()->texture_parameter(
+        GL_TEXTURE_3D, gl_object::glo(), GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
   }
 
   void texture_3d::set_repeat_y(bool value)
@@ -325,18 +356,17 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(!gl_object::released(), "[Texture3D] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Texture3D] Resource context not current.");
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_3D, gl_object::glo());
-
     m_repeat_y = value;
 
     if(m_repeat_y)
     {
-      glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+      gl_object::ctx()->texture_parameter(
+          GL_TEXTURE_3D, gl_object::glo(), GL_TEXTURE_WRAP_T, GL_REPEAT);
       return;
     }
 
-    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    gl_object::ctx()->texture_parameter(
+        GL_TEXTURE_3D, gl_object::glo(), GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
   }
 
   void texture_3d::set_repeat_z(bool value)
@@ -344,18 +374,17 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(!gl_object::released(), "[Texture3D] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Texture3D] Resource context not current.");
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_3D, gl_object::glo());
-
     m_repeat_z = value;
 
     if(m_repeat_z)
     {
-      glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_REPEAT);
+      gl_object::ctx()->texture_parameter(
+          GL_TEXTURE_3D, gl_object::glo(), GL_TEXTURE_WRAP_R, GL_REPEAT);
       return;
     }
 
-    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    gl_object::ctx()->texture_parameter(
+        GL_TEXTURE_3D, gl_object::glo(), GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
   }
 
   void texture_3d::set_filter(const texture::filter& value)
@@ -365,11 +394,10 @@ namespace mgl::opengl
 
     m_filter = value;
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_3D, gl_object::glo());
-
-    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, m_filter.min_filter);
-    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, m_filter.mag_filter);
+    gl_object::ctx()->texture_parameter(
+        GL_TEXTURE_3D, gl_object::glo(), GL_TEXTURE_MIN_FILTER, m_filter.min_filter);
+    gl_object::ctx()->texture_parameter(
+        GL_TEXTURE_3D, gl_object::glo(), GL_TEXTURE_MAG_FILTER, m_filter.mag_filter);
   }
 
   std::string texture_3d::swizzle()
@@ -377,8 +405,7 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(!gl_object::released(), "[Texture3D] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[Texture3D] Resource context not current.");
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_3D, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_3D, gl_object::glo());
 
     int32_t swizzle_r = 0;
     int32_t swizzle_g = 0;
@@ -417,19 +444,20 @@ namespace mgl::opengl
           tex_swizzle[i] != -1, "[Texture3D] '{0}' is not a valid swizzle parameter.", value[i]);
     }
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_3D, gl_object::glo());
-
-    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_SWIZZLE_R, tex_swizzle[0]);
+    gl_object::ctx()->texture_parameter(
+        GL_TEXTURE_3D, gl_object::glo(), GL_TEXTURE_SWIZZLE_R, tex_swizzle[0]);
     if(tex_swizzle[1] != -1)
     {
-      glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_SWIZZLE_G, tex_swizzle[1]);
+      gl_object::ctx()->texture_parameter(
+          GL_TEXTURE_3D, gl_object::glo(), GL_TEXTURE_SWIZZLE_G, tex_swizzle[1]);
       if(tex_swizzle[2] != -1)
       {
-        glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_SWIZZLE_B, tex_swizzle[2]);
+        gl_object::ctx()->texture_parameter(
+            GL_TEXTURE_3D, gl_object::glo(), GL_TEXTURE_SWIZZLE_B, tex_swizzle[2]);
         if(tex_swizzle[3] != -1)
         {
-          glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_SWIZZLE_A, tex_swizzle[3]);
+          gl_object::ctx()->texture_parameter(
+              GL_TEXTURE_3D, gl_object::glo(), GL_TEXTURE_SWIZZLE_A, tex_swizzle[3]);
         }
       }
     }
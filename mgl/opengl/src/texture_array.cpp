@@ -19,7 +19,8 @@ namespace mgl::opengl
                                int32_t components,
                                const void* data,
                                int32_t align,
-                               const std::string& dtype)
+                               const std::string& dtype,
+                               int32_t levels)
       : gl_object(ctx)
   {
     MGL_CORE_ASSERT(w > 0, "[TextureArray] Width must be greater than 0.");
@@ -42,7 +43,9 @@ namespace mgl::opengl
     m_layers = layers;
     m_components = components;
     m_data_type = data_type;
-    m_max_level = 0;
+    m_levels = internal::texture_levels(levels, w, h);
+    m_immutable = m_levels > 1 && gl_object::ctx()->texture_storage();
+    m_max_level = m_levels - 1;
 
     auto filter = data_type->float_type ? GL_LINEAR : GL_NEAREST;
     m_filter = { filter, filter };
@@ -52,7 +55,6 @@ namespace mgl::opengl
 
     GLuint glo = 0;
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
     glGenTextures(1, &glo);
 
     if(!glo)
@@ -67,12 +69,33 @@ namespace mgl::opengl
     int32_t base_format = data_type->base_format[components];
     int32_t internal_format = data_type->internal_format[components];
 
-    glBindTexture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
-    glTexImage3D(
-        GL_TEXTURE_2D_ARRAY, 0, internal_format, w, h, layers, 0, base_format, pixel_type, data);
+
+    if(m_levels > 1)
+    {
+      internal::texture_storage_3d(GL_TEXTURE_2D_ARRAY,
+                                   m_immutable,
+                                   m_levels,
+                                   internal_format,
+                                   w,
+                                   h,
+                                   layers,
+                                   base_format,
+                                   pixel_type);
+      if(data)
+      {
+        glTexSubImage3D(
+            GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, w, h, layers, base_format, pixel_type, data);
+      }
+    }
+    else
+    {
+      glTexImage3D(
+          GL_TEXTURE_2D_ARRAY, 0, internal_format, w, h, layers, 0, base_format, pixel_type, data);
+    }
 
     if(data_type->float_type)
     {
@@ -93,6 +116,7 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[TextureArray] Resource context not current.");
     GLuint glo = gl_object::glo();
     glDeleteTextures(1, &glo);
+    gl_object::ctx()->forget_texture(glo);
     gl_object::set_glo(GL_ZERO);
   }
 
@@ -115,8 +139,8 @@ namespace mgl::opengl
 
     char* ptr = (char*)dst.data() + dst_off;
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
+    gl_object::ctx()->require_barrier(barrier_bit::TEXTURE_UPDATE_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -135,8 +159,9 @@ namespace mgl::opengl
     int32_t base_format = m_data_type->base_format[m_components];
 
     glBindBuffer(GL_PIXEL_PACK_BUFFER, dst->glo());
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
+    gl_object::ctx()->require_barrier(
+        barrier_bit::TEXTURE_UPDATE_BARRIER | barrier_bit::PIXEL_BUFFER_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -167,8 +192,8 @@ namespace mgl::opengl
     int32_t pixel_type = m_data_type->gl_type;
     int32_t base_format = m_data_type->base_format[m_components];
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
+    gl_object::ctx()->require_barrier(barrier_bit::TEXTURE_UPDATE_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -208,8 +233,8 @@ namespace mgl::opengl
     int32_t pixel_type = m_data_type->gl_type;
     int32_t base_format = m_data_type->base_format[m_components];
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
+    gl_object::ctx()->require_barrier(barrier_bit::TEXTURE_UPDATE_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -245,8 +270,9 @@ namespace mgl::opengl
     int32_t base_format = m_data_type->base_format[m_components];
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, src->glo());
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
+    gl_object::ctx()->require_barrier(
+        barrier_bit::TEXTURE_UPDATE_BARRIER | barrier_bit::PIXEL_BUFFER_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -274,8 +300,9 @@ namespace mgl::opengl
     int32_t base_format = m_data_type->base_format[m_components];
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, src->glo());
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
+    gl_object::ctx()->require_barrier(
+        barrier_bit::TEXTURE_UPDATE_BARRIER | barrier_bit::PIXEL_BUFFER_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -310,8 +337,7 @@ namespace mgl::opengl
                     "[TextureArray] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[TextureArray] Resource context not current.");
 
-    glActiveTexture(GL_TEXTURE0 + index);
-    glBindTexture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
+    gl_object::ctx()->bind_texture(index, GL_TEXTURE_2D_ARRAY, gl_object::glo());
   }
 
   void texture_array::build_mipmaps(int32_t base, int32_t max_level)
@@ -321,12 +347,19 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[TextureArray] Resource context not current.");
     MGL_CORE_ASSERT(base <= max_level, "[TextureArray] Invalid base.");
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
+    // Allocated chains are filled in place, single level textures grow on the mutable path
+    if(m_levels > 1)
+    {
+      max_level = MGL_MIN(max_level, m_levels - 1);
+    }
+
+    gl_object::ctx()->select_texture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
 
     glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BASE_LEVEL, base);
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, m_max_level);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, max_level);
 
+    gl_object::ctx()->require_barrier(barrier_bit::TEXTURE_UPDATE_BARRIER |
+                                      barrier_bit::TEXTURE_FETCH_BARRIER);
     glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
 
     glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
@@ -342,18 +375,17 @@ namespace mgl::opengl
                     "[TextureArray] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[TextureArray] Resource context not current.");
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
-
     m_repeat_x = value;
 
     if(m_repeat_x)
     {
-      glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+      gl_object::ctx()->texture_parameter(
+          GL_TEXTURE_2D_ARRAY, gl_object::glo(), GL_TEXTURE_WRAP_S, GL_REPEAT);
       return;
     }
 
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    gl_object::ctx()->texture_parameter(
+        GL_TEXTURE_2D_ARRAY, gl_object::glo(), GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
   }
 
   void texture_array::set_repeat_y(bool value)
@@ -362,18 +394,17 @@ namespace mgl::opengl
                     "[TextureArray] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[TextureArray] Resource context not current.");
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
-
     m_repeat_y = value;
 
     if(m_repeat_y)
     {
-      glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+      gl_object::ctx()->texture_parameter(
+          GL_TEXTURE_2D_ARRAY, gl_object::glo(), GL_TEXTURE_WRAP_T, GL_REPEAT);
       return;
     }
 
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    gl_object::ctx()->texture_parameter(
+        GL_TEXTURE_2D_ARRAY, gl_object::glo(), GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
   }
 
   void texture_array::set_filter(const texture::filter& value)
@@ -384,11 +415,10 @@ namespace mgl::opengl
 
     m_filter = value;
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
-
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, m_filter.min_filter);
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, m_filter.mag_filter);
+    gl_object::ctx()->texture_parameter(
+        GL_TEXTURE_2D_ARRAY, gl_object::glo(), GL_TEXTURE_MIN_FILTER, m_filter.min_filter);
+    gl_object::ctx()->texture_parameter(
+        GL_TEXTURE_2D_ARRAY, gl_object::glo(), GL_TEXTURE_MAG_FILTER, m_filter.mag_filter);
   }
 
   std::string texture_array::swizzle()
@@ -397,8 +427,7 @@ namespace mgl::opengl
                     "[TextureArray] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[TextureArray] Resource context not current.");
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
 
     int32_t swizzle_r = 0;
     int32_t swizzle_g = 0;
@@ -438,19 +467,20 @@ namespace mgl::opengl
           tex_swizzle[i] != -1, "[TextureArray] '{0}' is not a valid swizzle parameter.", value[i]);
     }
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
-
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_R, tex_swizzle[0]);
+    gl_object::ctx()->texture_parameter(
+        GL_TEXTURE_2D_ARRAY, gl_object::glo(), GL_TEXTURE_SWIZZLE_R, tex_swizzle[0]);
     if(tex_swizzle[1] != -1)
     {
-      glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_G, tex_swizzle[1]);
+      gl_object::ctx()->texture_parameter(
+          GL_TEXTURE_2D_ARRAY, gl_object::glo(), GL_TEXTURE_SWIZZLE_G, tex_swizzle[1]);
       if(tex_swizzle[2] != -1)
       {
-        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_B, tex_swizzle[2]);
+        gl_object::ctx()->texture_parameter(
+            GL_TEXTURE_2D_ARRAY, gl_object::glo(), GL_TEXTURE_SWIZZLE_B, tex_swizzle[2]);
         if(tex_swizzle[3] != -1)
         {
-          glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_A, tex_swizzle[3]);
+          gl_object::ctx()->texture_parameter(
+              GL_TEXTURE_2D_ARRAY, gl_object::glo(), GL_TEXTURE_SWIZZLE_A, tex_swizzle[3]);
         }
       }
     }
@@ -464,9 +494,7 @@ namespace mgl::opengl
 
     m_anisotropy = (float)MGL_MIN(MGL_MAX(value, 1.0), gl_object::ctx()->max_anisotropy());
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_2D_ARRAY, gl_object::glo());
-
-    glTexParameterf(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_ANISOTROPY, m_anisotropy);
+    gl_object::ctx()->texture_parameter(
+        GL_TEXTURE_2D_ARRAY, gl_object::glo(), GL_TEXTURE_MAX_ANISOTROPY, m_anisotropy);
   }
 } // namespace  mgl::opengl
@@ -19,7 +19,8 @@ namespace mgl::opengl
                              const void* data,
                              int32_t align,
                              const std::string& dtype,
-                             int32_t internal_format_override)
+                             int32_t internal_format_override,
+                             int32_t levels)
       : gl_object(ctx)
   {
     MGL_CORE_ASSERT(w > 0, "[TextureCube] Width must be greater than 0.");
@@ -41,14 +42,15 @@ namespace mgl::opengl
     m_height = h;
     m_components = components;
     m_data_type = data_type;
-    m_max_lvl = 0;
+    m_levels = internal::texture_levels(levels, w, h);
+    m_immutable = m_levels > 1 && gl_object::ctx()->texture_storage();
+    m_max_lvl = m_levels - 1;
 
     auto filter = data_type->float_type ? GL_LINEAR : GL_NEAREST;
     m_filter = { filter, filter };
 
     GLuint glo = 0;
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->max_texture_units());
     glGenTextures(1, &glo);
 
     if(!glo)
@@ -64,74 +66,52 @@ namespace mgl::opengl
     int32_t internal_format = internal_format_override ? internal_format_override
                                                        : data_type->internal_format[components];
 
-    int32_t expected_size = w * components * data_type->size;
-    expected_size = (expected_size + align - 1) / align * align;
-    expected_size = expected_size * h * 6;
-
-    const char* ptr[6] = {
-      (const char*)data + expected_size * 0 / 6, (const char*)data + expected_size * 1 / 6,
-      (const char*)data + expected_size * 2 / 6, (const char*)data + expected_size * 3 / 6,
-      (const char*)data + expected_size * 4 / 6, (const char*)data + expected_size * 5 / 6,
-    };
+    int32_t face_size = w * components * data_type->size;
+    face_size = (face_size + align - 1) / align * align;
+    face_size = face_size * h;
 
-    glBindTexture(GL_TEXTURE_CUBE_MAP, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_CUBE_MAP, gl_object::glo());
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
-    glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X,
-                 0,
-                 internal_format,
-                 w,
-                 h,
-                 0,
-                 base_format,
-                 pixel_type,
-                 ptr[0]);
-    glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_X,
-                 0,
-                 internal_format,
-                 w,
-                 h,
-                 0,
-                 base_format,
-                 pixel_type,
-                 ptr[1]);
-    glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_Y,
-                 0,
-                 internal_format,
-                 w,
-                 h,
-                 0,
-                 base_format,
-                 pixel_type,
-                 ptr[2]);
-    glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_Y,
-                 0,
-                 internal_format,
-                 w,
-                 h,
-                 0,
-                 base_format,
-                 pixel_type,
-                 ptr[3]);
-    glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_Z,
-                 0,
-                 internal_format,
-                 w,
-                 h,
-                 0,
-                 base_format,
-                 pixel_type,
-                 ptr[4]);
-    glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_Z,
-                 0,
-                 internal_format,
-                 w,
-                 h,
-                 0,
-                 base_format,
-                 pixel_type,
-                 ptr[5]);
+
+    if(m_levels > 1)
+    {
+      internal::texture_storage_2d(GL_TEXTURE_CUBE_MAP,
+                                   m_immutable,
+                                   m_levels,
+                                   internal_format,
+                                   w,
+                                   h,
+                                   base_format,
+                                   pixel_type);
+    }
+
+    // Faces are stored one after the other in data, in the order of the cube map targets
+    for(int32_t face = 0; face < 6; face++)
+    {
+      const char* ptr = data ? (const char*)data + face_size * face : nullptr;
+
+      if(m_levels > 1)
+      {
+        if(ptr)
+        {
+          glTexSubImage2D(
+              GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, 0, 0, w, h, base_format, pixel_type, ptr);
+        }
+        continue;
+      }
+
+      glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face,
+                   0,
+                   internal_format,
+                   w,
+                   h,
+                   0,
+                   base_format,
+                   pixel_type,
+                   ptr);
+    }
 
     if(data_type->float_type)
     {
@@ -152,6 +132,7 @@ namespace mgl::opengl
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[TextureCube] Resource context not current.");
     GLuint glo = gl_object::glo();
     glDeleteTextures(1, &glo);
+    gl_object::ctx()->forget_texture(glo);
     gl_object::set_glo(GL_ZERO);
   }
 
@@ -175,8 +156,8 @@ namespace mgl::opengl
 
     char* ptr = (char*)dst.data() + write_offset;
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_CUBE_MAP, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_CUBE_MAP, gl_object::glo());
+    gl_object::ctx()->require_barrier(barrier_bit::TEXTURE_UPDATE_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -196,9 +177,9 @@ namespace mgl::opengl
     int base_format = m_data_type->base_format[m_components];
 
     glBindBuffer(GL_PIXEL_PACK_BUFFER, dst->glo());
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-
-    glBindTexture(GL_TEXTURE_CUBE_MAP, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_CUBE_MAP, gl_object::glo());
+    gl_object::ctx()->require_barrier(
+        barrier_bit::TEXTURE_UPDATE_BARRIER | barrier_bit::PIXEL_BUFFER_BARRIER);
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
     glGetTexImage(
@@ -229,8 +210,8 @@ namespace mgl::opengl
     int pixel_type = m_data_type->gl_type;
     int base_format = m_data_type->base_format[m_components];
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_CUBE_MAP, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_CUBE_MAP, gl_object::glo());
+    gl_object::ctx()->require_barrier(barrier_bit::TEXTURE_UPDATE_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -267,8 +248,8 @@ namespace mgl::opengl
     int pixel_type = m_data_type->gl_type;
     int base_format = m_data_type->base_format[m_components];
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_CUBE_MAP, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_CUBE_MAP, gl_object::glo());
+    gl_object::ctx()->require_barrier(barrier_bit::TEXTURE_UPDATE_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -300,8 +281,9 @@ namespace mgl::opengl
     int base_format = m_data_type->base_format[m_components];
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, src->glo());
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_CUBE_MAP, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_CUBE_MAP, gl_object::glo());
+    gl_object::ctx()->require_barrier(
+        barrier_bit::TEXTURE_UPDATE_BARRIER | barrier_bit::PIXEL_BUFFER_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -327,8 +309,9 @@ namespace mgl::opengl
     int base_format = m_data_type->base_format[m_components];
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, src->glo());
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_CUBE_MAP, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_CUBE_MAP, gl_object::glo());
+    gl_object::ctx()->require_barrier(
+        barrier_bit::TEXTURE_UPDATE_BARRIER | barrier_bit::PIXEL_BUFFER_BARRIER);
 
     glPixelStorei(GL_PACK_ALIGNMENT, align);
     glPixelStorei(GL_UNPACK_ALIGNMENT, align);
@@ -362,8 +345,33 @@ namespace mgl::opengl
                     "[TextureCube] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[TextureCube] Resource context not current.");
 
-    glActiveTexture(GL_TEXTURE0 + index);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, gl_object::glo());
+    gl_object::ctx()->bind_texture(index, GL_TEXTURE_CUBE_MAP, gl_object::glo());
+  }
+
+  void texture_cube::build_mipmaps(int32_t base, int32_t max_lvl)
+  {
+    MGL_CORE_ASSERT(!gl_object::released(),
+                    "[TextureCube] Resource already released or not valid.");
+    MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[TextureCube] Resource context not current.");
+    MGL_CORE_ASSERT(base <= max_lvl, "[TextureCube] Invalid base.");
+
+    // Allocated chains are filled in place, single level textures grow on the mutable path
+    if(m_levels > 1)
+    {
+      max_lvl = MGL_MIN(max_lvl, m_levels - 1);
+    }
+
+    gl_object::ctx()->select_texture(GL_TEXTURE_CUBE_MAP, gl_object::glo());
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, base);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, max_lvl);
+    gl_object::ctx()->require_barrier(barrier_bit::TEXTURE_UPDATE_BARRIER |
+                                      barrier_bit::TEXTURE_FETCH_BARRIER);
+    glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    m_filter = { GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR };
+    m_max_lvl = max_lvl;
   }
 
   void texture_cube::set_filter(const texture::filter& value)
@@ -374,11 +382,10 @@ namespace mgl::opengl
 
     m_filter = value;
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_CUBE_MAP, gl_object::glo());
-
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, m_filter.min_filter);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, m_filter.mag_filter);
+    gl_object::ctx()->texture_parameter(
+        GL_TEXTURE_CUBE_MAP, gl_object::glo(), GL_TEXTURE_MIN_FILTER, m_filter.min_filter);
+    gl_object::ctx()->texture_parameter(
+        GL_TEXTURE_CUBE_MAP, gl_object::glo(), GL_TEXTURE_MAG_FILTER, m_filter.mag_filter);
   }
 
   std::string texture_cube::swizzle()
@@ -387,8 +394,7 @@ namespace mgl::opengl
                     "[TextureCube] Resource already released or not valid.");
     MGL_CORE_ASSERT(gl_object::ctx()->is_current(), "[TextureCube] Resource context not current.");
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_CUBE_MAP, gl_object::glo());
+    gl_object::ctx()->select_texture(GL_TEXTURE_CUBE_MAP, gl_object::glo());
 
     int swizzle_r = 0;
     int swizzle_g = 0;
@@ -428,19 +434,20 @@ namespace mgl::opengl
           tex_swizzle[i] != -1, "[TextureCube] '{0}' is not a valid swizzle parameter.", value[i]);
     }
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_CUBE_MAP, gl_object::glo());
-
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_SWIZZLE_R, tex_swizzle[0]);
+    gl_object::ctx()->texture_parameter(
+        GL_TEXTURE_CUBE_MAP, gl_object::glo(), GL_TEXTURE_SWIZZLE_R, tex_swizzle[0]);
     if(tex_swizzle[1] != -1)
     {
-      glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_SWIZZLE_G, tex_swizzle[1]);
+      gl_object::ctx()->texture_parameter(
+          GL_TEXTURE_CUBE_MAP, gl_object::glo(), GL_TEXTURE_SWIZZLE_G, tex_swizzle[1]);
       if(tex_swizzle[2] != -1)
       {
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_SWIZZLE_B, tex_swizzle[2]);
+        gl_object::ctx()->texture_parameter(
+            GL_TEXTURE_CUBE_MAP, gl_object::glo(), GL_TEXTURE_SWIZZLE_B, tex_swizzle[2]);
         if(tex_swizzle[3] != -1)
         {
-          glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_SWIZZLE_A, tex_swizzle[3]);
+          gl_object::ctx()->texture_parameter(
+              GL_TEXTURE_CUBE_MAP, gl_object::glo(), GL_TEXTURE_SWIZZLE_A, tex_swizzle[3]);
         }
       }
     }
@@ -454,9 +461,7 @@ namespace mgl::opengl
 
     m_anisotropy = (float)MGL_MIN(MGL_MAX(value, 1.0), gl_object::ctx()->max_anisotropy());
 
-    glActiveTexture(GL_TEXTURE0 + gl_object::ctx()->default_texture_unit());
-    glBindTexture(GL_TEXTURE_CUBE_MAP, gl_object::glo());
-
-    glTexParameterf(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_ANISOTROPY, m_anisotropy);
+    gl_object::ctx()->texture_parameter(
+        GL_TEXTURE_CUBE_MAP, gl_object::glo(), GL_TEXTURE_MAX_ANISOTROPY, m_anisotropy);
   }
 } // namespace  mgl::opengl
@@ -3,6 +3,8 @@
 
 #include "mgl_core/debug.hpp"
 
+#include "mgl_opengl_internal.hpp"
+
 #include "glad/gl.h"
 
 namespace mgl::opengl
@@ -418,7 +420,7 @@ namespace mgl::opengl
       break;
       default: MGL_CORE_ASSERT(false, "[Uniform] Invalid gl type."); break;
     }
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[Uniform] Failed to set uniform value.");
+    MGL_GL_CHECK("[Uniform] Failed to set uniform value.");
   }
 
   void uniform::get_value(void* data, size_t size)
@@ -0,0 +1,207 @@
+#include "mgl_opengl/validation.hpp"
+
+#include "mgl_core/debug.hpp"
+
+#include "mgl_opengl_internal.hpp"
+
+#include "glad/gl.h"
+
+#include <string>
+#include <vector>
+
+namespace mgl::opengl::validation
+{
+#ifdef MGL_OPENGL_VALIDATION
+  static bool s_enabled = true;
+  static bool s_debug_output = false;
+  static uint64_t s_error_count = 0;
+
+  // Errors the debug callback collected since the previous check on this thread
+  static thread_local std::vector<std::string> s_pending;
+
+  const static std::string opengl_debug_source_str[6] = {
+    "API", "WINDOW_SYSTEM", "SHADER_COMPILER", "THIRD_PARTY", "APPLICATION", "OTHER",
+  };
+
+  const static std::string opengl_debug_type_str[6] = {
+    "ERROR", "DEPRECATED BEHAVIOR", "UNDEFINED BEHAVIOR", "PORTABILITY", "PERFORMANCE", "OTHER"
+  };
+
+  const char* opengl_debug_severity_str[4] = { "HIGH", "MEDIUM", "LOW", "INFO" };
+
+  static void GLAD_API_PTR opengl_message_callback(GLenum source,
+                                                   GLenum type,
+                                                   GLuint id,
+                                                   GLenum severity,
+                                                   GLsizei length,
+                                                   const GLchar* message,
+                                                   const void* userParam)
+  {
+    int sev_idx, t_idx, src_idx;
+
+    switch(severity)
+    {
+      case GL_DEBUG_SEVERITY_HIGH: sev_idx = 0; break;
+      case GL_DEBUG_SEVERITY_MEDIUM: sev_idx = 1; break;
+      case GL_DEBUG_SEVERITY_LOW: sev_idx = 2; break;
+      default: sev_idx = 3; break;
+    }
+
+    switch(type)
+    {
+      case GL_DEBUG_TYPE_ERROR: t_idx = 0; break;
+      case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: t_idx = 1; break;
+      case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR: t_idx = 2; break;
+      case GL_DEBUG_TYPE_PORTABILITY: t_idx = 3; break;
+      case GL_DEBUG_TYPE_PERFORMANCE: t_idx = 4; break;
+      default: t_idx = 5; break;
+    }
+
+    switch(source)
+    {
+      case GL_DEBUG_SOURCE_API: src_idx = 0; break;
+      case GL_DEBUG_SOURCE_WINDOW_SYSTEM: src_idx = 1; break;
+      case GL_DEBUG_SOURCE_SHADER_COMPILER: src_idx = 2; break;
+      case GL_DEBUG_SOURCE_THIRD_PARTY: src_idx = 3; break;
+      case GL_DEBUG_SOURCE_APPLICATION: src_idx = 4; break;
+      default: src_idx = 5; break;
+    }
+
+    // Errors wait for the next check, which knows the call site
+    if(t_idx == 0)
+    {
+      if(s_enabled)
+        s_pending.push_back(std::string(message, length));
+      return;
+    }
+
+    MGL_CORE_ERROR("[GL DEBUG] ({0}) {1}, {2}: {3}",
+                   opengl_debug_severity_str[sev_idx],
+                   opengl_debug_source_str[src_idx],
+                   opengl_debug_type_str[t_idx],
+                   message);
+  }
+
+  static const char* error_name(GLenum error)
+  {
+    switch(error)
+    {
+      case GL_INVALID_ENUM: return "GL_INVALID_ENUM";
+      case GL_INVALID_VALUE: return "GL_INVALID_VALUE";
+      case GL_INVALID_OPERATION: return "GL_INVALID_OPERATION";
+      case GL_INVALID_FRAMEBUFFER_OPERATION: return "GL_INVALID_FRAMEBUFFER_OPERATION";
+      case GL_OUT_OF_MEMORY: return "GL_OUT_OF_MEMORY";
+      case GL_STACK_UNDERFLOW: return "GL_STACK_UNDERFLOW";
+      case GL_STACK_OVERFLOW: return "GL_STACK_OVERFLOW";
+      default: return "unknown error";
+    }
+  }
+
+  static void report(const char* site, const char* file, int32_t line, const std::string& error)
+  {
+    s_error_count++;
+    MGL_CORE_ERROR("{0} {1} ({2}:{3})", site, error, file, line);
+  }
+
+  bool available()
+  {
+    return true;
+  }
+
+  void set_enabled(bool value)
+  {
+    // Whatever happened while disabled is not attributed to the next check
+    if(value && !s_enabled)
+      internal::discard_errors();
+
+    s_enabled = value;
+  }
+
+  bool enabled()
+  {
+    return s_enabled;
+  }
+
+  uint64_t error_count()
+  {
+    return s_error_count;
+  }
+
+  void reset()
+  {
+    s_error_count = 0;
+  }
+#else
+  bool available()
+  {
+    return false;
+  }
+
+  void set_enabled(bool value) { }
+
+  bool enabled()
+  {
+    return false;
+  }
+
+  uint64_t error_count()
+  {
+    return 0;
+  }
+
+  void reset() { }
+#endif
+
+} // namespace  mgl::opengl::validation
+
+namespace mgl::opengl::internal
+{
+#ifdef MGL_OPENGL_VALIDATION
+  void check_errors(const char* site, const char* file, int32_t line)
+  {
+    using namespace mgl::opengl::validation;
+
+    if(!s_enabled)
+      return;
+
+    if(s_debug_output)
+    {
+      if(s_pending.empty())
+        return;
+
+      for(auto&& error : s_pending)
+        report(site, file, line, error);
+
+      s_pending.clear();
+      return;
+    }
+
+    for(GLenum error = glGetError(); error != GL_NO_ERROR; error = glGetError())
+      report(site, file, line, error_name(error));
+  }
+
+  void discard_errors()
+  {
+    validation::s_pending.clear();
+    while(glGetError() != GL_NO_ERROR) { }
+  }
+
+  void enable_debug_output()
+  {
+    glEnable(GL_DEBUG_OUTPUT);
+    glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    glDebugMessageCallback(validation::opengl_message_callback, nullptr);
+    glDebugMessageControl(
+        GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);
+    validation::s_debug_output = true;
+  }
+#else
+  void discard_errors()
+  {
+    while(glGetError() != GL_NO_ERROR) { }
+  }
+
+  void enable_debug_output() { }
+#endif
+
+} // namespace  mgl::opengl::internal
@@ -6,6 +6,8 @@
 
 #include "mgl_core/debug.hpp"
 
+#include "mgl_opengl_internal.hpp"
+
 #include "glad/gl.h"
 
 namespace mgl::opengl
@@ -36,7 +38,7 @@ namespace mgl::opengl
 
     update(prg, vertex_buffers, index_buffer, element_size);
 
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[VertexArray] OpenGL error.");
+    MGL_GL_CHECK("[VertexArray] OpenGL error.");
   }
 
   void vertex_array::release()
@@ -49,6 +51,13 @@ namespace mgl::opengl
     gl_object::set_glo(GL_ZERO);
   }
 
+  // Every way a draw can read what a dispatch wrote
+  static const uint32_t s_draw_barriers =
+      barrier_bit::VERTEX_ATTRIB_ARRAY_BARRIER | barrier_bit::ELEMENT_ARRAY_BARRIER |
+      barrier_bit::UNIFORM_BARRIER | barrier_bit::TEXTURE_FETCH_BARRIER |
+      barrier_bit::SHADER_IMAGE_ACCESS_BARRIER | barrier_bit::SHADER_STORAGE_BARRIER |
+      barrier_bit::ATOMIC_COUNTER_BARRIER | barrier_bit::FRAMEBUFFER_BARRIER;
+
   void vertex_array::render(mgl::opengl::render_mode mode,
                             int32_t vertices,
                             int32_t first,
@@ -66,6 +75,7 @@ namespace mgl::opengl
     }
 
     MGL_CORE_ASSERT(!m_prg->released(), "[VertexArray] Program already released.");
+    gl_object::ctx()->require_barrier(s_draw_barriers);
     glUseProgram(m_prg->glo());
     glBindVertexArray(gl_object::glo());
     if(m_ibo != nullptr)
@@ -78,7 +88,7 @@ namespace mgl::opengl
       glDrawArraysInstanced(mode, first, vertices, instances);
     }
     glBindVertexArray(0);
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[VertexArray] OpenGL error.");
+    MGL_GL_CHECK("[VertexArray] OpenGL error.");
   }
 
   void vertex_array::render_indirect(const buffer_ref& indirect_commands,
@@ -94,6 +104,7 @@ namespace mgl::opengl
                     "[VertexArray] 'indirect_commands' size is invalid.");
 
     MGL_CORE_ASSERT(!m_prg->released(), "[VertexArray] Program already released.");
+    gl_object::ctx()->require_barrier(s_draw_barriers | barrier_bit::COMMAND_BARRIER);
     glUseProgram(m_prg->glo());
     glBindVertexArray(gl_object::glo());
     glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect_commands->glo());
@@ -109,7 +120,7 @@ namespace mgl::opengl
       glMultiDrawArraysIndirect(mode, ptr, count, sizeof(draw_indirect_command));
     }
     glBindVertexArray(0);
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[VertexArray] OpenGL error.");
+    MGL_GL_CHECK("[VertexArray] OpenGL error.");
   }
 
   void vertex_array::transform(const mgl::ref_list<buffer>& buffers,
@@ -201,6 +212,8 @@ namespace mgl::opengl
       }
     }
 
+    gl_object::ctx()->require_barrier(
+        s_draw_barriers | barrier_bit::TRANSFORM_FEEDBACK_BARRIER);
     glUseProgram(m_prg->glo());
     glBindVertexArray(gl_object::glo());
 
@@ -273,7 +286,7 @@ namespace mgl::opengl
     glVertexAttribDivisor(location, divisor);
     glEnableVertexAttribArray(location);
     glBindVertexArray(0);
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[VertexArray] OpenGL error.");
+    MGL_GL_CHECK("[VertexArray] OpenGL error.");
   }
 
   void vertex_array::update(const program_ref& prg,
@@ -363,7 +376,7 @@ namespace mgl::opengl
     }
 
     glBindVertexArray(0);
-    MGL_CORE_ASSERT(glGetError() == GL_NO_ERROR, "[VertexArray] OpenGL error.");
+    MGL_GL_CHECK("[VertexArray] OpenGL error.");
   }
 
 } // namespace  mgl::opengl
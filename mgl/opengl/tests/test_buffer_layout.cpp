@@ -156,6 +156,64 @@ TEST(BufferLayoutTest, InvalidSizeElementLayout)
   EXPECT_TRUE(layout.is_invalid());
 }
 
+TEST(BufferLayoutTest, UnsignedElementOffset)
+{
+  mgl::opengl::buffer_layout layout("3f 4u1/i");
+  EXPECT_EQ(layout.stride(), 16);
+  EXPECT_EQ(layout.size(), 2);
+  EXPECT_EQ(layout.divisor(), 1);
+
+  EXPECT_EQ(layout[1].size, 4);
+  EXPECT_EQ(layout[1].offset, 12);
+  EXPECT_EQ(layout[1].type, GL_UNSIGNED_BYTE);
+  EXPECT_TRUE(layout[1].normalize);
+
+  mgl::opengl::buffer_layout next("2u 1f");
+  EXPECT_EQ(next[1].offset, 8);
+}
+
+TEST(BufferLayoutTest, CompiledLayout)
+{
+  constexpr auto compiled = mgl::opengl::compile_layout("3f 2i 4x 2f/i");
+  static_assert(compiled.size == 3);
+  static_assert(compiled.stride == 32);
+  static_assert(compiled.divisor == 1);
+  static_assert(compiled.elements[2].offset == 24);
+  static_assert(compiled == mgl::opengl::parse_layout("3f 2i 4x 2f/i"));
+  static_assert(compiled != mgl::opengl::parse_layout("3f 2i 4x 2f"));
+  static_assert(mgl::opengl::parse_layout("3f2i").is_invalid());
+
+  mgl::opengl::buffer_layout layout(compiled);
+  EXPECT_EQ(layout.layout(), "3f 2i 4x 2f/i");
+  EXPECT_EQ(layout.stride(), 32);
+  EXPECT_EQ(layout[1].type, GL_INT);
+  EXPECT_EQ(layout.descriptor(), compiled);
+  EXPECT_EQ(layout.hash(), compiled.hash);
+}
+
+TEST(BufferLayoutTest, InternedLayout)
+{
+  mgl::opengl::buffer_layout a("4f 4f 4f 4f/i");
+  auto count = mgl::opengl::buffer_layout::interned();
+
+  // The same string is parsed once and shared
+  mgl::opengl::buffer_layout b(std::string("4f 4f 4f 4f/i"));
+  mgl::opengl::buffer_layout c(mgl::opengl::compile_layout("4f 4f 4f 4f/i"));
+  EXPECT_EQ(mgl::opengl::buffer_layout::interned(), count);
+  EXPECT_EQ(&a.descriptor(), &b.descriptor());
+  EXPECT_EQ(&a.descriptor(), &c.descriptor());
+  EXPECT_EQ(a, c);
+  EXPECT_EQ(std::hash<mgl::opengl::buffer_layout>{}(a), std::hash<mgl::opengl::buffer_layout>{}(b));
+
+  mgl::opengl::buffer_layout d("4f 4f 4f 4f");
+  EXPECT_NE(a, d);
+  EXPECT_NE(a.hash(), d.hash());
+
+  // Reassigning from a string interns it as well
+  d = "4f 4f 4f 4f/i";
+  EXPECT_EQ(a, d);
+}
+
 int main(int argc, char** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -1,3 +1,4 @@
+#include "mgl_opengl/call_counter.hpp"
 #include "mgl_opengl/context.hpp"
 #include <gtest/gtest.h>
 
@@ -118,6 +119,107 @@ TEST(ComputeShaderTest, ComputeShaderWithUniform)
   buf2->release();
   ctx1->release();
 }
+
+static const char* s_double_shader = R"(
+    #version 430
+
+    layout(std430, binding = 0) buffer Data {
+        float data[];
+    };
+
+    layout (local_size_x = 1, local_size_y = 1, local_size_z = 1) in;
+
+    void main() {
+        data[gl_GlobalInvocationID.x] *= 2.0;
+    }
+)";
+
+TEST(ComputeShaderTest, LazyBarrier)
+{
+  namespace calls = mgl::opengl::call_counter;
+  using namespace mgl::opengl;
+
+  mgl::float32_buffer data = { 1, 2, 3, 4 };
+
+  auto ctx = create_context(context_mode::STANDALONE);
+  ASSERT_NE(ctx, nullptr);
+  ASSERT_GE(ctx->version(), 430);
+
+  auto compute_shader = ctx->compute_shader(s_double_shader);
+  ASSERT_NE(compute_shader, nullptr);
+
+  auto buf = ctx->buffer(data);
+  buf->bind_to_storage_buffer(0);
+
+  calls::enable();
+  calls::reset();
+
+  // Nothing is issued by the dispatch itself
+  compute_shader->dispatch(4, 1, 1, SHADER_STORAGE_BARRIER | BUFFER_UPDATE_BARRIER);
+  ASSERT_EQ(calls::count("glMemoryBarrier"), 0);
+  ASSERT_EQ(ctx->pending_barriers(), SHADER_STORAGE_BARRIER | BUFFER_UPDATE_BARRIER);
+
+  // The second dispatch reads the storage buffer, only that bit is issued
+  compute_shader->dispatch(4, 1, 1, SHADER_STORAGE_BARRIER | BUFFER_UPDATE_BARRIER);
+  ASSERT_EQ(calls::count("glMemoryBarrier"), 1);
+
+  buf->download(data);
+  ASSERT_EQ(calls::count("glMemoryBarrier"), 2);
+  ASSERT_EQ(ctx->pending_barriers(), SHADER_STORAGE_BARRIER);
+
+  buf->download(data);
+  ASSERT_EQ(calls::count("glMemoryBarrier"), 2);
+
+  ctx->flush_barriers();
+  ASSERT_EQ(calls::count("glMemoryBarrier"), 3);
+  ASSERT_EQ(ctx->pending_barriers(), 0);
+
+  calls::disable();
+
+  ASSERT_EQ(data[0], 4);
+  ASSERT_EQ(data[1], 8);
+  ASSERT_EQ(data[2], 12);
+  ASSERT_EQ(data[3], 16);
+
+  compute_shader->release();
+  buf->release();
+  ctx->release();
+}
+
+TEST(ComputeShaderTest, RunIndirect)
+{
+  using namespace mgl::opengl;
+
+  mgl::float32_buffer data = { 1, 2, 3, 4 };
+  mgl::uint32_buffer groups = { 0, 3, 1, 1 };
+
+  auto ctx = create_context(context_mode::STANDALONE);
+  ASSERT_NE(ctx, nullptr);
+  ASSERT_GE(ctx->version(), 430);
+
+  auto compute_shader = ctx->compute_shader(s_double_shader);
+  ASSERT_NE(compute_shader, nullptr);
+
+  auto buf = ctx->buffer(data);
+  auto cmd = ctx->buffer(groups);
+  buf->bind_to_storage_buffer(0);
+
+  // The group count is read past the first value
+  compute_shader->run_indirect(cmd, sizeof(uint32_t));
+  ASSERT_EQ(ctx->pending_barriers(), ALL_BARRIERS);
+
+  buf->download(data);
+
+  ASSERT_EQ(data[0], 2);
+  ASSERT_EQ(data[1], 4);
+  ASSERT_EQ(data[2], 6);
+  ASSERT_EQ(data[3], 4);
+
+  compute_shader->release();
+  buf->release();
+  cmd->release();
+  ctx->release();
+}
 #endif
 
 int main(int argc, char** argv)
@@ -0,0 +1,30 @@
+#include "mgl_opengl/context.hpp"
+#include <gtest/gtest.h>
+
+TEST(FenceTest, WaitAfterUpload)
+{
+  auto ctx = mgl::opengl::create_context(mgl::opengl::context_mode::STANDALONE);
+  ASSERT_NE(ctx, nullptr);
+
+  mgl::float32_buffer in = { 1, 2, 3, 4 };
+  auto buf = ctx->buffer(in);
+
+  auto fence = ctx->fence();
+  ASSERT_NE(fence, nullptr);
+  ASSERT_FALSE(fence->released());
+
+  ASSERT_TRUE(fence->wait());
+  ASSERT_TRUE(fence->signaled());
+
+  fence->release();
+  ASSERT_TRUE(fence->released());
+
+  buf->release();
+  ctx->release();
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,3 +1,4 @@
+#include "mgl_opengl/call_counter.hpp"
 #include "mgl_opengl/context.hpp"
 #include <gtest/gtest.h>
 
@@ -187,6 +188,74 @@ TEST(FramebufferTest, MaskTests)
   ctx->release();
 }
 
+TEST(FramebufferTest, StateCache)
+{
+  namespace calls = mgl::opengl::call_counter;
+
+  auto ctx = mgl::opengl::create_context(mgl::opengl::context_mode::STANDALONE);
+  ASSERT_NE(ctx, nullptr);
+
+  auto a = ctx->framebuffer({ ctx->renderbuffer(4, 4) }, ctx->depth_renderbuffer(4, 4));
+  auto b = ctx->framebuffer({ ctx->renderbuffer(4, 4) }, ctx->depth_renderbuffer(4, 4));
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+
+  a->use();
+
+  calls::enable();
+  calls::reset();
+
+  // Nothing changed, nothing is emitted
+  a->use();
+  ASSERT_EQ(calls::count("glBindFramebuffer"), 0);
+  ASSERT_EQ(calls::count("glViewport"), 0);
+  ASSERT_EQ(calls::count("glColorMaski"), 0);
+  ASSERT_EQ(calls::count("glDepthMask"), 0);
+  ASSERT_EQ(calls::count("glDisable"), 0);
+
+  // Same size and masks, only the binding differs
+  b->use();
+  ASSERT_EQ(calls::count("glBindFramebuffer"), 1);
+  ASSERT_EQ(calls::count("glViewport"), 0);
+
+  // Clearing another framebuffer leaves the bound one in place
+  calls::reset();
+  a->clear(1, 0, 0, 1);
+  ASSERT_EQ(calls::count("glBindFramebuffer"), ctx->direct_state_access() ? 0 : 2);
+  ASSERT_EQ(calls::count("glColorMaski"), 0);
+  ASSERT_EQ(ctx->current_framebuffer(), b);
+
+  b->clear(0, 0, 1, 1);
+
+  static mgl::uint8_buffer pixels(4 * 4 * 4);
+  a->read(pixels, mgl::rect(0, 0, 4, 4), 4);
+  ASSERT_EQ(pixels[0], 255);
+  ASSERT_EQ(pixels[2], 0);
+
+  b->read(pixels, mgl::rect(0, 0, 4, 4), 4);
+  ASSERT_EQ(pixels[0], 0);
+  ASSERT_EQ(pixels[2], 255);
+
+  // A clear limited to a rectangle turns the scissor test back off
+  calls::reset();
+  b->clear(0, 1, 0, 1, 0, mgl::rect(0, 0, 2, 2));
+  ASSERT_EQ(calls::count("glEnable"), 1);
+  ASSERT_EQ(calls::count("glDisable"), 1);
+
+  b->read(pixels, mgl::rect(0, 0, 4, 4), 4);
+  ASSERT_EQ(pixels[1], 255);
+  ASSERT_EQ(pixels[4 * 4 * 4 - 3], 0);
+
+  calls::reset();
+  a->set_viewport(mgl::rect(0, 0, 2, 2));
+  a->use();
+  ASSERT_EQ(calls::count("glBindFramebuffer"), 1);
+  ASSERT_EQ(calls::count("glViewport"), 1);
+
+  calls::disable();
+  ctx->release();
+}
+
 int main(int argc, char** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,180 @@
+#include "mgl_opengl/call_counter.hpp"
+#include "mgl_opengl/context.hpp"
+#include <gtest/gtest.h>
+
+TEST(QueryTest, PoolResults)
+{
+  auto ctx = mgl::opengl::create_context(mgl::opengl::context_mode::STANDALONE);
+  ASSERT_NE(ctx, nullptr);
+
+  auto prg = ctx->program({
+      R"(
+            #version 330
+
+            in vec2 in_vert;
+
+            void main() {
+                gl_Position = vec4(in_vert, 0.0, 1.0);
+            }
+      )",
+      R"(
+            #version 330
+
+            out vec4 f_color;
+
+            void main() {
+                f_color = vec4(1.0);
+            }
+      )" });
+  ASSERT_NE(prg, nullptr);
+
+  static mgl::float32_buffer data = { -1, -1, -1, 1, 1, -1, 1, 1 };
+  auto vbo = ctx->buffer(data);
+  auto vao = ctx->vertex_array(prg, { { vbo, "2f", { "in_vert" } } });
+
+  auto fbo = ctx->framebuffer({ ctx->renderbuffer(4, 4) }, nullptr);
+  fbo->use();
+
+  // The blocking query gives the reference values
+  auto reference = ctx->query(true, false, false, true);
+  reference->begin();
+  vao->render(mgl::opengl::render_mode::TRIANGLE_STRIP);
+  reference->end();
+
+  auto& pool = ctx->query_pool();
+  ASSERT_EQ(pool.frames(), 3);
+
+  uint64_t value = 0;
+  ASSERT_FALSE(pool.result(mgl::opengl::query::SAMPLES_PASSED, 0, value));
+
+  // Results show up within the frames in flight without ever waiting on the GPU
+  for(int32_t frame = 0; frame < 8; frame++)
+  {
+    pool.begin(mgl::opengl::query::SAMPLES_PASSED, 0);
+    pool.begin(mgl::opengl::query::PRIMITIVES_GENERATED, 0);
+    vao->render(mgl::opengl::render_mode::TRIANGLE_STRIP);
+    pool.end(mgl::opengl::query::PRIMITIVES_GENERATED);
+    pool.end(mgl::opengl::query::SAMPLES_PASSED);
+
+    pool.begin(mgl::opengl::query::TIME_ELAPSED, 1);
+    vao->render(mgl::opengl::render_mode::TRIANGLE_STRIP);
+    pool.end(mgl::opengl::query::TIME_ELAPSED);
+
+    pool.next_frame();
+    ctx->finish();
+  }
+
+  ASSERT_TRUE(pool.result(mgl::opengl::query::SAMPLES_PASSED, 0, value));
+  ASSERT_EQ(value, reference->samples());
+  ASSERT_TRUE(pool.result(mgl::opengl::query::PRIMITIVES_GENERATED, 0, value));
+  ASSERT_EQ(value, reference->primitives());
+  ASSERT_TRUE(pool.result(mgl::opengl::query::TIME_ELAPSED, 1, value));
+  ASSERT_FALSE(pool.result(mgl::opengl::query::TIME_ELAPSED, 0, value));
+  ASSERT_EQ(pool.dropped(), 0);
+
+  ctx->release();
+}
+
+TEST(QueryTest, PoolNeverBlocks)
+{
+  namespace calls = mgl::opengl::call_counter;
+
+  auto ctx = mgl::opengl::create_context(mgl::opengl::context_mode::STANDALONE);
+  ASSERT_NE(ctx, nullptr);
+
+  mgl::opengl::query_pool pool(2);
+
+  calls::enable();
+  calls::reset();
+
+  for(int32_t frame = 0; frame < 4; frame++)
+  {
+    pool.begin(mgl::opengl::query::TIME_ELAPSED, 0);
+    pool.end(mgl::opengl::query::TIME_ELAPSED);
+    pool.next_frame();
+  }
+
+  // One object per frame in flight, reused after that
+  ASSERT_EQ(calls::count("glGenQueries"), 2);
+
+  ctx->finish();
+  pool.next_frame();
+
+  uint64_t value = 0;
+  ASSERT_TRUE(pool.result(mgl::opengl::query::TIME_ELAPSED, 0, value));
+
+  calls::disable();
+  pool.release();
+  ctx->release();
+}
+
+TEST(QueryTest, Occlusion)
+{
+  auto ctx = mgl::opengl::create_context(mgl::opengl::context_mode::STANDALONE);
+  ASSERT_NE(ctx, nullptr);
+
+  auto prg = ctx->program({
+      R"(
+            #version 330
+
+            in vec2 in_vert;
+            uniform float depth;
+
+            void main() {
+                gl_Position = vec4(in_vert, depth, 1.0);
+            }
+      )",
+      R"(
+            #version 330
+
+            out vec4 f_color;
+
+            void main() {
+                f_color = vec4(1.0);
+            }
+      )" });
+  ASSERT_NE(prg, nullptr);
+
+  static mgl::float32_buffer data = { -1, -1, -1, 1, 1, -1, 1, 1 };
+  auto vbo = ctx->buffer(data);
+  auto vao = ctx->vertex_array(prg, { { vbo, "2f", { "in_vert" } } });
+
+  auto fbo = ctx->framebuffer({ ctx->renderbuffer(4, 4) }, ctx->depth_renderbuffer(4, 4));
+  fbo->use();
+  fbo->clear(0, 0, 0, 0, 1.0f, fbo->viewport());
+  ctx->enable(mgl::opengl::enable_flag::DEPTH_TEST);
+
+  // The occluder fills the depth buffer at the middle of the range
+  prg->set_value("depth", 0.0f);
+  vao->render(mgl::opengl::render_mode::TRIANGLE_STRIP);
+
+  auto behind = ctx->query(false, true, false, false);
+  prg->set_value("depth", 0.5f);
+  behind->begin();
+  vao->render(mgl::opengl::render_mode::TRIANGLE_STRIP);
+  behind->end();
+
+  auto front = ctx->query(false, true, false, false);
+  prg->set_value("depth", -0.5f);
+  front->begin();
+  vao->render(mgl::opengl::render_mode::TRIANGLE_STRIP);
+  front->end();
+
+  ctx->finish();
+  ASSERT_TRUE(behind->ready());
+  ASSERT_TRUE(front->ready());
+  ASSERT_FALSE(behind->any_samples());
+  ASSERT_TRUE(front->any_samples());
+
+  behind->release();
+  ASSERT_TRUE(behind->released());
+
+  ctx->disable(mgl::opengl::enable_flag::DEPTH_TEST);
+  ctx->release();
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
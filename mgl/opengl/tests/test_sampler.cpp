@@ -0,0 +1,98 @@
+#include "mgl_opengl/call_counter.hpp"
+#include "mgl_opengl/context.hpp"
+#include <gtest/gtest.h>
+
+TEST(SamplerTest, Cache)
+{
+  auto ctx = mgl::opengl::create_context(mgl::opengl::context_mode::STANDALONE);
+  ASSERT_NE(ctx, nullptr);
+
+  mgl::opengl::sampler::state clamp;
+  clamp.wrap_x = mgl::opengl::wrap_mode::CLAMP_TO_EDGE;
+  clamp.wrap_y = mgl::opengl::wrap_mode::CLAMP_TO_EDGE;
+
+  auto a = ctx->sampler(clamp);
+  auto b = ctx->sampler(clamp);
+  ASSERT_NE(a, nullptr);
+  ASSERT_EQ(a, b);
+  ASSERT_TRUE(a->immutable());
+  ASSERT_FALSE(a->repeat_x());
+  ASSERT_TRUE(a->repeat_z());
+  ASSERT_EQ(ctx->cached_samplers().size(), 1);
+
+  mgl::opengl::sampler::state nearest = clamp;
+  nearest.min_filter = mgl::opengl::texture_filter::NEAREST;
+  nearest.mag_filter = mgl::opengl::texture_filter::NEAREST;
+
+  auto c = ctx->sampler(nearest);
+  ASSERT_NE(a, c);
+  ASSERT_EQ(c->sampler_filter().min_filter, mgl::opengl::texture_filter::NEAREST);
+  ASSERT_EQ(ctx->cached_samplers().size(), 2);
+
+  // Anisotropy past the supported maximum is the same state as the maximum
+  mgl::opengl::sampler::state aniso = clamp;
+  aniso.anisotropy = 1000.0f;
+  mgl::opengl::sampler::state max_aniso = clamp;
+  max_aniso.anisotropy = ctx->max_anisotropy() > 0 ? ctx->max_anisotropy() : 1.0f;
+  ASSERT_EQ(ctx->sampler(aniso), ctx->sampler(max_aniso));
+
+  // A released sampler is replaced on the next request
+  a->release();
+  auto d = ctx->sampler(clamp);
+  ASSERT_FALSE(d->released());
+
+  ctx->release();
+}
+
+TEST(SamplerTest, CacheClearedOnRelease)
+{
+  auto ctx = mgl::opengl::create_context(mgl::opengl::context_mode::STANDALONE);
+  ASSERT_NE(ctx, nullptr);
+
+  auto sampler = ctx->sampler(mgl::opengl::sampler::state());
+  ASSERT_EQ(ctx->cached_samplers().size(), 1);
+
+  // The cached samplers hold the context, releasing it has to drop them
+  ctx->release();
+  ASSERT_EQ(ctx->cached_samplers().size(), 0);
+  ASSERT_TRUE(sampler->released());
+}
+
+TEST(SamplerTest, BindTracking)
+{
+  namespace calls = mgl::opengl::call_counter;
+
+  auto ctx = mgl::opengl::create_context(mgl::opengl::context_mode::STANDALONE);
+  ASSERT_NE(ctx, nullptr);
+
+  auto linear = ctx->sampler(mgl::opengl::sampler::state{});
+  auto owned = ctx->sampler();
+
+  // The bindings are unknown until something is bound
+  ctx->clear_samplers();
+
+  calls::enable();
+  calls::reset();
+
+  linear->use(0);
+  linear->use(0);
+  ASSERT_EQ(calls::count("glBindSampler"), 1);
+
+  owned->use(0);
+  linear->use(1);
+  linear->use(1);
+  ASSERT_EQ(calls::count("glBindSampler"), 3);
+
+  // Only the units holding a sampler are cleared
+  ctx->clear_samplers(0, 4);
+  ASSERT_EQ(calls::count("glBindSampler"), 5);
+
+  calls::disable();
+  ctx->release();
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,96 @@
+#include "mgl_opengl/call_counter.hpp"
+#include "mgl_opengl/context.hpp"
+#include <gtest/gtest.h>
+
+TEST(ScopeTest, BindDiffing)
+{
+  namespace calls = mgl::opengl::call_counter;
+
+  auto ctx = mgl::opengl::create_context(mgl::opengl::context_mode::STANDALONE);
+  ASSERT_NE(ctx, nullptr);
+
+  auto a = ctx->texture2d(4, 4, 4);
+  auto b = ctx->texture2d(4, 4, 4);
+  static mgl::uint8_buffer data(64);
+  auto u1 = ctx->buffer(data);
+  auto u2 = ctx->buffer(data);
+  auto fbo = ctx->framebuffer({ ctx->renderbuffer(4, 4) }, nullptr);
+
+  auto first = ctx->scope(fbo, 0, { { a, 0 }, { b, 1 } }, { { u1, 0 } });
+  auto second = ctx->scope(fbo, 0, { { a, 0 }, { b, 2 } }, { { u1, 0 }, { u2, 1 } });
+
+  calls::enable();
+
+  first->begin();
+  first->end();
+
+  // Only the bindings that differ from the ended scope are touched
+  calls::reset();
+  second->begin();
+  ASSERT_EQ(calls::count("glBindTexture"), 2);
+  ASSERT_EQ(calls::count("glBindBufferBase"), 1);
+  ASSERT_EQ(calls::count("glBindFramebuffer"), 0);
+  second->end();
+
+  // Beginning the same scope again binds nothing
+  calls::reset();
+  second->begin();
+  second->end();
+  ASSERT_EQ(calls::count("glBindTexture"), 0);
+  ASSERT_EQ(calls::count("glBindBufferBase"), 0);
+
+  // The state from before the first scope comes back on request
+  calls::reset();
+  ctx->restore_scope();
+  ASSERT_EQ(calls::count("glBindTexture"), 2);
+  ASSERT_EQ(calls::count("glBindBufferBase"), 2);
+  ASSERT_EQ(calls::count("glBindFramebuffer"), 1);
+  ASSERT_EQ(ctx->current_framebuffer().get(), &ctx->screen());
+
+  calls::reset();
+  ctx->restore_scope();
+  ASSERT_EQ(calls::count("glBindTexture"), 0);
+
+  calls::disable();
+  ctx->release();
+}
+
+TEST(ScopeTest, Nested)
+{
+  namespace calls = mgl::opengl::call_counter;
+
+  auto ctx = mgl::opengl::create_context(mgl::opengl::context_mode::STANDALONE);
+  ASSERT_NE(ctx, nullptr);
+
+  auto a = ctx->texture2d(4, 4, 4);
+  auto b = ctx->texture2d(4, 4, 4);
+  auto fbo = ctx->framebuffer({ ctx->renderbuffer(4, 4) }, nullptr);
+
+  auto outer = ctx->scope(fbo, mgl::opengl::enable_flag::BLEND, { { a, 0 } });
+  auto inner = ctx->scope(ctx->current_framebuffer(), 0, { { b, 0 } });
+
+  outer->begin();
+  inner->begin();
+  ASSERT_EQ(ctx->current_framebuffer().get(), &ctx->screen());
+
+  // The enclosing scope is applied again as soon as the nested one ends
+  calls::enable();
+  calls::reset();
+  inner->end();
+  ASSERT_EQ(ctx->current_framebuffer(), fbo);
+  ASSERT_EQ(calls::count("glBindTexture"), 1);
+  ASSERT_TRUE(ctx->enable_flags() & mgl::opengl::enable_flag::BLEND);
+  calls::disable();
+
+  outer->end();
+  ctx->restore_scope();
+  ASSERT_FALSE(ctx->enable_flags() & mgl::opengl::enable_flag::BLEND);
+
+  ctx->release();
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,150 @@
+#include "mgl_opengl/call_counter.hpp"
+#include "mgl_opengl/context.hpp"
+#include <gtest/gtest.h>
+
+TEST(TextureTest, SingleLevel)
+{
+  auto ctx = mgl::opengl::create_context(mgl::opengl::context_mode::STANDALONE);
+  ASSERT_NE(ctx, nullptr);
+
+  auto tex = ctx->texture2d(4, 4, 4);
+  ASSERT_NE(tex, nullptr);
+  ASSERT_EQ(tex->levels(), 1);
+  ASSERT_FALSE(tex->immutable());
+
+  // Mutable textures can still be redefined
+  tex->resize(8, 8);
+  ASSERT_EQ(tex->width(), 8);
+
+  ctx->release();
+}
+
+TEST(TextureTest, MipChain)
+{
+  auto ctx = mgl::opengl::create_context(mgl::opengl::context_mode::STANDALONE);
+  ASSERT_NE(ctx, nullptr);
+
+  static mgl::uint8_buffer pixels(8 * 8 * 4, 200);
+
+  auto tex = ctx->texture2d(8, 8, 4, pixels, 0, 1, "f1", 0, 0);
+  ASSERT_NE(tex, nullptr);
+  ASSERT_EQ(tex->levels(), 4);
+  ASSERT_EQ(tex->immutable(), ctx->texture_storage());
+
+  static mgl::uint8_buffer out(8 * 8 * 4);
+  tex->read(out);
+  ASSERT_EQ(out, pixels);
+
+  // Every level already exists, filling them does not redefine the storage
+  tex->build_mipmaps();
+
+  static mgl::uint8_buffer level(4 * 4 * 4);
+  tex->read(level, 1);
+  ASSERT_EQ(level, mgl::uint8_buffer(4 * 4 * 4, 200));
+
+  static mgl::uint8_buffer last = { 1, 2, 3, 4 };
+  tex->write(last, 3);
+
+  static mgl::uint8_buffer texel(4);
+  tex->read(texel, 3);
+  ASSERT_EQ(texel, last);
+
+  // A requested count past the full chain is clamped
+  auto clamped = ctx->texture2d(8, 8, 4, nullptr, 0, 1, "f1", 0, 16);
+  ASSERT_EQ(clamped->levels(), 4);
+
+  ctx->release();
+}
+
+TEST(TextureTest, OtherTargets)
+{
+  auto ctx = mgl::opengl::create_context(mgl::opengl::context_mode::STANDALONE);
+  ASSERT_NE(ctx, nullptr);
+
+  auto cube = ctx->texture_cube(16, 16, 4, nullptr, 1, "f1", 0, 0);
+  ASSERT_NE(cube, nullptr);
+  ASSERT_EQ(cube->levels(), 5);
+  ASSERT_EQ(cube->immutable(), ctx->texture_storage());
+
+  static mgl::uint8_buffer face(16 * 16 * 4, 50);
+  static mgl::uint8_buffer out(16 * 16 * 4);
+  cube->write(face, 2);
+  cube->read(out, 2);
+  ASSERT_EQ(out, face);
+  cube->build_mipmaps();
+
+  // Array layers are not part of the mip chain
+  auto array = ctx->texture_array(8, 8, 6, 4, nullptr, 1, "f1", 0);
+  ASSERT_NE(array, nullptr);
+  ASSERT_EQ(array->levels(), 4);
+  ASSERT_EQ(array->layers(), 6);
+  array->build_mipmaps();
+
+  auto volume = ctx->texture3d(8, 4, 2, 1, nullptr, 1, "f1", 0);
+  ASSERT_NE(volume, nullptr);
+  ASSERT_EQ(volume->levels(), 4);
+  volume->build_mipmaps();
+
+  ctx->release();
+}
+
+TEST(TextureTest, BindTracking)
+{
+  namespace calls = mgl::opengl::call_counter;
+
+  auto ctx = mgl::opengl::create_context(mgl::opengl::context_mode::STANDALONE);
+  ASSERT_NE(ctx, nullptr);
+
+  auto tex = ctx->texture2d(4, 4, 4);
+  ASSERT_NE(tex, nullptr);
+
+  calls::enable();
+  calls::reset();
+
+  tex->use(0);
+  tex->use(0);
+  ASSERT_EQ(calls::count("glBindTexture"), 1);
+  ASSERT_EQ(calls::count("glActiveTexture"), 1);
+
+  tex->use(1);
+  tex->use(0);
+  ASSERT_EQ(calls::count("glBindTexture"), 2);
+
+  // Still bound on the default unit since creation
+  static mgl::uint8_buffer pixels(4 * 4 * 4);
+  tex->read(pixels);
+  tex->read(pixels);
+  ASSERT_EQ(calls::count("glBindTexture"), 2);
+
+  calls::reset();
+  tex->set_filter(tex->filter());
+  tex->set_repeat_x(false);
+
+  if(ctx->direct_state_access())
+  {
+    ASSERT_EQ(calls::count("glTextureParameteri"), 3);
+    ASSERT_EQ(calls::count("glBindTexture"), 0);
+    ASSERT_EQ(calls::count("glActiveTexture"), 0);
+  }
+  else
+  {
+    ASSERT_EQ(calls::count("glTexParameteri"), 3);
+  }
+
+  // A new texture can reuse the name of a released one, it must still be bound
+  tex->release();
+  auto other = ctx->texture2d(4, 4, 4);
+
+  calls::reset();
+  other->use(0);
+  ASSERT_EQ(calls::count("glBindTexture"), 1);
+
+  calls::disable();
+  ctx->release();
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
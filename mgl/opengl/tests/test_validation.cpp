@@ -0,0 +1,68 @@
+#include "mgl_opengl/call_counter.hpp"
+#include "mgl_opengl/context.hpp"
+#include "mgl_opengl/validation.hpp"
+#include <gtest/gtest.h>
+
+TEST(ValidationTest, HotPathsDoNotPoll)
+{
+  namespace calls = mgl::opengl::call_counter;
+
+  auto ctx = mgl::opengl::create_context(mgl::opengl::context_mode::STANDALONE);
+  ASSERT_NE(ctx, nullptr);
+
+  auto rbo = ctx->renderbuffer(4, 4);
+  auto dbo = ctx->depth_renderbuffer(4, 4);
+  auto fbo = ctx->framebuffer({ rbo }, dbo);
+  ASSERT_NE(fbo, nullptr);
+
+  calls::enable();
+  calls::reset();
+
+  // Without validation nothing polls, with it the debug output reports the errors when available
+  mgl::opengl::validation::set_enabled(false);
+  fbo->use();
+  fbo->clear(0, 1, 0, 1);
+  ASSERT_EQ(calls::count("glGetError"), 0);
+
+  mgl::opengl::validation::set_enabled(true);
+  calls::reset();
+  fbo->use();
+  fbo->clear(0, 1, 0, 1);
+
+  if(ctx->version() >= 430)
+    ASSERT_EQ(calls::count("glGetError"), 0);
+
+  calls::disable();
+  ctx->release();
+}
+
+TEST(ValidationTest, ErrorsAreReported)
+{
+  auto ctx = mgl::opengl::create_context(mgl::opengl::context_mode::STANDALONE);
+  ASSERT_NE(ctx, nullptr);
+
+  mgl::opengl::validation::reset();
+  ctx->set_blend_equation((mgl::opengl::blend_equation_mode)0);
+
+  if(mgl::opengl::validation::available())
+    ASSERT_EQ(mgl::opengl::validation::error_count(), 1);
+  else
+    ASSERT_EQ(mgl::opengl::validation::error_count(), 0);
+
+  // Disabled checks report nothing, the error is not carried over to the next check either
+  mgl::opengl::validation::set_enabled(false);
+  ctx->set_blend_equation((mgl::opengl::blend_equation_mode)0);
+  mgl::opengl::validation::set_enabled(true);
+  ctx->finish();
+
+  if(mgl::opengl::validation::available())
+    ASSERT_EQ(mgl::opengl::validation::error_count(), 1);
+
+  ctx->release();
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
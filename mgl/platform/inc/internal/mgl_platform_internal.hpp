@@ -2,6 +2,7 @@
 
 #include "mgl_opengl/enums.hpp"
 #include "mgl_platform/api/enums.hpp"
+#include "mgl_platform/api/textures.hpp"
 
 namespace mgl::platform::internal
 {
@@ -13,4 +14,6 @@ namespace mgl::platform::internal
 
   mgl::opengl::compare_func to_api(mgl::platform::api::compare_func func);
 
+  mgl::opengl::texture_filter to_api(mgl::platform::api::texture::filter filter);
+
 } // namespace mgl::platform::internal
\ No newline at end of file
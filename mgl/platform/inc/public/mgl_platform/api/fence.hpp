@@ -0,0 +1,22 @@
+#pragma once
+
+#include "mgl_core/memory.hpp"
+
+namespace mgl::platform::api
+{
+  class fence;
+  using fence_ref = mgl::ref<fence>;
+
+  class fence
+  {
+public:
+    virtual ~fence() = default;
+
+    virtual void release() = 0;
+
+    virtual bool signaled() = 0;
+
+    virtual bool wait(uint64_t timeout = UINT64_MAX) = 0;
+  };
+
+} // namespace mgl::platform::api
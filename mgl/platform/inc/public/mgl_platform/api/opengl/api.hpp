@@ -46,6 +46,14 @@ private:
 
     virtual void api_set_viewport(const glm::vec2& position, const glm::vec2& size) override final;
 
+    virtual void api_set_color_mask(bool value) override final;
+
+    virtual void api_set_depth_mask(bool value) override final;
+
+    virtual write_masks api_get_write_masks() override final;
+
+    virtual void api_set_write_masks(const write_masks& masks) override final;
+
     virtual void api_clear_samplers(int32_t start = 0, int32_t end = -1) override final;
 
     virtual void api_set_blend_equation(blend_equation_mode modeRGB,
@@ -127,6 +135,10 @@ private:
 
     virtual buffer_ref api_create_buffer(size_t size, bool dynamic) override final;
 
+    virtual fence_ref api_create_fence() override final;
+
+    virtual occlusion_query_ref api_create_occlusion_query() override final;
+
     virtual program_ref api_create_program(const std::string& vs_source,
                                            const std::string& fs_source,
                                            const std::string& gs_source = "",
@@ -137,7 +149,8 @@ private:
     virtual texture_2d_ref api_create_texture_2d(int32_t width,
                                                  int32_t height,
                                                  int32_t components,
-                                                 int32_t samples = 0) override final;
+                                                 int32_t samples = 0,
+                                                 int32_t levels = 1) override final;
 
 private:
     mgl::platform::api::render_state m_state_data;
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "mgl_platform/api/fence.hpp"
+
+#include "mgl_core/debug.hpp"
+
+#include "mgl_opengl/fence.hpp"
+
+namespace mgl::platform::api::backends
+{
+  class ogl_fence;
+  using ogl_fence_ref = mgl::ref<ogl_fence>;
+
+  class ogl_fence : public mgl::platform::api::fence
+  {
+public:
+    ogl_fence();
+
+    virtual ~ogl_fence() = default;
+
+    virtual void release() override final
+    {
+      MGL_CORE_ASSERT(m_fence, "Invalid fence");
+      m_fence->release();
+    }
+
+    virtual bool signaled() override final
+    {
+      MGL_CORE_ASSERT(m_fence, "Invalid fence");
+      return m_fence->signaled();
+    }
+
+    virtual bool wait(uint64_t timeout = UINT64_MAX) override final
+    {
+      MGL_CORE_ASSERT(m_fence, "Invalid fence");
+      return m_fence->wait(timeout);
+    }
+
+private:
+    mgl::opengl::fence_ref m_fence;
+  };
+} // namespace mgl::platform::api::backends
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "mgl_platform/api/query.hpp"
+
+#include "mgl_core/debug.hpp"
+
+#include "mgl_opengl/query.hpp"
+
+namespace mgl::platform::api::backends
+{
+  class ogl_occlusion_query;
+  using ogl_occlusion_query_ref = mgl::ref<ogl_occlusion_query>;
+
+  class ogl_occlusion_query : public mgl::platform::api::occlusion_query
+  {
+public:
+    ogl_occlusion_query();
+
+    virtual ~ogl_occlusion_query() = default;
+
+    virtual void release() override final;
+
+    virtual void begin() override final
+    {
+      MGL_CORE_ASSERT(m_query, "Invalid query");
+      m_query->begin();
+    }
+
+    virtual void end() override final
+    {
+      MGL_CORE_ASSERT(m_query, "Invalid query");
+      m_query->end();
+    }
+
+    virtual void begin_render() override final
+    {
+      MGL_CORE_ASSERT(m_query, "Invalid query");
+      m_query->begin_render();
+    }
+
+    virtual void end_render() override final
+    {
+      MGL_CORE_ASSERT(m_query, "Invalid query");
+      m_query->end_render();
+    }
+
+    virtual bool ready() override final
+    {
+      MGL_CORE_ASSERT(m_query, "Invalid query");
+      return m_query->ready();
+    }
+
+    virtual bool visible() override final
+    {
+      MGL_CORE_ASSERT(m_query, "Invalid query");
+      return m_query->any_samples();
+    }
+
+private:
+    mgl::opengl::query_ref m_query;
+  };
+} // namespace mgl::platform::api::backends
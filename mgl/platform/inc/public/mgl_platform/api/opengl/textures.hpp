@@ -17,7 +17,10 @@ namespace mgl::platform::api::backends
   class ogl_texture_2d : public mgl::platform::api::texture_2d
   {
 public:
-    ogl_texture_2d(const mgl::size& size, int32_t components, int32_t samples);
+    ogl_texture_2d(const mgl::size& size,
+                   int32_t components,
+                   int32_t samples,
+                   int32_t levels = 1);
 
     virtual ~ogl_texture_2d() = default;
 
@@ -48,10 +51,16 @@ public:
       m_texture->write(src, v, lvl, align);
     }
 
+    virtual void upload_level(const uint8_t* src,
+                              size_t size,
+                              int32_t lvl,
+                              int32_t align = 1) override final;
+
     mgl::opengl::texture_2d_ref& native() { return m_texture; }
 
 private:
     friend class opengl_api;
     mgl::opengl::texture_2d_ref m_texture;
+    texture::filter m_filter;
   };
 } // namespace mgl::platform::api::backends
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "mgl_core/memory.hpp"
+
+namespace mgl::platform::api
+{
+  class occlusion_query;
+  using occlusion_query_ref = mgl::ref<occlusion_query>;
+
+  class occlusion_query
+  {
+public:
+    virtual ~occlusion_query() = default;
+
+    virtual void release() = 0;
+
+    virtual void begin() = 0;
+
+    virtual void end() = 0;
+
+    // Draws between begin_render and end_render are skipped by the GPU if no sample passed
+    virtual void begin_render() = 0;
+
+    virtual void end_render() = 0;
+
+    virtual bool ready() = 0;
+
+    virtual bool visible() = 0;
+  };
+
+} // namespace mgl::platform::api
@@ -2,10 +2,13 @@
 
 #include "buffers.hpp"
 #include "enums.hpp"
+#include "fence.hpp"
 #include "program.hpp"
+#include "query.hpp"
 #include "textures.hpp"
 #include "vertex_array.hpp"
 
+#include "mgl_core/containers.hpp"
 #include "mgl_registry/resources/image.hpp"
 
 #include "glm/glm.hpp"
@@ -29,6 +32,13 @@ namespace mgl::platform::api
     glm::mat4 projection_matrix;
   };
 
+  // Write masks of the bound framebuffer, one color mask per attachment
+  struct write_masks
+  {
+    mgl::list<glm::bvec4> color;
+    bool depth = true;
+  };
+
   class render_api;
   using render_api_ref = mgl::scope<render_api>;
 
@@ -71,6 +81,14 @@ private:
 
     virtual void api_set_viewport(const glm::vec2& position, const glm::vec2& size) = 0;
 
+    virtual void api_set_color_mask(bool value) = 0;
+
+    virtual void api_set_depth_mask(bool value) = 0;
+
+    virtual write_masks api_get_write_masks() = 0;
+
+    virtual void api_set_write_masks(const write_masks& masks) = 0;
+
     virtual void api_clear_samplers(int32_t start = 0, int32_t end = -1) = 0;
 
     virtual void api_set_blend_equation(blend_equation_mode modeRGB,
@@ -140,6 +158,10 @@ private:
 
     virtual buffer_ref api_create_buffer(size_t size, bool dynamic) = 0;
 
+    virtual fence_ref api_create_fence() = 0;
+
+    virtual occlusion_query_ref api_create_occlusion_query() = 0;
+
     virtual program_ref api_create_program(const std::string& vs_source,
                                            const std::string& fs_source,
                                            const std::string& gs_source = "",
@@ -150,7 +172,8 @@ private:
     virtual texture_2d_ref api_create_texture_2d(int32_t width,
                                                  int32_t height,
                                                  int32_t components,
-                                                 int32_t samples = 0) = 0;
+                                                 int32_t samples = 0,
+                                                 int32_t levels = 1) = 0;
 
 public:
     static bool init_api() { return render_api::instance().api_init(); }
@@ -209,6 +232,19 @@ public:
       render_api::instance().api_set_viewport(position, size);
     }
 
+    // Enables or disables the writes to every channel of every color attachment
+    static void set_color_mask(bool value) { render_api::instance().api_set_color_mask(value); }
+
+    static void set_depth_mask(bool value) { render_api::instance().api_set_depth_mask(value); }
+
+    // Saves the masks of the bound framebuffer, so a pass can change them and put them back
+    static write_masks get_write_masks() { return render_api::instance().api_get_write_masks(); }
+
+    static void set_write_masks(const write_masks& masks)
+    {
+      render_api::instance().api_set_write_masks(masks);
+    }
+
     static void clear_samplers(int32_t start = 0, int32_t end = -1)
     {
       render_api::instance().api_clear_samplers(start, end);
@@ -380,6 +416,18 @@ public:
       return texture;
     }
 
+    // Uploads every level of the chain, chains with more than one level sample their mipmaps
+    static texture_2d_ref create_texture_2d(const mgl::registry::texture_data_ref& data,
+                                            int32_t samples = 0)
+    {
+      auto tex = render_api::instance().api_create_texture_2d(
+          data->width(), data->height(), data->channels(), samples, data->level_count());
+      tex->upload(data);
+      tex->set_filter(data->level_count() > 1 ? texture::filter::LINEAR_MIPMAP_LINEAR
+                                              : texture::filter::LINEAR);
+      return tex;
+    }
+
     static index_buffer_ref
     create_index_buffer(const uint16_buffer& data, uint16_t element_size = 4, bool dynamic = false)
     {
@@ -446,6 +494,13 @@ public:
       return render_api::instance().api_create_buffer(size, dynamic);
     }
 
+    static fence_ref create_fence() { return render_api::instance().api_create_fence(); }
+
+    static occlusion_query_ref create_occlusion_query()
+    {
+      return render_api::instance().api_create_occlusion_query();
+    }
+
 protected:
     render_api() = default;
   };
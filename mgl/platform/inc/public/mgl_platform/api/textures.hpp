@@ -5,6 +5,7 @@
 #include "mgl_core/memory.hpp"
 
 #include "mgl_registry/resources/image.hpp"
+#include "mgl_registry/texture_cache.hpp"
 
 namespace mgl::platform::api
 {
@@ -66,6 +67,20 @@ public:
     virtual void
     upload(const uint8_buffer& src, const mgl::rect& v, int32_t lvl = 0, int32_t align = 1) = 0;
 
+    // Defines and fills a whole mip level, size is the byte size of the level
+    virtual void upload_level(const uint8_t* src, size_t size, int32_t lvl, int32_t align = 1) = 0;
+
+    void upload(const mgl::registry::texture_data_ref& src)
+    {
+      MGL_CORE_ASSERT(src->channels() == components(),
+                      "Texture data components do not match texture components");
+      int32_t lvl = 0;
+      for(auto& level : src->levels())
+      {
+        upload_level(level.data, level.size, lvl++);
+      }
+    }
+
     void upload(const mgl::registry::image_ref& src,
                 const mgl::rect& v,
                 int32_t lvl = 0,
@@ -2,6 +2,7 @@
 
 #include "buffers.hpp"
 #include "enums.hpp"
+#include "program.hpp"
 
 #include "mgl_core/debug.hpp"
 #include "mgl_core/memory.hpp"
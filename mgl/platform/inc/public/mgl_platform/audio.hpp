@@ -0,0 +1,115 @@
+#pragma once
+
+#include "mgl_registry/resources/music.hpp"
+#include "mgl_registry/resources/sound.hpp"
+
+#include "mgl_core/memory.hpp"
+
+#include <atomic>
+#include <thread>
+
+struct ALCdevice_struct;
+struct ALCcontext_struct;
+
+namespace mgl::platform
+{
+  struct audio_config
+  {
+    // SDL audio driver, empty picks the default one. "dummy" plays to nowhere and "disk" writes
+    // the mix to a file, both run without audio hardware.
+    std::string driver = "";
+  };
+
+  /**
+   * @brief OpenAL device and context, sources and players need one to be open.
+   */
+  class audio_device
+  {
+public:
+    audio_device(const audio_config& config = {});
+    ~audio_device();
+
+    audio_device(const audio_device&) = delete;
+    audio_device& operator=(const audio_device&) = delete;
+
+    bool is_open() const { return m_context != nullptr; }
+
+private:
+    ALCdevice_struct* m_device = nullptr;
+    ALCcontext_struct* m_context = nullptr;
+  };
+
+  using audio_device_ref = mgl::scope<audio_device>;
+
+  // Plays a fully decoded sound from a single buffer
+  class sound_source
+  {
+public:
+    sound_source(const registry::sound_ref& sound);
+    ~sound_source();
+
+    sound_source(const sound_source&) = delete;
+    sound_source& operator=(const sound_source&) = delete;
+
+    void play();
+    void stop();
+    bool playing() const;
+
+    void set_gain(float gain);
+    void set_looping(bool looping);
+
+private:
+    uint32_t m_buffer = 0;
+    uint32_t m_source = 0;
+  };
+
+  using sound_source_ref = mgl::scope<sound_source>;
+
+  /**
+   * @brief Streams a music track through a small ring of buffers.
+   *
+   * A worker thread decodes the next block whenever the source has played one, so the memory
+   * used is the ring plus the decoder window whatever the length of the track.
+   */
+  class music_player
+  {
+public:
+    static constexpr size_t BUFFER_COUNT = 4;
+    static constexpr size_t BUFFER_FRAMES = 8192;
+
+    music_player(const registry::music_ref& music);
+    ~music_player();
+
+    music_player(const music_player&) = delete;
+    music_player& operator=(const music_player&) = delete;
+
+    // Starts the track from the beginning
+    bool play(bool looping = false);
+    void stop();
+
+    // False once the track has played to its end
+    bool playing() const { return m_running; }
+
+    void set_gain(float gain);
+
+private:
+    void run();
+
+    // Decodes the next block into buffer and queues it, false at the end of the track
+    bool queue(uint32_t buffer);
+
+    registry::music_ref m_music;
+    registry::audio_stream_ref m_stream;
+    mgl::int16_buffer m_samples;
+    uint32_t m_buffers[BUFFER_COUNT] = {};
+    uint32_t m_source = 0;
+    int32_t m_format = 0;
+    bool m_looping = false;
+
+    std::atomic<bool> m_running = false;
+    std::thread m_thread;
+  };
+
+  using music_player_ref = mgl::scope<music_player>;
+
+} // namespace mgl::platform
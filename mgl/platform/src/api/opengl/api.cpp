@@ -1,6 +1,8 @@
 #include "mgl_platform/api/opengl/api.hpp"
 #include "mgl_platform/api/opengl/buffers.hpp"
+#include "mgl_platform/api/opengl/fence.hpp"
 #include "mgl_platform/api/opengl/program.hpp"
+#include "mgl_platform/api/opengl/query.hpp"
 #include "mgl_platform/api/opengl/textures.hpp"
 #include "mgl_platform/api/opengl/vertex_array.hpp"
 
@@ -110,6 +112,49 @@ namespace mgl::platform::api::backends
     m_ctx->set_viewport(position.x, position.y, size.x, size.y);
   }
 
+  void ogl_api::api_set_color_mask(bool value)
+  {
+    MGL_CORE_ASSERT(m_ctx != nullptr, "[OpenGL API] Context is null.");
+    auto& fb = m_ctx->current_framebuffer();
+    MGL_CORE_ASSERT(fb != nullptr, "[OpenGL API] No framebuffer bound.");
+    fb->set_color_mask(mgl::opengl::color_masks(
+        fb->color_mask().size(), mgl::opengl::color_mask(value, value, value, value)));
+  }
+
+  void ogl_api::api_set_depth_mask(bool value)
+  {
+    MGL_CORE_ASSERT(m_ctx != nullptr, "[OpenGL API] Context is null.");
+    auto& fb = m_ctx->current_framebuffer();
+    MGL_CORE_ASSERT(fb != nullptr, "[OpenGL API] No framebuffer bound.");
+    fb->set_depth_mask(value);
+  }
+
+  write_masks ogl_api::api_get_write_masks()
+  {
+    MGL_CORE_ASSERT(m_ctx != nullptr, "[OpenGL API] Context is null.");
+    auto& fb = m_ctx->current_framebuffer();
+    MGL_CORE_ASSERT(fb != nullptr, "[OpenGL API] No framebuffer bound.");
+
+    write_masks masks;
+    for(auto& mask : fb->color_mask())
+      masks.color.push_back(glm::bvec4(mask.r, mask.g, mask.b, mask.a));
+    masks.depth = fb->depth_mask();
+    return masks;
+  }
+
+  void ogl_api::api_set_write_masks(const write_masks& masks)
+  {
+    MGL_CORE_ASSERT(m_ctx != nullptr, "[OpenGL API] Context is null.");
+    auto& fb = m_ctx->current_framebuffer();
+    MGL_CORE_ASSERT(fb != nullptr, "[OpenGL API] No framebuffer bound.");
+
+    mgl::opengl::color_masks color;
+    for(auto& mask : masks.color)
+      color.push_back(mgl::opengl::color_mask(mask.r, mask.g, mask.b, mask.a));
+    fb->set_color_mask(color);
+    fb->set_depth_mask(masks.depth);
+  }
+
   void ogl_api::api_clear_samplers(int32_t start, int32_t end)
   {
     MGL_CORE_ASSERT(m_ctx != nullptr, "[OpenGL API] Context is null.");
@@ -338,6 +383,18 @@ namespace mgl::platform::api::backends
     return nullptr;
   }
 
+  fence_ref ogl_api::api_create_fence()
+  {
+    MGL_CORE_ASSERT(m_ctx != nullptr, "[OpenGL API] Context is null.");
+    return mgl::create_ref<ogl_fence>();
+  }
+
+  occlusion_query_ref ogl_api::api_create_occlusion_query()
+  {
+    MGL_CORE_ASSERT(m_ctx != nullptr, "[OpenGL API] Context is null.");
+    return mgl::create_ref<ogl_occlusion_query>();
+  }
+
   program_ref ogl_api::api_create_program(const std::string& vs_source,
                                           const std::string& fs_source,
                                           const std::string& gs_source,
@@ -352,10 +409,12 @@ namespace mgl::platform::api::backends
   }
 
   texture_2d_ref
-  ogl_api::api_create_texture_2d(int32_t width, int32_t height, int32_t components, int32_t samples)
+  ogl_api::api_create_texture_2d(
+      int32_t width, int32_t height, int32_t components, int32_t samples, int32_t levels)
   {
     MGL_CORE_ASSERT(m_ctx != nullptr, "[OpenGL API] Context is null.");
-    return mgl::create_ref<ogl_texture_2d>(mgl::size{ width, height }, components, samples);
+    return mgl::create_ref<ogl_texture_2d>(
+        mgl::size{ width, height }, components, samples, levels);
   }
 
 }; // namespace mgl::platform::api::backends
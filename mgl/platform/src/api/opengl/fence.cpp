@@ -0,0 +1,14 @@
+#include "mgl_platform/api/opengl/fence.hpp"
+#include "mgl_platform/api/opengl/api.hpp"
+
+namespace mgl::platform::api::backends
+{
+
+  ogl_fence::ogl_fence()
+  {
+    mgl::opengl::context_ref& ctx = mgl::platform::api::backends::ogl_api::current_context();
+    m_fence = ctx->fence();
+    MGL_CORE_ASSERT(m_fence, "Failed to create fence");
+  }
+
+} // namespace mgl::platform::api::backends
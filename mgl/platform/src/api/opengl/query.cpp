@@ -0,0 +1,21 @@
+#include "mgl_platform/api/opengl/query.hpp"
+#include "mgl_platform/api/opengl/api.hpp"
+
+namespace mgl::platform::api::backends
+{
+
+  ogl_occlusion_query::ogl_occlusion_query()
+  {
+    mgl::opengl::context_ref& ctx = mgl::platform::api::backends::ogl_api::current_context();
+    m_query = ctx->query(false, true, false, false);
+    MGL_CORE_ASSERT(m_query, "Failed to create query");
+  }
+
+  void ogl_occlusion_query::release()
+  {
+    MGL_CORE_ASSERT(m_query, "Invalid query");
+    if(!m_query->released())
+      m_query->release();
+  }
+
+} // namespace mgl::platform::api::backends
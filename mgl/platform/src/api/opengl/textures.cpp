@@ -5,22 +5,49 @@
 
 #include "mgl_core/debug.hpp"
 
+#include "mgl_platform_internal.hpp"
+
+#include <algorithm>
+
 namespace mgl::platform::api::backends
 {
-  ogl_texture_2d::ogl_texture_2d(const mgl::size& size, int32_t components, int32_t samples)
+  ogl_texture_2d::ogl_texture_2d(const mgl::size& size,
+                                 int32_t components,
+                                 int32_t samples,
+                                 int32_t levels)
   {
     mgl::opengl::context_ref& ctx = mgl::platform::api::backends::ogl_api::current_context();
-    m_texture = ctx->texture2d(size.width, size.height, components, nullptr, samples);
+    m_texture = ctx->texture2d(
+        size.width, size.height, components, nullptr, samples, 1, "f1", 0, levels);
+    m_filter = texture::filter::NEAREST;
   }
 
   const texture::filter& ogl_texture_2d::get_filter() const
   {
-    MGL_CORE_ASSERT(false, "Not implemented");
-    return texture::filter::NEAREST;
+    return m_filter;
   }
 
   void ogl_texture_2d::set_filter(const texture::filter& value)
   {
-    MGL_CORE_ASSERT(false, "Not implemented");
+    int32_t min_filter = internal::to_api(value);
+
+    // Magnification has no mipmaps, it keeps the nearest or linear part of the filter
+    int32_t mag_filter = value == texture::filter::NEAREST ||
+                                 value == texture::filter::NEAREST_MIPMAP_NEAREST ||
+                                 value == texture::filter::NEAREST_MIPMAP_LINEAR
+                             ? mgl::opengl::texture_filter::NEAREST
+                             : mgl::opengl::texture_filter::LINEAR;
+
+    m_texture->set_filter({ min_filter, mag_filter });
+    m_filter = value;
+  }
+
+  void ogl_texture_2d::upload_level(const uint8_t* src, size_t size, int32_t lvl, int32_t align)
+  {
+    MGL_CORE_ASSERT(src != nullptr, "Invalid texture data");
+    MGL_CORE_ASSERT(size == (size_t)std::max(m_texture->width() >> lvl, 1) *
+                                std::max(m_texture->height() >> lvl, 1) * m_texture->components(),
+                    "Invalid texture level size");
+    m_texture->write_level(src, lvl, align);
   }
 } // namespace mgl::platform::api::backends
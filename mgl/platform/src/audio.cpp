@@ -0,0 +1,274 @@
+#include "mgl_platform/audio.hpp"
+
+#include "mgl_core/debug.hpp"
+#include "mgl_core/log.hpp"
+
+#include "AL/al.h"
+#include "AL/alc.h"
+#include "SDL.h"
+
+#include <chrono>
+
+namespace mgl::platform
+{
+  // How often the player checks for played buffers, well below the length of one buffer
+  static constexpr auto REFILL_INTERVAL = std::chrono::milliseconds(10);
+
+  static ALenum to_format(int32_t channels)
+  {
+    switch(channels)
+    {
+      case 1: return AL_FORMAT_MONO16;
+      case 2: return AL_FORMAT_STEREO16;
+      default: return 0;
+    }
+  }
+
+  audio_device::audio_device(const audio_config& config)
+  {
+    // mojoAL mixes through SDL, the driver is picked when the audio subsystem starts
+    if(!config.driver.empty())
+      SDL_setenv("SDL_AUDIODRIVER", config.driver.c_str(), 1);
+
+    m_device = alcOpenDevice(nullptr);
+    if(m_device == nullptr)
+    {
+      MGL_CORE_ERROR("audio: failed to open device");
+      return;
+    }
+
+    m_context = alcCreateContext(m_device, nullptr);
+    if(m_context == nullptr || !alcMakeContextCurrent(m_context))
+    {
+      MGL_CORE_ERROR("audio: failed to create context");
+
+      if(m_context != nullptr)
+        alcDestroyContext(m_context);
+
+      alcCloseDevice(m_device);
+      m_context = nullptr;
+      m_device = nullptr;
+    }
+  }
+
+  audio_device::~audio_device()
+  {
+    if(m_context != nullptr)
+    {
+      alcMakeContextCurrent(nullptr);
+      alcDestroyContext(m_context);
+    }
+
+    if(m_device != nullptr)
+      alcCloseDevice(m_device);
+  }
+
+  sound_source::sound_source(const registry::sound_ref& sound)
+  {
+    MGL_CORE_ASSERT(sound != nullptr, "Sound is null");
+
+    ALenum format = to_format(sound->channels());
+    if(format == 0)
+    {
+      MGL_CORE_ERROR("audio: unsupported number of channels: {}", sound->channels());
+      return;
+    }
+
+    auto& samples = sound->samples();
+
+    alGenBuffers(1, &m_buffer);
+    alBufferData(m_buffer,
+                 format,
+                 samples.data(),
+                 static_cast<ALsizei>(samples.size() * sizeof(int16_t)),
+                 sound->sample_rate());
+
+    alGenSources(1, &m_source);
+    alSourcei(m_source, AL_BUFFER, static_cast<ALint>(m_buffer));
+  }
+
+  sound_source::~sound_source()
+  {
+    if(m_source != 0)
+    {
+      alSourceStop(m_source);
+      alDeleteSources(1, &m_source);
+    }
+
+    if(m_buffer != 0)
+      alDeleteBuffers(1, &m_buffer);
+  }
+
+  void sound_source::play()
+  {
+    if(m_source != 0)
+      alSourcePlay(m_source);
+  }
+
+  void sound_source::stop()
+  {
+    if(m_source != 0)
+      alSourceStop(m_source);
+  }
+
+  bool sound_source::playing() const
+  {
+    if(m_source == 0)
+      return false;
+
+    ALint state = 0;
+    alGetSourcei(m_source, AL_SOURCE_STATE, &state);
+    return state == AL_PLAYING;
+  }
+
+  void sound_source::set_gain(float gain)
+  {
+    if(m_source != 0)
+      alSourcef(m_source, AL_GAIN, gain);
+  }
+
+  void sound_source::set_looping(bool looping)
+  {
+    if(m_source != 0)
+      alSourcei(m_source, AL_LOOPING, looping ? AL_TRUE : AL_FALSE);
+  }
+
+  music_player::music_player(const registry::music_ref& music)
+      : m_music(music)
+  {
+    MGL_CORE_ASSERT(music != nullptr, "Music is null");
+
+    m_format = to_format(music->channels());
+    if(m_format == 0)
+    {
+      MGL_CORE_ERROR("audio: unsupported number of channels: {}", music->channels());
+      return;
+    }
+
+    m_samples.resize(BUFFER_FRAMES * music->channels());
+
+    alGenBuffers(BUFFER_COUNT, m_buffers);
+    alGenSources(1, &m_source);
+  }
+
+  music_player::~music_player()
+  {
+    stop();
+
+    if(m_source != 0)
+    {
+      alDeleteSources(1, &m_source);
+      alDeleteBuffers(BUFFER_COUNT, m_buffers);
+    }
+  }
+
+  bool music_player::play(bool looping)
+  {
+    stop();
+
+    if(m_source == 0)
+      return false;
+
+    m_stream = m_music->open();
+    if(m_stream == nullptr)
+    {
+      MGL_CORE_ERROR("audio: failed to open music: {}", m_music->path());
+      return false;
+    }
+
+    m_looping = looping;
+
+    for(auto buffer : m_buffers)
+    {
+      if(!queue(buffer))
+        break;
+    }
+
+    alSourcePlay(m_source);
+
+    m_running = true;
+    m_thread = std::thread(&music_player::run, this);
+    return true;
+  }
+
+  void music_player::stop()
+  {
+    m_running = false;
+
+    if(m_thread.joinable())
+      m_thread.join();
+
+    if(m_source != 0)
+    {
+      // Detaches every queued buffer, played or not
+      alSourceStop(m_source);
+      alSourcei(m_source, AL_BUFFER, 0);
+    }
+
+    m_stream.reset();
+  }
+
+  void music_player::set_gain(float gain)
+  {
+    if(m_source != 0)
+      alSourcef(m_source, AL_GAIN, gain);
+  }
+
+  bool music_player::queue(uint32_t buffer)
+  {
+    size_t frames = m_stream->read(m_samples.data(), BUFFER_FRAMES);
+
+    if(frames < BUFFER_FRAMES && m_looping && m_stream->rewind())
+    {
+      frames += m_stream->read(m_samples.data() + frames * m_music->channels(),
+                               BUFFER_FRAMES - frames);
+    }
+
+    if(frames == 0)
+      return false;
+
+    alBufferData(buffer,
+                 m_format,
+                 m_samples.data(),
+                 static_cast<ALsizei>(frames * m_music->channels() * sizeof(int16_t)),
+                 m_music->sample_rate());
+    alSourceQueueBuffers(m_source, 1, &buffer);
+    return true;
+  }
+
+  void music_player::run()
+  {
+    while(m_running)
+    {
+      ALint processed = 0;
+      alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &processed);
+
+      while(processed-- > 0)
+      {
+        ALuint buffer = 0;
+        alSourceUnqueueBuffers(m_source, 1, &buffer);
+        queue(buffer);
+      }
+
+      ALint state = 0;
+      ALint queued = 0;
+      alGetSourcei(m_source, AL_SOURCE_STATE, &state);
+      alGetSourcei(m_source, AL_BUFFERS_QUEUED, &queued);
+
+      if(state != AL_PLAYING)
+      {
+        // Nothing left to play is the end of the track, otherwise the ring ran dry
+        if(queued == 0)
+        {
+          m_running = false;
+          break;
+        }
+
+        alSourcePlay(m_source);
+      }
+
+      std::this_thread::sleep_for(REFILL_INTERVAL);
+    }
+  }
+
+} // namespace mgl::platform
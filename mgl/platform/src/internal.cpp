@@ -47,6 +47,15 @@ namespace mgl::platform::internal
     mgl::opengl::render_mode::TRIANGLE_FAN,
   };
 
+  const static mgl::opengl::texture_filter s_texture_filter[] = {
+    mgl::opengl::texture_filter::NEAREST,
+    mgl::opengl::texture_filter::LINEAR,
+    mgl::opengl::texture_filter::NEAREST_MIPMAP_NEAREST,
+    mgl::opengl::texture_filter::LINEAR_MIPMAP_NEAREST,
+    mgl::opengl::texture_filter::NEAREST_MIPMAP_LINEAR,
+    mgl::opengl::texture_filter::LINEAR_MIPMAP_LINEAR,
+  };
+
   mgl::opengl::compare_func to_api(mgl::platform::api::compare_func func)
   {
     return s_compare_func[static_cast<int>(func)];
@@ -62,6 +71,11 @@ namespace mgl::platform::internal
     return s_blend_equation_mode[static_cast<int>(mode)];
   }
 
+  mgl::opengl::texture_filter to_api(mgl::platform::api::texture::filter filter)
+  {
+    return s_texture_filter[static_cast<int>(filter)];
+  }
+
   mgl::opengl::render_mode to_api(mgl::platform::api::render_mode mode)
   {
     return s_render_mode[static_cast<int>(mode)];
@@ -0,0 +1,100 @@
+#include "mgl_platform/audio.hpp"
+#include "mgl_registry/registry.hpp"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <thread>
+
+// Half a second of a mono 440 Hz tone
+static void write_tone(const mgl::path& path)
+{
+  const uint32_t rate = 22050;
+  const uint32_t frames = rate / 2;
+  const uint32_t size = frames * 2;
+
+  std::ofstream file(path, std::ios::binary);
+  auto put = [&](uint32_t value, size_t bytes) {
+    file.write(reinterpret_cast<const char*>(&value), bytes);
+  };
+
+  file.write("RIFF", 4);
+  put(36 + size, 4);
+  file.write("WAVEfmt ", 8);
+  put(16, 4);
+  put(1, 2);
+  put(1, 2);
+  put(rate, 4);
+  put(rate * 2, 4);
+  put(2, 2);
+  put(16, 2);
+  file.write("data", 4);
+  put(size, 4);
+
+  for(uint32_t i = 0; i < frames; i++)
+  {
+    auto sample = static_cast<int16_t>(16000 * std::sin(2 * 3.14159265f * 440 * i / rate));
+    put(static_cast<uint16_t>(sample), 2);
+  }
+}
+
+class mgl_test_audio : public ::testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    write_tone(std::filesystem::temp_directory_path() / "mgl_test_audio.wav");
+    mgl::registry::register_location(mgl::registry::resource::type::sound,
+                                     "file://" + std::filesystem::temp_directory_path().string());
+    mgl::registry::register_location(mgl::registry::resource::type::music,
+                                     "file://" + std::filesystem::temp_directory_path().string());
+  }
+
+  static void TearDownTestSuite()
+  {
+    std::filesystem::remove(std::filesystem::temp_directory_path() / "mgl_test_audio.wav");
+  }
+
+  // The dummy driver mixes in real time without audio hardware
+  mgl::platform::audio_device device = mgl::platform::audio_config{ "dummy" };
+};
+
+TEST_F(mgl_test_audio, sound_source)
+{
+  ASSERT_TRUE(device.is_open());
+
+  auto sound = mgl::registry::load_sound("mgl_test_audio.wav", mgl::registry::loader_options());
+  ASSERT_NE(sound, nullptr);
+
+  mgl::platform::sound_source source(sound);
+  source.play();
+  EXPECT_TRUE(source.playing());
+  source.stop();
+  EXPECT_FALSE(source.playing());
+}
+
+TEST_F(mgl_test_audio, music_player)
+{
+  ASSERT_TRUE(device.is_open());
+
+  auto music = mgl::registry::load_music("mgl_test_audio.wav", mgl::registry::loader_options());
+  ASSERT_NE(music, nullptr);
+
+  mgl::platform::music_player player(music);
+  ASSERT_TRUE(player.play());
+  EXPECT_TRUE(player.playing());
+
+  // The track is shorter than the timeout, the player stops once it has been streamed
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while(player.playing() && std::chrono::steady_clock::now() < deadline)
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  EXPECT_FALSE(player.playing());
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
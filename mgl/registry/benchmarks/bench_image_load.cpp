@@ -0,0 +1,102 @@
+#include "mgl_core/io.hpp"
+#include "mgl_registry/loaders/image.hpp"
+#include "mgl_registry/locations/local.hpp"
+#include "mgl_registry/locations/pak.hpp"
+#include "mgl_registry/pak.hpp"
+#include "mgl_registry/resources/image.hpp"
+
+#include "stb/stb_image.hpp"
+#include "stb/stb_image_write.h"
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+// Compares the image loader against the previous decode path, which read the whole file into a
+// temporary buffer, decoded it with stbi_load_from_memory and copied the pixels into the image.
+
+static const int ITERATIONS = 5;
+static const int SIZE = 4096;
+
+static double measure(const std::function<void()>& fn)
+{
+  fn();
+  auto start = std::chrono::steady_clock::now();
+  for(int i = 0; i < ITERATIONS; i++)
+    fn();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count() / ITERATIONS;
+}
+
+static mgl::registry::image_ref load_previous(const mgl::path& path)
+{
+  auto file = mgl::io::open_read(path);
+  file->seekg(0, std::ios::end);
+  size_t size = file->tellg();
+  file->seekg(0, std::ios::beg);
+
+  unsigned char* raw = new unsigned char[size];
+  file->read((char*)raw, size);
+  int width, height, components;
+  auto data = stbi_load_from_memory(raw, size, &width, &height, &components, 0);
+  delete[] raw;
+
+  auto pixels = mgl::uint8_buffer(data, data + width * height * components);
+  stbi_image_free(data);
+  return mgl::create_ref<mgl::registry::image>(width, height, components, pixels);
+}
+
+int main(int argc, char** argv)
+{
+  auto root = std::filesystem::temp_directory_path() / "mgl_bench_image_load";
+  std::filesystem::create_directories(root);
+
+  // Smooth gradients with some noise, close enough to real textures for the codecs
+  mgl::uint8_buffer pixels((size_t)SIZE * SIZE * 4);
+  uint32_t seed = 1;
+  for(size_t i = 0; i < pixels.size(); i++)
+  {
+    seed = seed * 1664525u + 1013904223u;
+    size_t p = i / 4;
+    pixels[i] = static_cast<uint8_t>((p % SIZE + p / SIZE + (i % 4) * 64) / 8 + (seed >> 29));
+  }
+
+  stbi_write_png((root / "image.png").string().c_str(), SIZE, SIZE, 4, pixels.data(), 0);
+  stbi_write_jpg((root / "image.jpg").string().c_str(), SIZE, SIZE, 3, pixels.data(), 90);
+
+  mgl::registry::pak::writer writer;
+  for(auto name : { "image.png", "image.jpg" })
+  {
+    mgl::uint8_buffer data(std::filesystem::file_size(root / name));
+    auto stream = mgl::io::open_read(root / name);
+    mgl::io::read_uint8_buffer(stream, data);
+    writer.add(name, data, false);
+  }
+  writer.write(root / "images.pak");
+
+  mgl::registry::local_location local_factory;
+  mgl::registry::pak_location pak_factory;
+  auto local = local_factory.factory(mgl::registry::url("file://" + root.string()));
+  auto pak = pak_factory.factory(mgl::registry::url("file://" + (root / "images.pak").string()));
+
+  mgl::registry::loaders::image_loader loader;
+  mgl::registry::loaders::image_loader_options options;
+
+  std::cout << "image load, " << SIZE << "x" << SIZE << ", average of " << ITERATIONS << " runs"
+            << std::endl;
+
+  for(auto name : { "image.png", "image.jpg" })
+  {
+    double previous = measure([&]() { load_previous(root / name); });
+    double streamed = measure([&]() { loader.load(local, name, options); });
+    double mapped = measure([&]() { loader.load(pak, name, options); });
+
+    std::cout << name << ": previous " << previous << " ms, streamed " << streamed
+              << " ms, mapped pak " << mapped << " ms" << std::endl;
+  }
+
+  local.reset();
+  pak.reset();
+  std::filesystem::remove_all(root);
+  return 0;
+}
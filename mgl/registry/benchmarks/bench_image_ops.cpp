@@ -0,0 +1,114 @@
+#include "mgl_registry/image_ops.hpp"
+#include "mgl_registry/resources/image.hpp"
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+// Throughput of the image operations, the per pixel loops are the implementations they replaced
+
+namespace image_ops = mgl::registry::image_ops;
+
+static const int ITERATIONS = 10;
+static const int32_t SIZE = 4096;
+
+static void report(const char* name, size_t bytes, const std::function<void()>& fn)
+{
+  fn();
+  auto start = std::chrono::steady_clock::now();
+  for(int i = 0; i < ITERATIONS; i++)
+    fn();
+  auto end = std::chrono::steady_clock::now();
+
+  double seconds = std::chrono::duration<double>(end - start).count() / ITERATIONS;
+  std::cout << name << ": " << seconds * 1000.0 << " ms, " << bytes / seconds / (1 << 20)
+            << " MiB/s" << std::endl;
+}
+
+static void previous_flip_horizontally(const uint8_t* src, uint8_t* dst, int32_t channels)
+{
+  for(int32_t i = 0; i < SIZE; ++i)
+    for(int32_t j = 0; j < SIZE; ++j)
+      std::copy(src + i * SIZE * channels + j * channels,
+                src + i * SIZE * channels + j * channels + channels,
+                dst + i * SIZE * channels + (SIZE - j - 1) * channels);
+}
+
+static void previous_fill(uint8_t* dst, const uint8_t* pixel, int32_t channels)
+{
+  for(int32_t i = 0; i < SIZE * SIZE; ++i)
+    std::copy(pixel, pixel + channels, dst + i * channels);
+}
+
+static void previous_crop(const uint8_t* src, uint8_t* dst, int32_t width, int32_t channels)
+{
+  for(int32_t i = 0; i < width; ++i)
+    for(int32_t j = 0; j < width; ++j)
+      std::copy(src + i * SIZE * channels + j * channels,
+                src + i * SIZE * channels + j * channels + channels,
+                dst + i * width * channels + j * channels);
+}
+
+int main(int argc, char** argv)
+{
+  std::cout << "image ops, " << SIZE << "x" << SIZE << ", backend " << image_ops::backend()
+            << std::endl;
+
+  const size_t pixels = (size_t)SIZE * SIZE;
+  mgl::uint8_buffer src(pixels * 4, 0x80);
+  mgl::uint8_buffer dst(pixels * 4);
+  const uint8_t pixel[4] = { 1, 2, 3, 4 };
+  const uint8_t order[4] = { 2, 1, 0, 3 };
+
+  for(int32_t channels : { 1, 3, 4 })
+  {
+    std::cout << channels << " channels" << std::endl;
+    size_t bytes = pixels * channels;
+
+    report("  flip horizontally, previous", bytes, [&]() {
+      previous_flip_horizontally(src.data(), dst.data(), channels);
+    });
+    report("  flip horizontally", bytes, [&]() {
+      for(int32_t i = 0; i < SIZE; i++)
+        image_ops::reverse_row(src.data() + i * SIZE * channels,
+                               dst.data() + i * SIZE * channels,
+                               SIZE,
+                               channels);
+    });
+    report("  flip vertically", bytes, [&]() {
+      image_ops::flip_vertically(dst.data(), SIZE, SIZE, channels);
+    });
+
+    report("  crop half, previous", bytes / 4, [&]() {
+      previous_crop(src.data(), dst.data(), SIZE / 2, channels);
+    });
+    report("  crop half", bytes / 4, [&]() {
+      image_ops::copy_rect(src.data(),
+                           SIZE * channels,
+                           dst.data(),
+                           SIZE / 2 * channels,
+                           SIZE / 2 * channels,
+                           SIZE / 2);
+    });
+
+    report("  fill, previous", bytes, [&]() { previous_fill(dst.data(), pixel, channels); });
+    report("  fill", bytes, [&]() { image_ops::fill(dst.data(), pixels, pixel, channels); });
+
+    if(channels >= 3)
+    {
+      report("  swizzle", bytes, [&]() {
+        image_ops::swizzle(dst.data(), pixels, channels, order);
+      });
+    }
+
+    report("  expand to rgba", pixels * 4, [&]() {
+      image_ops::expand_to_rgba(src.data(), dst.data(), pixels, channels);
+    });
+  }
+
+  report("premultiply alpha", pixels * 4, [&]() {
+    image_ops::premultiply_alpha(dst.data(), pixels, 4);
+  });
+
+  return 0;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "mgl_registry/location.hpp"
+
+#include "mgl_core/io.hpp"
+#include "mgl_core/memory.hpp"
+
+namespace mgl::registry
+{
+  class audio_stream;
+  using audio_stream_ref = mgl::scope<audio_stream>;
+
+  /**
+   * @brief Incremental decoder of a WAV or Ogg Vorbis file into interleaved 16 bit samples.
+   *
+   * Only a small window of the file and the last decoded block are held, the memory used does
+   * not depend on the length of the track.
+   */
+  class audio_stream
+  {
+public:
+    virtual ~audio_stream() = default;
+
+    int32_t channels() const { return m_channels; }
+    int32_t sample_rate() const { return m_sample_rate; }
+
+    // Decodes up to frames frames into out, returns the frames decoded, 0 at the end
+    virtual size_t read(int16_t* out, size_t frames) = 0;
+
+    // Restarts the stream from the first frame
+    virtual bool rewind() = 0;
+
+    // Bytes held by the decoder, the input window and decoded block included
+    virtual size_t memory_size() const = 0;
+
+    // Returns null if the data is not a PCM WAV or an Ogg Vorbis stream
+    static audio_stream_ref open(const io::istream_ref& stream);
+    static audio_stream_ref open(const location_ref& location, const std::string& path);
+
+protected:
+    int32_t m_channels = 0;
+    int32_t m_sample_rate = 0;
+  };
+
+} // namespace mgl::registry
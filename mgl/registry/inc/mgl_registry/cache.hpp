@@ -0,0 +1,88 @@
+#pragma once
+#include "resource.hpp"
+
+#include "mgl_core/containers.hpp"
+#include "mgl_core/memory.hpp"
+
+#include <list>
+#include <unordered_map>
+#include <mutex>
+
+namespace mgl::registry
+{
+  /**
+   * @brief Deduplicating cache of loaded resources with a memory budget.
+   *
+   * Resources are kept alive by the cache while they fit in the budget, the least recently used
+   * ones are evicted first. An evicted resource is still tracked through a weak reference, so a
+   * resource that is in use somewhere else is handed out again instead of being loaded twice.
+   */
+  class resource_cache
+  {
+public:
+    struct key
+    {
+      resource::type type;
+      std::string path;
+      size_t options;
+
+      bool operator==(const key& other) const = default;
+    };
+
+    struct key_hash
+    {
+      size_t operator()(const key& k) const;
+    };
+
+    struct stats
+    {
+      size_t hits = 0;
+      size_t misses = 0;
+      size_t evictions = 0;
+      size_t entries = 0;
+      size_t bytes = 0;
+    };
+
+    resource_cache(size_t budget = 256 * 1024 * 1024);
+
+    ~resource_cache() = default;
+
+    resource_ref get(const key& k);
+
+    void put(const key& k, const resource_ref& resource);
+
+    void remove(const key& k);
+
+    // Removes the entries of a resource loaded with any options
+    void remove(resource::type type, const std::string& path);
+
+    void clear();
+
+    void set_budget(size_t budget);
+
+    size_t budget() const { return m_budget; }
+
+    stats get_stats() const;
+
+    void reset_stats();
+
+private:
+    struct entry
+    {
+      resource_ref strong;
+      mgl::weak_ref<resource> weak;
+      size_t bytes;
+      std::list<key>::iterator lru;
+    };
+
+    void release(entry& e);
+    void evict();
+
+    mutable std::mutex m_mutex;
+    size_t m_budget;
+    stats m_stats;
+    std::list<key> m_lru;
+    std::unordered_map<key, entry, key_hash> m_entries;
+  };
+
+} // namespace mgl::registry
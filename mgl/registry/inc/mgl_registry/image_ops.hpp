@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Row based pixel operations used by mgl::registry::image.
+ *
+ * Pixels are interleaved 8 bit channels, any channel count from 1 to 4 is accepted. The hot paths
+ * use SSE2/SSSE3/AVX2 or NEON when the compiler targets them, everything else runs the scalar
+ * fallback, results are identical on every path.
+ */
+namespace mgl::registry::image_ops
+{
+  // Name of the widest instruction set compiled in, e.g. "avx2", "sse2", "neon" or "scalar"
+  const char* backend();
+
+  /**
+   * Copies rows of pixels between two buffers, strides are in bytes and can be negative, which
+   * copies the rows in reverse order.
+   */
+  void copy_rect(const uint8_t* src,
+                 ptrdiff_t src_stride,
+                 uint8_t* dst,
+                 ptrdiff_t dst_stride,
+                 size_t row_bytes,
+                 int32_t rows);
+
+  // Writes the pixels of src into dst in reverse order, the buffers must not overlap
+  void reverse_row(const uint8_t* src, uint8_t* dst, int32_t width, int32_t channels);
+
+  void flip_vertically(uint8_t* data, int32_t width, int32_t height, int32_t channels);
+
+  void flip_horizontally(uint8_t* data, int32_t width, int32_t height, int32_t channels);
+
+  // Sets count pixels to the value of pixel, which holds channels bytes
+  void fill(uint8_t* data, size_t count, const uint8_t* pixel, int32_t channels);
+
+  // Reorders channels in place, channel c of each pixel becomes channel order[c]
+  void swizzle(uint8_t* data, size_t count, int32_t channels, const uint8_t* order);
+
+  /**
+   * Converts pixels to RGBA. One channel is grey, two channels are grey and alpha, the same
+   * convention stb_image uses, missing alpha becomes opaque.
+   */
+  void expand_to_rgba(const uint8_t* src, uint8_t* dst, size_t count, int32_t channels);
+
+  // Multiplies the color channels by alpha, alpha is the last channel so channels must be 2 or 4
+  void premultiply_alpha(uint8_t* data, size_t count, int32_t channels);
+
+} // namespace mgl::registry::image_ops
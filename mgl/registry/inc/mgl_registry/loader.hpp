@@ -9,6 +9,15 @@ namespace mgl::registry
   struct loader_options
   {
     virtual ~loader_options() = default;
+
+    // Loads with options that hash the same share the same cached resource
+    virtual size_t hash() const { return 0; }
+
+    // Asynchronous loads keep their own copy of the options
+    virtual mgl::ref<loader_options> clone() const
+    {
+      return mgl::create_ref<loader_options>(*this);
+    }
   };
 
   class loader
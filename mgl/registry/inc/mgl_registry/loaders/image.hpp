@@ -14,6 +14,16 @@ namespace mgl::registry::loaders
     bool flip_horizontally = false;
 
     virtual ~image_loader_options() = default;
+
+    virtual mgl::ref<loader_options> clone() const override
+    {
+      return mgl::create_ref<image_loader_options>(*this);
+    }
+
+    virtual size_t hash() const override
+    {
+      return (flip_vertically ? 1 : 0) | (flip_horizontally ? 2 : 0);
+    }
   };
 
   class image_loader : public loader
@@ -29,5 +39,8 @@ public:
     virtual resource_ref load(const location_ref& location,
                               const std::string& path,
                               const loader_options& options) override;
+
+    // Decodes an encoded image held in memory, e.g. bytes that were already read for hashing
+    static image_ref decode(const uint8_t* data, size_t size, const image_loader_options& options);
   };
 } // namespace mgl::registry::loaders
\ No newline at end of file
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "mgl_registry/loader.hpp"
-#include "mgl_registry/resources/sound.hpp"
+#include "mgl_registry/resources/music.hpp"
 
 namespace mgl::registry::loaders
 {
@@ -11,6 +11,11 @@ namespace mgl::registry::loaders
   struct music_loader_options : public loader_options
   {
     virtual ~music_loader_options() = default;
+
+    virtual mgl::ref<loader_options> clone() const override
+    {
+      return mgl::create_ref<music_loader_options>(*this);
+    }
   };
 
   class music_loader : public loader
@@ -20,5 +25,11 @@ public:
     virtual ~music_loader() = default;
 
     virtual resource::type get_type() const override { return resource::type::music; }
+
+    virtual mgl::string_list get_extensions() const override;
+
+    virtual resource_ref load(const location_ref& location,
+                              const std::string& path,
+                              const loader_options& options) override;
   };
-} // namespace mgl::registry::loaders
\ No newline at end of file
+} // namespace mgl::registry::loaders
@@ -11,6 +11,11 @@ namespace mgl::registry::loaders
   struct palette_loader_options : public loader_options
   {
     virtual ~palette_loader_options() = default;
+
+    virtual mgl::ref<loader_options> clone() const override
+    {
+      return mgl::create_ref<palette_loader_options>(*this);
+    }
   };
 
   class palette_loader : public loader
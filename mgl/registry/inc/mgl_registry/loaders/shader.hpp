@@ -16,6 +16,27 @@ namespace mgl::registry::loaders
 
     shader_loader_options() = default;
     virtual ~shader_loader_options() = default;
+
+    virtual mgl::ref<loader_options> clone() const override
+    {
+      return mgl::create_ref<shader_loader_options>(*this);
+    }
+
+    virtual size_t hash() const override
+    {
+      size_t seed = 0;
+      mgl::hash_combine(seed, static_cast<int>(type));
+      for(auto& [name, value] : defines)
+      {
+        mgl::hash_combine(seed, name);
+        mgl::hash_combine(seed, value);
+      }
+      for(auto& output : outputs)
+      {
+        mgl::hash_combine(seed, output);
+      }
+      return seed;
+    }
   };
 
   class shader_loader : public loader
@@ -24,7 +45,7 @@ public:
     shader_loader() = default;
     virtual ~shader_loader() = default;
 
-    virtual resource::type get_type() const override { return resource::type::image; }
+    virtual resource::type get_type() const override { return resource::type::shader; }
 
     virtual mgl::string_list get_extensions() const override;
 
@@ -11,6 +11,11 @@ namespace mgl::registry::loaders
   struct sound_loader_options : public loader_options
   {
     virtual ~sound_loader_options() = default;
+
+    virtual mgl::ref<loader_options> clone() const override
+    {
+      return mgl::create_ref<sound_loader_options>(*this);
+    }
   };
 
   class sound_loader : public loader
@@ -20,5 +25,11 @@ public:
     virtual ~sound_loader() = default;
 
     virtual resource::type get_type() const override { return resource::type::sound; }
+
+    virtual mgl::string_list get_extensions() const override;
+
+    virtual resource_ref load(const location_ref& location,
+                              const std::string& path,
+                              const loader_options& options) override;
   };
 } // namespace mgl::registry::loaders
@@ -12,6 +12,11 @@ namespace mgl::registry::loaders
   {
     text_loader_options() = default;
     virtual ~text_loader_options() = default;
+
+    virtual mgl::ref<loader_options> clone() const override
+    {
+      return mgl::create_ref<text_loader_options>(*this);
+    }
   };
 
   class text_loader : public loader
@@ -20,7 +25,7 @@ public:
     text_loader() = default;
     virtual ~text_loader() = default;
 
-    virtual resource::type get_type() const override { return resource::type::image; }
+    virtual resource::type get_type() const override { return resource::type::text; }
 
     virtual mgl::string_list get_extensions() const override;
 
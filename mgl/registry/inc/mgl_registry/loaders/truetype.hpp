@@ -10,6 +10,11 @@ namespace mgl::registry::loaders
   struct font_loader_options : public loader_options
   {
     virtual ~font_loader_options() = default;
+
+    virtual mgl::ref<loader_options> clone() const override
+    {
+      return mgl::create_ref<font_loader_options>(*this);
+    }
   };
 
   class font_loader : public loader
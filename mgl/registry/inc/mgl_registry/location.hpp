@@ -5,6 +5,10 @@
 #include "mgl_core/string.hpp"
 #include "mgl_core/utils.hpp"
 
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+
 namespace mgl::registry
 {
   class location;
@@ -37,10 +41,38 @@ public:
     virtual const std::string& kind() const = 0;
   };
 
+  /**
+   * Hashed set of the relative paths available in a location.
+   *
+   * Lookups can run concurrently with a rebuild, paths are normalized so "a/./b" and "a/b" match.
+   */
+  class path_index
+  {
+public:
+    void assign(mgl::list<std::string>&& paths);
+
+    void insert(const std::string& path);
+
+    void invalidate();
+
+    bool valid() const;
+
+    bool contains(const std::string& path) const;
+
+    size_t size() const;
+
+    static std::string normalize(const std::string& path);
+
+private:
+    mutable std::shared_mutex m_mutex;
+    std::unordered_set<std::string> m_paths;
+    bool m_valid = false;
+  };
+
   class location
   {
 public:
-    ~location() = default;
+    virtual ~location() = default;
 
     bool is_null() const { return m_path.empty(); }
 
@@ -56,6 +88,14 @@ public:
 
     virtual bool exists(const std::string& path) const = 0;
 
+    // Rebuilds the path index, exists() probes the location directly until it has been built
+    virtual void refresh() { }
+
+    virtual bool is_indexed() const { return m_index.valid(); }
+
+    // Brings the bytes of path into memory ahead of a load, returns the number of bytes
+    virtual size_t prefetch(const std::string& path) const;
+
     virtual bool operator==(const location& other) const;
 
 protected:
@@ -73,6 +113,9 @@ protected:
 
     void set_path(const mgl::path& path) { m_path = path; }
 
+    // Mutable so watched locations can rebuild it from exists()
+    mutable path_index m_index;
+
 private:
     mgl::path m_path;
   };
@@ -3,6 +3,8 @@
 #include "mgl_core/io.hpp"
 #include "mgl_registry/location.hpp"
 
+#include <mutex>
+
 namespace mgl::registry
 {
   class local_location : public location, public location_factory
@@ -12,6 +14,8 @@ public:
         : location(std::string())
     { }
 
+    ~local_location();
+
     virtual io::istream_ref open_read(const std::string& path,
                                       io::openmode mode = io::binary) override final;
 
@@ -25,6 +29,12 @@ public:
 
     virtual bool exists(const std::string& path) const override final;
 
+    virtual size_t prefetch(const std::string& path) const override final;
+
+    virtual void refresh() override final;
+
+    bool is_watched() const { return m_watch; }
+
     virtual bool can_handle(const url& url) const override final;
 
     virtual location_ref factory(const url& url) const override final;
@@ -32,10 +42,19 @@ public:
     virtual const std::string& kind() const override final;
 
 protected:
-    local_location(const std::string& path)
-        : local_location(mgl::path(path))
+    local_location(const std::string& path, bool watch = false)
+        : local_location(mgl::path(path), watch)
     { }
 
-    local_location(const mgl::path& path);
+    local_location(const mgl::path& path, bool watch = false);
+
+private:
+    void build_index() const;
+    void poll_changes() const;
+
+    // Set with a "file://path?watch" url, only supported on Linux through inotify
+    bool m_watch = false;
+    mutable int m_watch_fd = -1;
+    mutable std::mutex m_watch_mutex;
   };
 } // namespace mgl::registry
\ No newline at end of file
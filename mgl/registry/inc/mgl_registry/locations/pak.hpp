@@ -0,0 +1,72 @@
+#pragma once
+
+#include "mgl_core/io.hpp"
+#include "mgl_core/mapped_file.hpp"
+#include "mgl_registry/location.hpp"
+#include "mgl_registry/pak.hpp"
+
+namespace mgl::registry
+{
+  class pak_location : public location, public location_factory
+  {
+public:
+    pak_location()
+        : location(std::string())
+    { }
+
+    virtual io::istream_ref open_read(const std::string& path,
+                                      io::openmode mode = io::binary) override final;
+
+    virtual io::ostream_ref open_write(const std::string& path,
+                                       io::openmode mode = io::binary) override final;
+
+    virtual void read(const std::string& path, mgl::uint8_buffer& buffer) const override final;
+
+    virtual void write(const std::string& path,
+                       const mgl::uint8_buffer& buffer) const override final;
+
+    virtual bool exists(const std::string& path) const override final;
+
+    virtual size_t prefetch(const std::string& path) const override final;
+
+    // Remaps the archive, the entry table is used in place as the index
+    virtual void refresh() override final;
+
+    virtual bool is_indexed() const override final;
+
+    virtual bool can_handle(const url& url) const override final;
+
+    virtual location_ref factory(const url& url) const override final;
+
+    virtual const std::string& kind() const override final;
+
+    /**
+     * Returns the bytes of an uncompressed entry straight from the mapped archive.
+     * The pointer stays valid while the returned mapping is alive.
+     */
+    mgl::mapped_file_ref view(const std::string& path, const uint8_t*& data, size_t& size) const;
+
+protected:
+    pak_location(const std::string& path)
+        : pak_location(mgl::path(path))
+    { }
+
+    pak_location(const mgl::path& path);
+
+private:
+    struct archive
+    {
+      mgl::mapped_file_ref file;
+      const pak::entry* entries = nullptr;
+      const char* names = nullptr;
+      uint32_t entry_count = 0;
+
+      const pak::entry* find(const std::string& path) const;
+    };
+
+    archive current() const;
+
+    mutable std::shared_mutex m_mutex;
+    archive m_archive;
+  };
+} // namespace mgl::registry
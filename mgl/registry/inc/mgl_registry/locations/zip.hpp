@@ -25,6 +25,8 @@ public:
 
     virtual bool exists(const std::string& path) const override final;
 
+    virtual void refresh() override final;
+
     virtual bool can_handle(const url& url) const override final;
 
     virtual location_ref factory(const url& url) const override final;
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "mgl_registry/resource.hpp"
+
+#include "mgl_core/containers.hpp"
+#include "mgl_core/memory.hpp"
+#include "mgl_core/string.hpp"
+#include "mgl_core/utils.hpp"
+
+namespace mgl::registry
+{
+  class manifest;
+  using manifest_ref = mgl::ref<manifest>;
+
+  /**
+   * @brief Assets needed by each stage of an application, so they can be prefetched.
+   *
+   *   {
+   *     "stages": {
+   *       "boot": [
+   *         { "type": "font", "path": "ui.ttf" },
+   *         { "type": "image", "path": "ui/atlas.png" }
+   *       ]
+   *     }
+   *   }
+   *
+   * Types are the names returned by resource::type_name().
+   */
+  class manifest
+  {
+public:
+    struct asset
+    {
+      resource::type type;
+      std::string path;
+    };
+
+    // Returns null if the document is not a valid manifest
+    static manifest_ref parse(const std::string& json);
+
+    static manifest_ref load(const mgl::path& path);
+
+    mgl::string_list stages() const;
+
+    bool has_stage(const std::string& stage) const { return m_stages.contains(stage); }
+
+    // Assets of a stage in the order they are listed, empty if the stage does not exist
+    const mgl::list<asset>& assets(const std::string& stage) const;
+
+private:
+    mgl::unordered_map<std::string, mgl::list<asset>> m_stages;
+  };
+
+} // namespace mgl::registry
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "mgl_core/memory.hpp"
+#include "mgl_core/utils.hpp"
+
+#include <string_view>
+
+namespace mgl::registry::pak
+{
+  /**
+   * Layout of a pak archive, all values are little endian:
+   *
+   *   header
+   *   blobs, each one starting on a 16 byte boundary
+   *   entry table, sorted by name hash
+   *   names, not null terminated
+   *
+   * Lookups binary search the entry table straight from the mapped file, raw blobs can be used in
+   * place and LZ4 blobs are decompressed on read.
+   */
+  static constexpr uint32_t MAGIC = 0x4B41504D; // "MPAK"
+  static constexpr uint32_t VERSION = 1;
+  static constexpr size_t ALIGNMENT = 16;
+
+  enum class compression : uint32_t
+  {
+    none = 0,
+    lz4 = 1,
+  };
+
+  struct header
+  {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t names_size;
+    uint64_t entries_offset;
+    uint64_t names_offset;
+  };
+
+  struct entry
+  {
+    uint64_t hash;
+    uint64_t offset;
+    uint64_t stored_size;
+    uint64_t size;
+    uint32_t name_offset;
+    uint32_t name_size;
+    compression method;
+    uint32_t reserved;
+  };
+
+  static_assert(sizeof(header) == 32, "pak header layout changed");
+  static_assert(sizeof(entry) == 48, "pak entry layout changed");
+
+  // FNV-1a of the normalized entry name
+  uint64_t hash(std::string_view name);
+
+  class writer
+  {
+public:
+    /**
+     * Adds an entry, names are normalized the same way as location lookups.
+     * When compress is set the blob is stored with LZ4 only if that saves at least 1/8 of it,
+     * raw blobs can be used without a copy so small gains are not worth the decompression.
+     */
+    void add(const std::string& name, const mgl::uint8_buffer& data, bool compress = true);
+
+    bool write(const mgl::path& path) const;
+
+    size_t size() const { return m_items.size(); }
+
+private:
+    struct item
+    {
+      std::string name;
+      mgl::uint8_buffer data;
+      compression method;
+      uint64_t size;
+    };
+
+    mgl::list<item> m_items;
+  };
+
+} // namespace mgl::registry::pak
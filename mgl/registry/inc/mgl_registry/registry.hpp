@@ -1,4 +1,5 @@
 #pragma once
+#include "cache.hpp"
 #include "loader.hpp"
 #include "loaders/image.hpp"
 #include "loaders/music.hpp"
@@ -8,6 +9,7 @@
 #include "loaders/text.hpp"
 #include "loaders/truetype.hpp"
 #include "location.hpp"
+#include "manifest.hpp"
 #include "resource.hpp"
 #include "resources/font.hpp"
 #include "resources/image.hpp"
@@ -16,13 +18,36 @@
 #include "resources/shader.hpp"
 #include "resources/sound.hpp"
 #include "resources/text.hpp"
+#include "shader_preprocessor.hpp"
+#include "texture_cache.hpp"
 
 #include "mgl_core/io.hpp"
 #include "mgl_core/memory.hpp"
 #include "mgl_core/string.hpp"
+#include "mgl_core/thread_pool.hpp"
+
+#include <functional>
+#include <future>
+#include <mutex>
+#include <shared_mutex>
 
 namespace mgl::registry
 {
+  using resource_future = std::shared_future<resource_ref>;
+  using resource_list = mgl::list<resource_ref>;
+  using load_callback = std::function<void(const resource_ref&)>;
+  using load_many_callback = std::function<void(const resource_list&)>;
+
+  // Number of bytes brought into memory
+  using prefetch_future = std::shared_future<size_t>;
+
+  struct load_request
+  {
+    resource::type type;
+    std::string path;
+    mgl::ref<loader_options> options = nullptr;
+  };
+
   class registry
   {
 public:
@@ -33,10 +58,49 @@ public:
     bool register_loader(loader_ref& loader);
 
     resource_ref load(resource::type type, const std::string& path, const loader_options& options);
+
+    // Reads and decodes on the worker pool, callbacks run in dispatch_completions()
+    resource_future load_async(resource::type type,
+                               const std::string& path,
+                               const loader_options& options,
+                               const load_callback& on_complete = nullptr);
+
+    mgl::list<resource_future> load_many(const mgl::list<load_request>& requests,
+                                         const load_many_callback& on_complete = nullptr);
+
+    size_t dispatch_completions();
+
+    /**
+     * Brings the bytes of the assets of a stage into memory on a worker thread, so the loads made
+     * after, e.g. once the window and context exist, do not wait on the disk. Nothing is decoded
+     * and assets that cannot be found are skipped.
+     */
+    prefetch_future prefetch(const manifest& manifest, const std::string& stage);
+    prefetch_future prefetch(const mgl::list<manifest::asset>& assets);
+
+    void wait();
     const location_ref find(resource::type type, const std::string& path);
 
     bool exists(const std::string& path) const;
 
+    // Rebuilds the path index of every registered location
+    void refresh();
+
+    resource_cache& cache() { return m_cache; }
+
+    // Upload ready mip chain of an image, stored in the texture cache once a directory is set
+    texture_data_ref load_texture(const std::string& path, const texture_options& options = {});
+
+    void set_texture_cache(const mgl::path& directory) { m_textures.set_directory(directory); }
+
+    texture_cache& textures() { return m_textures; }
+
+    // Parsed shader includes and the files every loaded shader was expanded from
+    shader_preprocessor& includes() { return m_includes; }
+
+    // Drops a changed include and the cached shaders using it, returns their paths to reload
+    mgl::string_list invalidate_include(const std::string& path);
+
     static registry& current_registry()
     {
       static registry s_registry;
@@ -59,9 +123,26 @@ private:
     using loader_info_ref = mgl::ref<loader_info>;
     using location_factory_info_ref = mgl::ref<location_factory_info>;
 
+    mgl::thread_pool& pool();
+    void post_completion(std::function<void()> completion);
+
     mgl::unordered_map<std::string, loader_info_ref> m_loaders;
     mgl::unordered_map<std::string, location_factory_info_ref> m_locations_factories;
+    // Locations are looked up from the worker pool while the main thread may register more
+    mutable std::shared_mutex m_locations_mutex;
     mgl::unordered_map<resource::type, locations> m_locations;
+    resource_cache m_cache;
+
+    // Decodes in progress, concurrent misses on the same key wait on the first one
+    std::mutex m_loading_mutex;
+    std::unordered_map<resource_cache::key, resource_future, resource_cache::key_hash> m_loading;
+    texture_cache m_textures;
+    shader_preprocessor m_includes;
+
+    std::mutex m_pool_mutex;
+    mgl::scope<mgl::thread_pool> m_pool;
+    std::mutex m_completions_mutex;
+    mgl::list<std::function<void()>> m_completions;
   };
 
   using registry_ref = mgl::scope<registry>;
@@ -77,6 +158,30 @@ private:
     return current_registry().load(type, path, options);
   }
 
+  inline resource_future load_async(resource::type type,
+                                    const std::string& path,
+                                    const loader_options& options,
+                                    const load_callback& on_complete = nullptr)
+  {
+    return current_registry().load_async(type, path, options, on_complete);
+  }
+
+  inline mgl::list<resource_future> load_many(const mgl::list<load_request>& requests,
+                                              const load_many_callback& on_complete = nullptr)
+  {
+    return current_registry().load_many(requests, on_complete);
+  }
+
+  inline size_t dispatch_completions()
+  {
+    return current_registry().dispatch_completions();
+  }
+
+  inline prefetch_future prefetch(const manifest& manifest, const std::string& stage)
+  {
+    return current_registry().prefetch(manifest, stage);
+  }
+
   inline image_ref load_image(const std::string& path, const loader_options& options)
   {
     return std::dynamic_pointer_cast<image>(
@@ -113,11 +218,36 @@ private:
         current_registry().load(resource::type::music, path, options));
   }
 
+  inline texture_data_ref load_texture(const std::string& path, const texture_options& options = {})
+  {
+    return current_registry().load_texture(path, options);
+  }
+
+  inline void set_texture_cache(const mgl::path& directory)
+  {
+    current_registry().set_texture_cache(directory);
+  }
+
+  inline mgl::string_list invalidate_include(const std::string& path)
+  {
+    return current_registry().invalidate_include(path);
+  }
+
+  inline resource_cache& cache()
+  {
+    return current_registry().cache();
+  }
+
   inline const location_ref find(resource::type type, const std::string& path)
   {
     return current_registry().find(type, path);
   }
 
+  inline void refresh()
+  {
+    current_registry().refresh();
+  }
+
   inline bool register_location(resource::type type, const std::string& path)
   {
     return current_registry().register_location(type, path);
@@ -2,6 +2,9 @@
 
 #include "mgl_core/memory.hpp"
 
+#include <array>
+#include <string>
+
 namespace mgl::registry
 {
 
@@ -37,5 +40,36 @@ public:
     virtual ~resource() = default;
 
     virtual type get_type() const = 0;
+
+    // Approximate memory held by the resource, used by the cache budget
+    virtual size_t memory_size() const { return 0; }
+
+    static const std::string& type_name(type t)
+    {
+      return type_names()[static_cast<size_t>(t)];
+    }
+
+    // Returns false if name is not the name of a type
+    static bool type_from_name(const std::string& name, type& t)
+    {
+      auto& names = type_names();
+      for(size_t i = 0; i < names.size(); i++)
+      {
+        if(names[i] == name)
+        {
+          t = static_cast<type>(i);
+          return true;
+        }
+      }
+      return false;
+    }
+
+private:
+    static const std::array<std::string, 8>& type_names()
+    {
+      static const std::array<std::string, 8> s_names = { "image", "palette", "shader", "font",
+                                                          "sound", "music",   "text",   "custom" };
+      return s_names;
+    }
   };
 } // namespace mgl::registry
\ No newline at end of file
@@ -15,6 +15,8 @@ public:
     truetype_font(const uint8_t* data, size_t size);
     virtual ~truetype_font();
 
+    virtual size_t memory_size() const override final { return m_data.size(); }
+
     virtual int32_t get_ascent() const override final { return m_ascent; }
 
     virtual int32_t get_descent() const override final { return m_descent; }
@@ -7,6 +7,8 @@
 
 #include "glm/glm.hpp"
 
+#include <array>
+
 namespace mgl::registry
 {
   class image_loader;
@@ -35,12 +37,15 @@ public:
 
     virtual resource::type get_type() const override { return resource::type::image; }
 
+    virtual size_t memory_size() const override { return m_data.size(); }
+
     int32_t width() const { return m_width; }
     int32_t height() const { return m_height; }
     int32_t channels() const { return m_channels; }
     mgl::uint8_buffer& buffer() { return m_data; }
     unsigned char* data() { return m_data.data(); }
 
+    // Parts of rect outside of either image are clipped, x and y can be negative
     void blit(int32_t x, int32_t y, const image& image, const mgl::rect& rect);
     void blit(int32_t x, int32_t y, const image& image)
     {
@@ -62,6 +67,14 @@ public:
 
     image_ref clone() const;
 
+    // Grey, grey alpha and RGB images are expanded with opaque alpha
+    image_ref to_rgba() const;
+
+    // Channel c of each pixel becomes channel order[c], e.g. { 2, 1, 0, 3 } swaps BGRA and RGBA
+    void swizzle(const std::array<uint8_t, 4>& order);
+
+    void premultiply_alpha();
+
     void resize(int32_t width, int32_t height);
     void resize(glm::vec2 size) { resize(size.x, size.y); }
 
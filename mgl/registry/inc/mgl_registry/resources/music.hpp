@@ -1,15 +1,35 @@
 #pragma once
 
 #include "mgl_core/memory.hpp"
+#include "mgl_registry/audio_stream.hpp"
+#include "mgl_registry/location.hpp"
 #include "mgl_registry/resource.hpp"
 
 namespace mgl::registry
 {
   class music_loader;
 
+  class music;
+  using music_ref = mgl::ref<music>;
+
+  /**
+   * @brief A track that is decoded while it plays.
+   *
+   * Only the format is read at load time, every player opens its own stream over the file.
+   */
   class music : public resource
   {
 public:
+    music(const location_ref& location,
+          const std::string& path,
+          int32_t channels,
+          int32_t sample_rate)
+        : m_location(location)
+        , m_path(path)
+        , m_channels(channels)
+        , m_sample_rate(sample_rate)
+    { }
+
     virtual ~music() = default;
 
     music(const music&) = delete;
@@ -18,8 +38,18 @@ public:
     music& operator=(music&&) = delete;
 
     virtual resource::type get_type() const override { return resource::type::music; }
-  };
 
-  using music_ref = mgl::ref<music>;
+    int32_t channels() const { return m_channels; }
+    int32_t sample_rate() const { return m_sample_rate; }
+    const std::string& path() const { return m_path; }
+
+    audio_stream_ref open() const { return audio_stream::open(m_location, m_path); }
+
+private:
+    location_ref m_location;
+    std::string m_path;
+    int32_t m_channels;
+    int32_t m_sample_rate;
+  };
 
-} // namespace mgl::registry
\ No newline at end of file
+} // namespace mgl::registry
@@ -14,8 +14,6 @@ namespace mgl::registry
 
   class shader : public resource
   {
-    friend class shader_loader;
-
 public:
     enum type
     {
@@ -28,7 +26,8 @@ public:
       GENERIC_PROGRAM
     };
 
-    shader(const std::string& source, shader::type type);
+    // files maps the source string numbers of #line directives in source back to file paths
+    shader(const std::string& source, shader::type type, const mgl::string_list& files = {});
     ~shader() = default;
 
     shader(const shader&) = delete;
@@ -38,11 +37,15 @@ public:
 
     virtual resource::type get_type() const override { return resource::type::shader; }
 
+    virtual size_t memory_size() const override { return m_source.size(); }
+
     const std::string source(shader::type type, const shader_defines& defines = {});
     const std::string source(const shader_defines& defines = {});
 
     const mgl::string_list outputs();
 
+    const mgl::string_list& files() const { return m_files; }
+
     const std::string vertex(const shader_defines& defines = {});
     const std::string fragment(const shader_defines& defines = {});
     const std::string geometry(const shader_defines& defines = {});
@@ -50,12 +53,12 @@ public:
     const std::string tess_evaluation(const shader_defines& defines = {});
 
 private:
-    bool handle_includes(const location_ref& location, int depth = 0, int source_id = 0);
-
     std::string m_source;
     int m_version;
+    int m_first_line;
     shader::type m_type;
     mgl::string_list m_attributes;
+    mgl::string_list m_files;
   };
 
 } // namespace mgl::registry
\ No newline at end of file
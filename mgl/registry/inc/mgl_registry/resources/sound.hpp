@@ -7,9 +7,19 @@ namespace mgl::registry
 {
   class sound_loader;
 
+  class sound;
+  using sound_ref = mgl::ref<sound>;
+
+  // A short clip decoded at load time into interleaved 16 bit samples
   class sound : public resource
   {
 public:
+    sound(int32_t channels, int32_t sample_rate, mgl::int16_buffer samples)
+        : m_channels(channels)
+        , m_sample_rate(sample_rate)
+        , m_samples(std::move(samples))
+    { }
+
     virtual ~sound() = default;
 
     sound(const sound&) = delete;
@@ -18,8 +28,18 @@ public:
     sound& operator=(sound&&) = delete;
 
     virtual resource::type get_type() const override { return resource::type::sound; }
-  };
 
-  using sound_ref = mgl::ref<sound>;
+    virtual size_t memory_size() const override { return m_samples.size() * sizeof(int16_t); }
+
+    int32_t channels() const { return m_channels; }
+    int32_t sample_rate() const { return m_sample_rate; }
+    size_t frames() const { return m_samples.size() / m_channels; }
+    const mgl::int16_buffer& samples() const { return m_samples; }
+
+private:
+    int32_t m_channels;
+    int32_t m_sample_rate;
+    mgl::int16_buffer m_samples;
+  };
 
 } // namespace mgl::registry
@@ -25,6 +25,8 @@ public:
 
     virtual resource::type get_type() const override { return resource::type::text; }
 
+    virtual size_t memory_size() const override { return m_data.size(); }
+
     const std::string data() const { return m_data; }
 
 private:
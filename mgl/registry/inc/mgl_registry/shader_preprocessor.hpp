@@ -0,0 +1,95 @@
+#pragma once
+
+#include "mgl_registry/location.hpp"
+
+#include "mgl_core/containers.hpp"
+#include "mgl_core/memory.hpp"
+#include "mgl_core/string.hpp"
+
+#include <shared_mutex>
+#include <unordered_set>
+
+namespace mgl::registry
+{
+  /**
+   * @brief Expands #include directives in shader sources.
+   *
+   * Every file is split once into text runs and include directives, parsed files are cached by
+   * path and shared by all the shaders that include them. The files each shader was expanded from
+   * are recorded, so the shaders that have to be rebuilt when a header changes can be looked up.
+   *
+   * GLSL only accepts a number as the source string of a #line directive, expanded sources number
+   * their files in the order they are first included, 0 being the shader itself, and errors
+   * reported as "id(line)" can be mapped back through result::files.
+   */
+  class shader_preprocessor
+  {
+public:
+    struct result
+    {
+      std::string source;
+
+      // Indexed by the source string number used in #line directives
+      mgl::string_list files;
+    };
+
+    /**
+     * @brief Expands the includes of a shader.
+     *
+     * Include paths are looked up next to the including file first and then from the root of the
+     * location. Including a file that is already being expanded is an error.
+     */
+    bool preprocess(const location_ref& location,
+                    const std::string& path,
+                    const std::string& source,
+                    result& out);
+
+    // Shaders that include file, directly or through other includes
+    mgl::string_list dependents(const std::string& file) const;
+
+    // Files a shader was expanded from, not including the shader itself
+    mgl::string_list dependencies(const std::string& shader) const;
+
+    // Drops the cached file so it is read again on next use, returns dependents(file)
+    mgl::string_list invalidate(const std::string& file);
+
+    void clear();
+
+    size_t cached_files() const;
+
+    // Key of a file in the cache and the dependency graph
+    static std::string file_key(const location_ref& location, const std::string& path);
+
+private:
+    struct chunk
+    {
+      // Lines of text, or the path of an include directive when include is set
+      std::string text;
+      int32_t line;
+      bool include;
+    };
+
+    using parsed_file = mgl::list<chunk>;
+    using parsed_file_ref = mgl::ref<const parsed_file>;
+
+    struct expansion
+    {
+      const location_ref& location;
+      result& out;
+      mgl::unordered_map<std::string, int32_t> ids;
+      mgl::string_list stack;
+    };
+
+    static parsed_file_ref parse(const std::string& source);
+
+    parsed_file_ref open(const location_ref& location, const std::string& path);
+
+    bool expand(expansion& state, const parsed_file& file, const std::string& path, int32_t id);
+
+    mutable std::shared_mutex m_mutex;
+    mgl::unordered_map<std::string, parsed_file_ref> m_files;
+    mgl::unordered_map<std::string, mgl::string_list> m_dependencies;
+    mgl::unordered_map<std::string, std::unordered_set<std::string>> m_dependents;
+  };
+
+} // namespace mgl::registry
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "mgl_registry/resources/image.hpp"
+
+#include "mgl_core/memory.hpp"
+#include "mgl_core/utils.hpp"
+
+namespace mgl::registry
+{
+  class texture_data;
+  using texture_data_ref = mgl::ref<texture_data>;
+
+  struct texture_options
+  {
+    // Color channels are multiplied by alpha, images without alpha are left as they are
+    bool premultiply_alpha = true;
+
+    // Pixels are sRGB encoded, premultiplication and mip filtering are done in linear space
+    bool srgb = false;
+
+    bool mipmaps = true;
+    bool flip_vertically = false;
+
+    size_t hash() const
+    {
+      return (premultiply_alpha ? 1 : 0) | (srgb ? 2 : 0) | (mipmaps ? 4 : 0) |
+             (flip_vertically ? 8 : 0);
+    }
+  };
+
+  /**
+   * @brief Upload ready mip chain of an image.
+   *
+   * Levels point into a single blob, either built in memory or mapped from the texture cache, the
+   * blob is kept alive for as long as the texture data is.
+   */
+  class texture_data
+  {
+public:
+    struct level
+    {
+      int32_t width;
+      int32_t height;
+      const uint8_t* data;
+      size_t size;
+    };
+
+    texture_data(int32_t channels,
+                 const texture_options& options,
+                 mgl::list<level>&& levels,
+                 const mgl::ref<const void>& storage)
+        : m_channels(channels)
+        , m_options(options)
+        , m_levels(std::move(levels))
+        , m_storage(storage)
+    { }
+
+    int32_t width() const { return m_levels.front().width; }
+    int32_t height() const { return m_levels.front().height; }
+    int32_t channels() const { return m_channels; }
+    bool srgb() const { return m_options.srgb; }
+    bool premultiplied() const { return m_options.premultiply_alpha; }
+
+    const mgl::list<level>& levels() const { return m_levels; }
+    size_t level_count() const { return m_levels.size(); }
+
+private:
+    int32_t m_channels;
+    texture_options m_options;
+    mgl::list<level> m_levels;
+    mgl::ref<const void> m_storage;
+  };
+
+  /**
+   * @brief Derived asset cache of upload ready textures.
+   *
+   * The first load of a source image decodes it, premultiplies it, builds the full mip chain on
+   * the CPU and stores the result as a blob named after the hash of the source bytes and the
+   * options. Later loads map that blob and skip decoding entirely. The cache is disabled until a
+   * directory is set, in that case chains are built in memory on every load.
+   */
+  class texture_cache
+  {
+public:
+    // Decodes the source bytes, only called on a cache miss
+    using decoder = std::function<image_ref(const uint8_t* data, size_t size)>;
+
+    texture_cache() = default;
+
+    void set_directory(const mgl::path& directory);
+
+    const mgl::path& directory() const { return m_directory; }
+
+    bool enabled() const { return !m_directory.empty(); }
+
+    texture_data_ref
+    load(const uint8_t* source, size_t size, const texture_options& options, const decoder& decode);
+
+    // Removes every blob stored in the cache directory
+    void clear();
+
+    static texture_data_ref build(const image_ref& source, const texture_options& options);
+
+    static uint64_t key(const uint8_t* source, size_t size, const texture_options& options);
+
+private:
+    mgl::path m_directory;
+  };
+
+} // namespace mgl::registry
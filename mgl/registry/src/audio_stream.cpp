@@ -0,0 +1,426 @@
+#include "mgl_registry/audio_stream.hpp"
+
+#include "mgl_core/debug.hpp"
+#include "mgl_core/log.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#define STB_VORBIS_NO_PULLDATA_API 1
+#include "stb/stb_vorbis.h"
+
+namespace mgl::registry
+{
+  // Bytes read from the file at a time
+  static constexpr size_t INPUT_BLOCK = 16 * 1024;
+
+  static uint32_t read_u32(const uint8_t* data)
+  {
+    return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+  }
+
+  static uint16_t read_u16(const uint8_t* data)
+  {
+    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+  }
+
+  static int16_t to_int16(float sample)
+  {
+    return static_cast<int16_t>(std::clamp(sample, -1.0f, 1.0f) * 32767.0f);
+  }
+
+  class wav_stream : public audio_stream
+  {
+public:
+    wav_stream(const io::istream_ref& stream)
+        : m_stream(stream)
+    { }
+
+    bool open();
+
+    virtual size_t read(int16_t* out, size_t frames) override;
+
+    virtual bool rewind() override;
+
+    virtual size_t memory_size() const override { return m_input.capacity(); }
+
+private:
+    enum class encoding
+    {
+      pcm,
+      ieee_float
+    };
+
+    io::istream_ref m_stream;
+    encoding m_encoding = encoding::pcm;
+    int32_t m_bits = 0;
+    size_t m_frame_size = 0;
+    std::streamoff m_data_begin = 0;
+    size_t m_data_frames = 0;
+    size_t m_position = 0;
+    mgl::uint8_buffer m_input;
+  };
+
+  bool wav_stream::open()
+  {
+    uint8_t header[40];
+
+    if(!m_stream->read(reinterpret_cast<char*>(header), 12) ||
+       std::memcmp(header, "RIFF", 4) != 0 || std::memcmp(header + 8, "WAVE", 4) != 0)
+    {
+      MGL_CORE_ERROR("audio_stream: not a RIFF/WAVE file");
+      return false;
+    }
+
+    bool has_format = false;
+
+    while(m_stream->read(reinterpret_cast<char*>(header), 8))
+    {
+      uint32_t size = read_u32(header + 4);
+
+      if(std::memcmp(header, "data", 4) == 0)
+      {
+        if(!has_format)
+          break;
+
+        m_data_begin = m_stream->tellg();
+        m_data_frames = size / m_frame_size;
+        m_position = 0;
+        return true;
+      }
+
+      if(std::memcmp(header, "fmt ", 4) == 0 && size >= 16)
+      {
+        uint32_t length = std::min<uint32_t>(size, sizeof(header));
+        if(!m_stream->read(reinterpret_cast<char*>(header), length))
+          break;
+
+        uint16_t format = read_u16(header);
+
+        // WAVE_FORMAT_EXTENSIBLE stores the format in the first bytes of the sub format guid
+        if(format == 0xFFFE && length >= 26)
+          format = read_u16(header + 24);
+
+        m_channels = read_u16(header + 2);
+        m_sample_rate = static_cast<int32_t>(read_u32(header + 4));
+        m_bits = read_u16(header + 14);
+
+        if(format == 1 && (m_bits == 8 || m_bits == 16 || m_bits == 24 || m_bits == 32))
+          m_encoding = encoding::pcm;
+        else if(format == 3 && m_bits == 32)
+          m_encoding = encoding::ieee_float;
+        else
+        {
+          MGL_CORE_ERROR("audio_stream: unsupported WAV format {} ({} bits)", format, m_bits);
+          return false;
+        }
+
+        if(m_channels <= 0 || m_sample_rate <= 0)
+        {
+          MGL_CORE_ERROR("audio_stream: invalid WAV format");
+          return false;
+        }
+
+        m_frame_size = static_cast<size_t>(m_channels) * (m_bits / 8);
+        has_format = true;
+        size -= length;
+      }
+
+      // Chunks are padded to an even size
+      m_stream->seekg(size + (size & 1), std::ios::cur);
+    }
+
+    MGL_CORE_ERROR("audio_stream: WAV file has no format or data chunk");
+    return false;
+  }
+
+  size_t wav_stream::read(int16_t* out, size_t frames)
+  {
+    frames = std::min(frames, m_data_frames - m_position);
+    size_t block_frames = std::max<size_t>(INPUT_BLOCK / m_frame_size, 1);
+    size_t samples_per_frame = static_cast<size_t>(m_channels);
+    size_t done = 0;
+
+    while(done < frames)
+    {
+      size_t count = std::min(frames - done, block_frames);
+      m_input.resize(count * m_frame_size);
+
+      m_stream->read(reinterpret_cast<char*>(m_input.data()), m_input.size());
+      count = static_cast<size_t>(m_stream->gcount()) / m_frame_size;
+
+      if(count == 0)
+        break;
+
+      const uint8_t* src = m_input.data();
+      int16_t* dst = out + done * samples_per_frame;
+      size_t samples = count * samples_per_frame;
+
+      switch(m_encoding)
+      {
+        case encoding::pcm:
+          switch(m_bits)
+          {
+            case 8:
+              for(size_t i = 0; i < samples; i++)
+                dst[i] = static_cast<int16_t>((src[i] - 128) << 8);
+              break;
+            case 16: std::memcpy(dst, src, samples * sizeof(int16_t)); break;
+            case 24:
+              for(size_t i = 0; i < samples; i++)
+                dst[i] = static_cast<int16_t>(read_u16(src + i * 3 + 1));
+              break;
+            case 32:
+              for(size_t i = 0; i < samples; i++)
+                dst[i] = static_cast<int16_t>(read_u16(src + i * 4 + 2));
+              break;
+          }
+          break;
+        case encoding::ieee_float:
+          for(size_t i = 0; i < samples; i++)
+          {
+            float sample;
+            std::memcpy(&sample, src + i * 4, sizeof(float));
+            dst[i] = to_int16(sample);
+          }
+          break;
+      }
+
+      done += count;
+    }
+
+    m_position += done;
+    return done;
+  }
+
+  bool wav_stream::rewind()
+  {
+    m_stream->clear();
+    m_stream->seekg(m_data_begin);
+    m_position = 0;
+    return !m_stream->fail();
+  }
+
+  class vorbis_stream : public audio_stream
+  {
+public:
+    vorbis_stream(const io::istream_ref& stream)
+        : m_stream(stream)
+    { }
+
+    virtual ~vorbis_stream() { close(); }
+
+    bool open();
+
+    virtual size_t read(int16_t* out, size_t frames) override;
+
+    virtual bool rewind() override;
+
+    virtual size_t memory_size() const override;
+
+private:
+    void close();
+
+    // Appends a block of the file to the input window, false at the end of the file
+    bool fill();
+
+    // Decodes the next frame of the stream into m_block, false at the end of the stream
+    bool decode();
+
+    io::istream_ref m_stream;
+    stb_vorbis* m_vorbis = nullptr;
+    size_t m_setup_memory = 0;
+    mgl::uint8_buffer m_input;
+    size_t m_offset = 0;
+    mgl::int16_buffer m_block;
+    size_t m_block_frames = 0;
+    size_t m_block_offset = 0;
+  };
+
+  bool vorbis_stream::open()
+  {
+    close();
+
+    m_stream->clear();
+    m_stream->seekg(0);
+    m_input.clear();
+    m_offset = 0;
+    m_block_frames = 0;
+    m_block_offset = 0;
+
+    // The headers, codebooks included, must be in the window at once for the decoder to open
+    while(fill())
+    {
+      int used = 0;
+      int error = 0;
+      m_vorbis = stb_vorbis_open_pushdata(
+          m_input.data(), static_cast<int>(m_input.size()), &used, &error, nullptr);
+
+      if(m_vorbis != nullptr)
+      {
+        m_offset = used;
+        break;
+      }
+
+      if(error != VORBIS_need_more_data)
+      {
+        MGL_CORE_ERROR("audio_stream: invalid Vorbis stream ({})", error);
+        return false;
+      }
+    }
+
+    if(m_vorbis == nullptr)
+    {
+      MGL_CORE_ERROR("audio_stream: truncated Vorbis stream");
+      return false;
+    }
+
+    stb_vorbis_info info = stb_vorbis_get_info(m_vorbis);
+    m_channels = info.channels;
+    m_sample_rate = static_cast<int32_t>(info.sample_rate);
+    m_setup_memory = info.setup_memory_required + info.temp_memory_required;
+    m_block.resize(static_cast<size_t>(info.max_frame_size) * m_channels);
+    return true;
+  }
+
+  void vorbis_stream::close()
+  {
+    if(m_vorbis != nullptr)
+    {
+      stb_vorbis_close(m_vorbis);
+      m_vorbis = nullptr;
+    }
+  }
+
+  bool vorbis_stream::fill()
+  {
+    // Drop the consumed bytes first so the window only grows when a page does not fit in it
+    if(m_offset > 0)
+    {
+      m_input.erase(m_input.begin(), m_input.begin() + m_offset);
+      m_offset = 0;
+    }
+
+    size_t size = m_input.size();
+    m_input.resize(size + INPUT_BLOCK);
+    m_stream->read(reinterpret_cast<char*>(m_input.data() + size), INPUT_BLOCK);
+    m_input.resize(size + static_cast<size_t>(m_stream->gcount()));
+
+    return m_input.size() > size;
+  }
+
+  bool vorbis_stream::decode()
+  {
+    while(true)
+    {
+      int channels = 0;
+      int samples = 0;
+      float** outputs = nullptr;
+
+      int used = stb_vorbis_decode_frame_pushdata(m_vorbis,
+                                                  m_input.data() + m_offset,
+                                                  static_cast<int>(m_input.size() - m_offset),
+                                                  &channels,
+                                                  &outputs,
+                                                  &samples);
+      m_offset += used;
+
+      if(samples > 0)
+      {
+        size_t frames = std::min(static_cast<size_t>(samples), m_block.size() / m_channels);
+
+        for(size_t i = 0; i < frames; i++)
+        {
+          for(int32_t c = 0; c < m_channels; c++)
+            m_block[i * m_channels + c] = to_int16(outputs[std::min(c, channels - 1)][i]);
+        }
+
+        m_block_frames = frames;
+        m_block_offset = 0;
+        return true;
+      }
+
+      // Nothing consumed means the next packet is not complete in the window
+      if(used == 0 && !fill())
+        return false;
+    }
+  }
+
+  size_t vorbis_stream::read(int16_t* out, size_t frames)
+  {
+    size_t done = 0;
+
+    while(done < frames)
+    {
+      if(m_block_offset == m_block_frames && !decode())
+        break;
+
+      size_t count = std::min(frames - done, m_block_frames - m_block_offset);
+      std::memcpy(out + done * m_channels,
+                  m_block.data() + m_block_offset * m_channels,
+                  count * m_channels * sizeof(int16_t));
+
+      m_block_offset += count;
+      done += count;
+    }
+
+    return done;
+  }
+
+  bool vorbis_stream::rewind()
+  {
+    // Pushdata decoders cannot seek, the headers are parsed again from the start of the file
+    return open();
+  }
+
+  size_t vorbis_stream::memory_size() const
+  {
+    return m_setup_memory + m_input.capacity() + m_block.capacity() * sizeof(int16_t);
+  }
+
+  audio_stream_ref audio_stream::open(const io::istream_ref& stream)
+  {
+    MGL_CORE_ASSERT(stream != nullptr, "Stream is null");
+
+    char magic[4] = {};
+    stream->read(magic, sizeof(magic));
+    stream->clear();
+    stream->seekg(0);
+
+    if(std::memcmp(magic, "RIFF", 4) == 0)
+    {
+      auto wav = mgl::create_scope<wav_stream>(stream);
+      return wav->open() ? std::move(wav) : nullptr;
+    }
+
+    if(std::memcmp(magic, "OggS", 4) == 0)
+    {
+      auto vorbis = mgl::create_scope<vorbis_stream>(stream);
+      return vorbis->open() ? std::move(vorbis) : nullptr;
+    }
+
+    MGL_CORE_ERROR("audio_stream: unknown audio format");
+    return nullptr;
+  }
+
+  audio_stream_ref audio_stream::open(const location_ref& location, const std::string& path)
+  {
+    MGL_CORE_ASSERT(location != nullptr, "Location is null");
+
+    if(!location->exists(path))
+    {
+      MGL_CORE_ERROR("audio_stream: failed to find {}", path);
+      return nullptr;
+    }
+
+    auto stream = location->open_read(path);
+    if(stream == nullptr)
+    {
+      MGL_CORE_ERROR("audio_stream: failed to read {}", path);
+      return nullptr;
+    }
+
+    return open(stream);
+  }
+
+} // namespace mgl::registry
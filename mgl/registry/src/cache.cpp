@@ -0,0 +1,183 @@
+#include "mgl_registry/cache.hpp"
+
+#include "mgl_core/debug.hpp"
+#include "mgl_core/utils.hpp"
+
+namespace mgl::registry
+{
+  size_t resource_cache::key_hash::operator()(const key& k) const
+  {
+    size_t seed = 0;
+    mgl::hash_combine(seed, static_cast<int>(k.type));
+    mgl::hash_combine(seed, k.path);
+    mgl::hash_combine(seed, k.options);
+    return seed;
+  }
+
+  resource_cache::resource_cache(size_t budget)
+      : m_budget(budget)
+      , m_stats()
+      , m_lru()
+      , m_entries()
+  { }
+
+  resource_ref resource_cache::get(const key& k)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_entries.find(k);
+    if(it == m_entries.end())
+    {
+      m_stats.misses++;
+      return nullptr;
+    }
+
+    auto& e = it->second;
+    resource_ref resource = e.strong != nullptr ? e.strong : e.weak.lock();
+
+    if(resource == nullptr)
+    {
+      // Evicted and no longer used anywhere else
+      m_entries.erase(it);
+      m_stats.entries--;
+      m_stats.misses++;
+      return nullptr;
+    }
+
+    if(e.strong == nullptr)
+    {
+      // Still alive elsewhere, take it back under the budget
+      e.strong = resource;
+      e.lru = m_lru.insert(m_lru.begin(), k);
+      m_stats.bytes += e.bytes;
+    }
+    else
+    {
+      m_lru.splice(m_lru.begin(), m_lru, e.lru);
+    }
+
+    m_stats.hits++;
+    evict();
+    return resource;
+  }
+
+  void resource_cache::put(const key& k, const resource_ref& resource)
+  {
+    MGL_CORE_ASSERT(resource != nullptr, "Resource is null");
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_entries.find(k);
+    if(it != m_entries.end())
+    {
+      release(it->second);
+      m_entries.erase(it);
+      m_stats.entries--;
+    }
+
+    entry e;
+    e.strong = resource;
+    e.weak = resource;
+    e.bytes = resource->memory_size();
+    e.lru = m_lru.insert(m_lru.begin(), k);
+    m_entries.emplace(k, e);
+
+    m_stats.entries++;
+    m_stats.bytes += e.bytes;
+    evict();
+  }
+
+  void resource_cache::remove(const key& k)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_entries.find(k);
+    if(it == m_entries.end())
+    {
+      return;
+    }
+
+    release(it->second);
+    m_entries.erase(it);
+    m_stats.entries--;
+  }
+
+  void resource_cache::remove(resource::type type, const std::string& path)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for(auto it = m_entries.begin(); it != m_entries.end();)
+    {
+      if(it->first.type == type && it->first.path == path)
+      {
+        release(it->second);
+        it = m_entries.erase(it);
+        m_stats.entries--;
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
+  void resource_cache::clear()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_lru.clear();
+    m_stats.entries = 0;
+    m_stats.bytes = 0;
+  }
+
+  void resource_cache::set_budget(size_t budget)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_budget = budget;
+    evict();
+  }
+
+  resource_cache::stats resource_cache::get_stats() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+  }
+
+  void resource_cache::reset_stats()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.hits = 0;
+    m_stats.misses = 0;
+    m_stats.evictions = 0;
+  }
+
+  void resource_cache::release(entry& e)
+  {
+    if(e.strong == nullptr)
+    {
+      return;
+    }
+
+    m_lru.erase(e.lru);
+    m_stats.bytes -= e.bytes;
+    e.strong = nullptr;
+  }
+
+  void resource_cache::evict()
+  {
+    // The most recently used resource is always kept, even if it is bigger than the budget
+    while(m_stats.bytes > m_budget && m_lru.size() > 1)
+    {
+      auto it = m_entries.find(m_lru.back());
+      MGL_CORE_ASSERT(it != m_entries.end(), "Cache entry not found");
+      release(it->second);
+      m_stats.evictions++;
+
+      if(it->second.weak.expired())
+      {
+        m_entries.erase(it);
+        m_stats.entries--;
+      }
+    }
+  }
+
+} // namespace mgl::registry
@@ -0,0 +1,454 @@
+#include "mgl_registry/image_ops.hpp"
+#include "mgl_core/debug.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__AVX2__)
+#  define MGL_IMAGE_OPS_AVX2
+#endif
+
+#if defined(__SSSE3__) || defined(__AVX2__)
+#  define MGL_IMAGE_OPS_SSSE3
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define MGL_IMAGE_OPS_SSE2
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#  define MGL_IMAGE_OPS_NEON
+#endif
+
+#if defined(MGL_IMAGE_OPS_SSE2)
+#  include <immintrin.h>
+#elif defined(MGL_IMAGE_OPS_NEON)
+#  include <arm_neon.h>
+#endif
+
+namespace mgl::registry::image_ops
+{
+  // Exact round(c * a / 255) without a division
+  static inline uint8_t mul_div_255(uint32_t c, uint32_t a)
+  {
+    uint32_t t = c * a + 128;
+    return static_cast<uint8_t>((t + (t >> 8)) >> 8);
+  }
+
+  template <int32_t C>
+  static inline void reverse_pixels(const uint8_t* src, uint8_t* dst, int32_t from, int32_t width)
+  {
+    for(int32_t i = from; i < width; i++)
+      std::memcpy(dst + (size_t)i * C, src + (size_t)(width - 1 - i) * C, C);
+  }
+
+  const char* backend()
+  {
+#if defined(MGL_IMAGE_OPS_AVX2)
+    return "avx2";
+#elif defined(MGL_IMAGE_OPS_SSSE3)
+    return "ssse3";
+#elif defined(MGL_IMAGE_OPS_SSE2)
+    return "sse2";
+#elif defined(MGL_IMAGE_OPS_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+  }
+
+  void copy_rect(const uint8_t* src,
+                 ptrdiff_t src_stride,
+                 uint8_t* dst,
+                 ptrdiff_t dst_stride,
+                 size_t row_bytes,
+                 int32_t rows)
+  {
+    if(rows <= 0 || row_bytes == 0)
+      return;
+
+    // Contiguous rows are a single copy
+    if(src_stride == dst_stride && src_stride == static_cast<ptrdiff_t>(row_bytes))
+    {
+      std::memcpy(dst, src, row_bytes * rows);
+      return;
+    }
+
+    for(int32_t i = 0; i < rows; i++)
+      std::memcpy(dst + i * dst_stride, src + i * src_stride, row_bytes);
+  }
+
+  void reverse_row(const uint8_t* src, uint8_t* dst, int32_t width, int32_t channels)
+  {
+    MGL_CORE_ASSERT(channels >= 1 && channels <= 4, "Invalid number of channels");
+    int32_t i = 0;
+
+    if(channels == 4)
+    {
+#if defined(MGL_IMAGE_OPS_AVX2)
+      const __m256i order = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+      for(; i + 8 <= width; i += 8)
+      {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + (size_t)(width - i - 8) * 4));
+        _mm256_storeu_si256((__m256i*)(dst + (size_t)i * 4), _mm256_permutevar8x32_epi32(v, order));
+      }
+#endif
+#if defined(MGL_IMAGE_OPS_SSE2)
+      for(; i + 4 <= width; i += 4)
+      {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + (size_t)(width - i - 4) * 4));
+        _mm_storeu_si128((__m128i*)(dst + (size_t)i * 4), _mm_shuffle_epi32(v, 0x1B));
+      }
+#elif defined(MGL_IMAGE_OPS_NEON)
+      for(; i + 4 <= width; i += 4)
+      {
+        uint32x4_t v = vreinterpretq_u32_u8(vld1q_u8(src + (size_t)(width - i - 4) * 4));
+        v = vrev64q_u32(v);
+        v = vcombine_u32(vget_high_u32(v), vget_low_u32(v));
+        vst1q_u8(dst + (size_t)i * 4, vreinterpretq_u8_u32(v));
+      }
+#endif
+    }
+    else if(channels == 1)
+    {
+#if defined(MGL_IMAGE_OPS_AVX2)
+      const __m256i order = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                             15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+      for(; i + 32 <= width; i += 32)
+      {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + width - i - 32));
+        v = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, order), 0x4E);
+        _mm256_storeu_si256((__m256i*)(dst + i), v);
+      }
+#endif
+#if defined(MGL_IMAGE_OPS_SSSE3)
+      const __m128i order_128 =
+          _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+      for(; i + 16 <= width; i += 16)
+      {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + width - i - 16));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_shuffle_epi8(v, order_128));
+      }
+#elif defined(MGL_IMAGE_OPS_NEON)
+      for(; i + 16 <= width; i += 16)
+      {
+        uint8x16_t v = vrev64q_u8(vld1q_u8(src + width - i - 16));
+        vst1q_u8(dst + i, vcombine_u8(vget_high_u8(v), vget_low_u8(v)));
+      }
+#endif
+    }
+
+    switch(channels)
+    {
+      case 1: reverse_pixels<1>(src, dst, i, width); break;
+      case 2: reverse_pixels<2>(src, dst, i, width); break;
+      case 3: reverse_pixels<3>(src, dst, i, width); break;
+      case 4: reverse_pixels<4>(src, dst, i, width); break;
+    }
+  }
+
+  void flip_vertically(uint8_t* data, int32_t width, int32_t height, int32_t channels)
+  {
+    size_t row_bytes = (size_t)width * channels;
+    std::vector<uint8_t> temp(row_bytes);
+
+    for(int32_t i = 0; i < height / 2; i++)
+    {
+      uint8_t* top = data + i * row_bytes;
+      uint8_t* bottom = data + (height - 1 - i) * row_bytes;
+      std::memcpy(temp.data(), top, row_bytes);
+      std::memcpy(top, bottom, row_bytes);
+      std::memcpy(bottom, temp.data(), row_bytes);
+    }
+  }
+
+  void flip_horizontally(uint8_t* data, int32_t width, int32_t height, int32_t channels)
+  {
+    size_t row_bytes = (size_t)width * channels;
+    std::vector<uint8_t> temp(row_bytes);
+
+    for(int32_t i = 0; i < height; i++)
+    {
+      uint8_t* row = data + i * row_bytes;
+      std::memcpy(temp.data(), row, row_bytes);
+      reverse_row(temp.data(), row, width, channels);
+    }
+  }
+
+  void fill(uint8_t* data, size_t count, const uint8_t* pixel, int32_t channels)
+  {
+    MGL_CORE_ASSERT(channels >= 1 && channels <= 4, "Invalid number of channels");
+
+    if(count == 0)
+      return;
+
+    if(channels == 1)
+    {
+      std::memset(data, pixel[0], count);
+      return;
+    }
+
+    size_t i = 0;
+
+    if(channels == 4)
+    {
+      uint32_t value;
+      std::memcpy(&value, pixel, 4);
+#if defined(MGL_IMAGE_OPS_AVX2)
+      const __m256i v256 = _mm256_set1_epi32(static_cast<int>(value));
+      for(; i + 8 <= count; i += 8)
+        _mm256_storeu_si256((__m256i*)(data + i * 4), v256);
+#endif
+#if defined(MGL_IMAGE_OPS_SSE2)
+      const __m128i v128 = _mm_set1_epi32(static_cast<int>(value));
+      for(; i + 4 <= count; i += 4)
+        _mm_storeu_si128((__m128i*)(data + i * 4), v128);
+#elif defined(MGL_IMAGE_OPS_NEON)
+      const uint8x16_t v128 = vreinterpretq_u8_u32(vdupq_n_u32(value));
+      for(; i + 4 <= count; i += 4)
+        vst1q_u8(data + i * 4, v128);
+#endif
+      for(; i < count; i++)
+        std::memcpy(data + i * 4, &value, 4);
+      return;
+    }
+
+    // Seed one pixel and keep copying the filled part, capped so the source stays in cache
+    const size_t total = count * channels;
+    const size_t block = (65536 / channels) * channels;
+    size_t filled = channels;
+    std::memcpy(data, pixel, channels);
+
+    while(filled < total)
+    {
+      size_t n = std::min({ filled, total - filled, block });
+      std::memcpy(data + filled, data, n);
+      filled += n;
+    }
+  }
+
+  void swizzle(uint8_t* data, size_t count, int32_t channels, const uint8_t* order)
+  {
+    MGL_CORE_ASSERT(channels >= 1 && channels <= 4, "Invalid number of channels");
+    for(int32_t c = 0; c < channels; c++)
+    {
+      MGL_CORE_ASSERT(order[c] < channels, "Invalid channel in swizzle order");
+    }
+
+    size_t i = 0;
+
+    if(channels == 4)
+    {
+#if defined(MGL_IMAGE_OPS_SSSE3) || (defined(MGL_IMAGE_OPS_NEON) && defined(__aarch64__))
+      uint8_t mask[32];
+      for(int32_t k = 0; k < 32; k++)
+        mask[k] = static_cast<uint8_t>((k & ~3) + order[k & 3]);
+#endif
+#if defined(MGL_IMAGE_OPS_AVX2)
+      const __m256i mask_256 = _mm256_loadu_si256((const __m256i*)mask);
+      for(; i + 8 <= count; i += 8)
+      {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(data + i * 4));
+        _mm256_storeu_si256((__m256i*)(data + i * 4), _mm256_shuffle_epi8(v, mask_256));
+      }
+#endif
+#if defined(MGL_IMAGE_OPS_SSSE3)
+      const __m128i mask_128 = _mm_loadu_si128((const __m128i*)mask);
+      for(; i + 4 <= count; i += 4)
+      {
+        __m128i v = _mm_loadu_si128((const __m128i*)(data + i * 4));
+        _mm_storeu_si128((__m128i*)(data + i * 4), _mm_shuffle_epi8(v, mask_128));
+      }
+#elif defined(MGL_IMAGE_OPS_NEON) && defined(__aarch64__)
+      const uint8x16_t mask_128 = vld1q_u8(mask);
+      for(; i + 4 <= count; i += 4)
+        vst1q_u8(data + i * 4, vqtbl1q_u8(vld1q_u8(data + i * 4), mask_128));
+#endif
+    }
+
+    for(; i < count; i++)
+    {
+      uint8_t* p = data + i * channels;
+      uint8_t src[4];
+      std::memcpy(src, p, channels);
+      for(int32_t c = 0; c < channels; c++)
+        p[c] = src[order[c]];
+    }
+  }
+
+  void expand_to_rgba(const uint8_t* src, uint8_t* dst, size_t count, int32_t channels)
+  {
+    MGL_CORE_ASSERT(channels >= 1 && channels <= 4, "Invalid number of channels");
+
+    if(channels == 4)
+    {
+      std::memcpy(dst, src, count * 4);
+      return;
+    }
+
+    size_t i = 0;
+
+#if defined(MGL_IMAGE_OPS_SSE2)
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+    if(channels == 1)
+    {
+      for(; i + 16 <= count; i += 16)
+      {
+        __m128i g = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i gg_lo = _mm_unpacklo_epi8(g, g);
+        __m128i gg_hi = _mm_unpackhi_epi8(g, g);
+        uint8_t* out = dst + i * 4;
+        _mm_storeu_si128((__m128i*)(out), _mm_or_si128(_mm_unpacklo_epi16(gg_lo, gg_lo), alpha));
+        _mm_storeu_si128((__m128i*)(out + 16),
+                         _mm_or_si128(_mm_unpackhi_epi16(gg_lo, gg_lo), alpha));
+        _mm_storeu_si128((__m128i*)(out + 32),
+                         _mm_or_si128(_mm_unpacklo_epi16(gg_hi, gg_hi), alpha));
+        _mm_storeu_si128((__m128i*)(out + 48),
+                         _mm_or_si128(_mm_unpackhi_epi16(gg_hi, gg_hi), alpha));
+      }
+    }
+    else if(channels == 2)
+    {
+      // Each 16 bit lane holds grey and alpha, pairing it with a grey-grey lane gives g, g, g, a
+      for(; i + 8 <= count; i += 8)
+      {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i * 2));
+        __m128i g = _mm_and_si128(v, _mm_set1_epi16(0xFF));
+        __m128i gg = _mm_or_si128(g, _mm_slli_epi16(g, 8));
+        _mm_storeu_si128((__m128i*)(dst + i * 4), _mm_unpacklo_epi16(gg, v));
+        _mm_storeu_si128((__m128i*)(dst + i * 4 + 16), _mm_unpackhi_epi16(gg, v));
+      }
+    }
+#  if defined(MGL_IMAGE_OPS_SSSE3)
+    else if(channels == 3)
+    {
+      // Loads 16 bytes for 4 pixels, stop early so the last load stays inside the source
+      const __m128i mask = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+      for(; i + 6 <= count; i += 4)
+      {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i * 3));
+        _mm_storeu_si128((__m128i*)(dst + i * 4), _mm_or_si128(_mm_shuffle_epi8(v, mask), alpha));
+      }
+    }
+#  endif
+#elif defined(MGL_IMAGE_OPS_NEON)
+    const uint8x16_t alpha = vdupq_n_u8(255);
+
+    if(channels == 1)
+    {
+      for(; i + 16 <= count; i += 16)
+      {
+        uint8x16_t g = vld1q_u8(src + i);
+        uint8x16x4_t out = { { g, g, g, alpha } };
+        vst4q_u8(dst + i * 4, out);
+      }
+    }
+    else if(channels == 2)
+    {
+      for(; i + 16 <= count; i += 16)
+      {
+        uint8x16x2_t ga = vld2q_u8(src + i * 2);
+        uint8x16x4_t out = { { ga.val[0], ga.val[0], ga.val[0], ga.val[1] } };
+        vst4q_u8(dst + i * 4, out);
+      }
+    }
+    else if(channels == 3)
+    {
+      for(; i + 16 <= count; i += 16)
+      {
+        uint8x16x3_t rgb = vld3q_u8(src + i * 3);
+        uint8x16x4_t out = { { rgb.val[0], rgb.val[1], rgb.val[2], alpha } };
+        vst4q_u8(dst + i * 4, out);
+      }
+    }
+#endif
+
+    for(; i < count; i++)
+    {
+      const uint8_t* p = src + i * channels;
+      uint8_t* out = dst + i * 4;
+      switch(channels)
+      {
+        case 1: out[0] = out[1] = out[2] = p[0], out[3] = 255; break;
+        case 2: out[0] = out[1] = out[2] = p[0], out[3] = p[1]; break;
+        case 3: out[0] = p[0], out[1] = p[1], out[2] = p[2], out[3] = 255; break;
+      }
+    }
+  }
+
+  void premultiply_alpha(uint8_t* data, size_t count, int32_t channels)
+  {
+    MGL_CORE_ASSERT(channels == 2 || channels == 4, "Premultiply needs an alpha channel");
+    size_t i = 0;
+
+    if(channels == 4)
+    {
+      // Alpha lanes multiply by 255, which leaves them unchanged
+#if defined(MGL_IMAGE_OPS_AVX2)
+      const __m256i zero_256 = _mm256_setzero_si256();
+      const __m256i keep_256 = _mm256_set1_epi64x(0x00FF000000000000ll);
+      const __m256i bias_256 = _mm256_set1_epi16(128);
+      for(; i + 8 <= count; i += 8)
+      {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(data + i * 4));
+        __m256i halves[2] = { _mm256_unpacklo_epi8(v, zero_256),
+                              _mm256_unpackhi_epi8(v, zero_256) };
+        for(auto& h : halves)
+        {
+          __m256i a = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(h, 0xFF), 0xFF);
+          __m256i t = _mm256_mullo_epi16(h, _mm256_or_si256(a, keep_256));
+          t = _mm256_add_epi16(t, bias_256);
+          h = _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+        }
+        _mm256_storeu_si256((__m256i*)(data + i * 4), _mm256_packus_epi16(halves[0], halves[1]));
+      }
+#endif
+#if defined(MGL_IMAGE_OPS_SSE2)
+      const __m128i zero = _mm_setzero_si128();
+      const __m128i keep = _mm_set1_epi64x(0x00FF000000000000ll);
+      const __m128i bias = _mm_set1_epi16(128);
+      for(; i + 4 <= count; i += 4)
+      {
+        __m128i v = _mm_loadu_si128((const __m128i*)(data + i * 4));
+        __m128i halves[2] = { _mm_unpacklo_epi8(v, zero), _mm_unpackhi_epi8(v, zero) };
+        for(auto& h : halves)
+        {
+          __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(h, 0xFF), 0xFF);
+          __m128i t = _mm_add_epi16(_mm_mullo_epi16(h, _mm_or_si128(a, keep)), bias);
+          h = _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+        }
+        _mm_storeu_si128((__m128i*)(data + i * 4), _mm_packus_epi16(halves[0], halves[1]));
+      }
+#elif defined(MGL_IMAGE_OPS_NEON)
+      const uint16x8_t bias = vdupq_n_u16(128);
+      auto mul = [&bias](uint8x8_t c, uint8x8_t a) {
+        uint16x8_t t = vaddq_u16(vmull_u8(c, a), bias);
+        return vshrn_n_u16(vaddq_u16(t, vshrq_n_u16(t, 8)), 8);
+      };
+      for(; i + 16 <= count; i += 16)
+      {
+        uint8x16x4_t px = vld4q_u8(data + i * 4);
+        uint8x8_t a_lo = vget_low_u8(px.val[3]);
+        uint8x8_t a_hi = vget_high_u8(px.val[3]);
+        for(int32_t c = 0; c < 3; c++)
+        {
+          px.val[c] = vcombine_u8(mul(vget_low_u8(px.val[c]), a_lo),
+                                  mul(vget_high_u8(px.val[c]), a_hi));
+        }
+        vst4q_u8(data + i * 4, px);
+      }
+#endif
+    }
+
+    for(; i < count; i++)
+    {
+      uint8_t* p = data + i * channels;
+      uint8_t a = p[channels - 1];
+      for(int32_t c = 0; c < channels - 1; c++)
+        p[c] = mul_div_255(p[c], a);
+    }
+  }
+
+} // namespace mgl::registry::image_ops
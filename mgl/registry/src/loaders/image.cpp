@@ -1,9 +1,12 @@
 #include "mgl_registry/loaders/image.hpp"
 #include "mgl_core/memory.hpp"
 #include "mgl_core/zip.hpp"
+#include "mgl_registry/image_ops.hpp"
 
 #include "mgl_core/log.hpp"
 
+#include <memory>
+
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb/stb_image.hpp"
 
@@ -11,32 +14,68 @@ namespace mgl::registry::loaders
 {
   static image_loader_options default_image_loader_options;
 
-  static void horizontal_flip(void* image, int w, int h, int components)
+  static int stream_read(void* user, char* data, int size)
   {
-    size_t line_bytes = (size_t)w * components;
-    stbi_uc temp[line_bytes];
-    stbi_uc* bytes = (stbi_uc*)image;
-    int lpos, rpos;
-    for(int col = 0; col < h; col++)
-    {
-      stbi_uc* line = bytes + col * line_bytes;
-      std::copy(&temp[0], &temp[line_bytes], &line[0]);
-      for(int row = 0; row < w; row++)
-      {
-        lpos = row * components;
-        rpos = line_bytes - row * components - 1;
-        line[lpos] = temp[rpos - 3];
-        line[lpos + 1] = temp[rpos - 2];
-        line[lpos + 2] = temp[rpos - 1];
-        line[lpos + 3] = temp[rpos];
-      }
-    }
+    auto stream = static_cast<mgl::io::istream*>(user);
+    stream->read(data, size);
+    return static_cast<int>(stream->gcount());
+  }
+
+  static void stream_skip(void* user, int n)
+  {
+    auto stream = static_cast<mgl::io::istream*>(user);
+    stream->clear();
+    stream->seekg(n, std::ios::cur);
   }
+
+  static int stream_eof(void* user)
+  {
+    auto stream = static_cast<mgl::io::istream*>(user);
+    return stream->peek() == std::char_traits<char>::eof();
+  }
+
+  static const stbi_io_callbacks stream_callbacks = { stream_read, stream_skip, stream_eof };
+
   mgl::string_list image_loader::get_extensions() const
   {
     return { ".png", ".jpg", ".jpeg", ".bmp", ".tga", ".psd", ".gif", ".hdr", ".pic" };
   }
 
+  // Shared by the memory and stream paths, stb allocates the pixels and they are copied into the
+  // image once
+  template <typename Load>
+  static image_ref decode_image(Load&& load, const image_loader_options& opts)
+  {
+    int width, height, components;
+    stbi_set_flip_vertically_on_load_thread(opts.flip_vertically);
+
+    std::unique_ptr<stbi_uc, decltype(&stbi_image_free)> data(load(&width, &height, &components),
+                                                              stbi_image_free);
+
+    if(!data)
+    {
+      return nullptr;
+    }
+
+    // Vertical flips are done by stb while decoding
+    if(opts.flip_horizontally)
+    {
+      image_ops::flip_horizontally(data.get(), width, height, components);
+    }
+
+    mgl::uint8_buffer pixels(data.get(), data.get() + (size_t)width * height * components);
+    return mgl::create_ref<image>(width, height, components, pixels);
+  }
+
+  image_ref
+  image_loader::decode(const uint8_t* data, size_t size, const image_loader_options& options)
+  {
+    int len = static_cast<int>(size);
+    return decode_image(
+        [&](int* w, int* h, int* c) { return stbi_load_from_memory(data, len, w, h, c, 0); },
+        options);
+  }
+
   resource_ref image_loader::load(const location_ref& location,
                                   const std::string& path,
                                   const loader_options& options)
@@ -48,9 +87,6 @@ namespace mgl::registry::loaders
       opts = &default_image_loader_options;
     }
 
-    int width, height, components;
-    stbi_set_flip_vertically_on_load(opts->flip_vertically);
-
     mgl::io::istream_ref file = location->open_read(path);
 
     if(!file)
@@ -59,31 +95,29 @@ namespace mgl::registry::loaders
       return nullptr;
     }
 
-    file->seekg(0, std::ios::end);
-    size_t size = file->tellg();
-    file->seekg(0, std::ios::beg);
+    image_ref img;
 
-    unsigned char* raw = new unsigned char[size];
-    file->read((char*)raw, size);
-    auto data = stbi_load_from_memory(raw, size, &width, &height, &components, 0);
-    delete[] raw;
-
-    if(!data)
+    // Memory streams, e.g. raw pak entries, are decoded in place, anything else is streamed
+    if(auto memory = dynamic_cast<mgl::io::memory_istream*>(file.get()))
     {
-      MGL_CORE_ERROR("Failed to read image file: {}", path);
-      return nullptr;
+      img = decode(memory->data(), memory->size(), *opts);
     }
-
-    if(opts->flip_vertically)
+    else
     {
-      horizontal_flip(data, width, height, components);
+      auto stream = file.get();
+      img = decode_image(
+          [&](int* w, int* h, int* c) {
+            return stbi_load_from_callbacks(&stream_callbacks, stream, w, h, c, 0);
+          },
+          *opts);
     }
 
-    auto img_data = mgl::uint8_buffer(data, data + width * height * components);
-
-    stbi_image_free(data);
+    if(!img)
+    {
+      MGL_CORE_ERROR("Failed to read image file: {}", path);
+    }
 
-    return mgl::create_ref<image>(width, height, components, img_data);
+    return img;
   }
 
 } // namespace mgl::registry::loaders
\ No newline at end of file
@@ -0,0 +1,28 @@
+#include "mgl_registry/loaders/music.hpp"
+#include "mgl_core/debug.hpp"
+#include "mgl_registry/audio_stream.hpp"
+
+namespace mgl::registry::loaders
+{
+  mgl::string_list music_loader::get_extensions() const
+  {
+    return { ".wav", ".ogg" };
+  }
+
+  resource_ref music_loader::load(const location_ref& location,
+                                  const std::string& path,
+                                  const loader_options& options)
+  {
+    // Only the headers are decoded, players open their own stream
+    auto stream = audio_stream::open(location, path);
+
+    if(!stream)
+    {
+      MGL_CORE_ERROR("Failed to load music: {}", path);
+      return nullptr;
+    }
+
+    return mgl::create_ref<music>(location, path, stream->channels(), stream->sample_rate());
+  }
+
+} // namespace mgl::registry::loaders
@@ -36,7 +36,15 @@ namespace mgl::registry::loaders
     }
 
     std::string src((std::istreambuf_iterator<char>(*file)), std::istreambuf_iterator<char>());
-    return mgl::create_ref<shader>(src, opts->type);
+
+    shader_preprocessor::result expanded;
+    if(!current_registry().includes().preprocess(location, path, src, expanded))
+    {
+      MGL_CORE_ERROR("Failed to preprocess shader file: {}", path);
+      return nullptr;
+    }
+
+    return mgl::create_ref<shader>(expanded.source, opts->type, expanded.files);
   }
 
 } // namespace mgl::registry::loaders
\ No newline at end of file
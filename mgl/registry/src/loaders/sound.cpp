@@ -0,0 +1,46 @@
+#include "mgl_registry/loaders/sound.hpp"
+#include "mgl_core/debug.hpp"
+#include "mgl_registry/audio_stream.hpp"
+
+namespace mgl::registry::loaders
+{
+  // Frames decoded per read while loading a whole clip
+  static constexpr size_t DECODE_FRAMES = 4096;
+
+  mgl::string_list sound_loader::get_extensions() const
+  {
+    return { ".wav", ".ogg" };
+  }
+
+  resource_ref sound_loader::load(const location_ref& location,
+                                  const std::string& path,
+                                  const loader_options& options)
+  {
+    auto stream = audio_stream::open(location, path);
+
+    if(!stream)
+    {
+      MGL_CORE_ERROR("Failed to load sound: {}", path);
+      return nullptr;
+    }
+
+    size_t channels = static_cast<size_t>(stream->channels());
+    mgl::int16_buffer samples;
+
+    while(true)
+    {
+      size_t size = samples.size();
+      samples.resize(size + DECODE_FRAMES * channels);
+
+      size_t frames = stream->read(samples.data() + size, DECODE_FRAMES);
+      samples.resize(size + frames * channels);
+
+      if(frames == 0)
+        break;
+    }
+
+    samples.shrink_to_fit();
+    return mgl::create_ref<sound>(stream->channels(), stream->sample_rate(), std::move(samples));
+  }
+
+} // namespace mgl::registry::loaders
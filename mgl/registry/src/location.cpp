@@ -12,7 +12,16 @@ namespace mgl::registry
 
     if(protocol == "file")
     {
-      path = url.substr(protocol_end + 3);
+      std::string::size_type query_begin = url.find('?', protocol_end + 3);
+      if(query_begin != std::string::npos)
+      {
+        query = url.substr(query_begin + 1);
+        path = url.substr(protocol_end + 3, query_begin - (protocol_end + 3));
+      }
+      else
+      {
+        path = url.substr(protocol_end + 3);
+      }
       return;
     }
 
@@ -40,6 +49,72 @@ namespace mgl::registry
     }
   }
 
+  void path_index::assign(mgl::list<std::string>&& paths)
+  {
+    std::unordered_set<std::string> index;
+    index.reserve(paths.size());
+
+    for(auto&& path : paths)
+      index.insert(normalize(path));
+
+    std::unique_lock lock(m_mutex);
+    m_paths = std::move(index);
+    m_valid = true;
+  }
+
+  void path_index::insert(const std::string& path)
+  {
+    auto key = normalize(path);
+    std::unique_lock lock(m_mutex);
+    if(m_valid)
+      m_paths.insert(std::move(key));
+  }
+
+  void path_index::invalidate()
+  {
+    std::unique_lock lock(m_mutex);
+    m_paths.clear();
+    m_valid = false;
+  }
+
+  bool path_index::valid() const
+  {
+    std::shared_lock lock(m_mutex);
+    return m_valid;
+  }
+
+  bool path_index::contains(const std::string& path) const
+  {
+    auto key = normalize(path);
+    std::shared_lock lock(m_mutex);
+    return m_paths.find(key) != m_paths.end();
+  }
+
+  size_t path_index::size() const
+  {
+    std::shared_lock lock(m_mutex);
+    return m_paths.size();
+  }
+
+  std::string path_index::normalize(const std::string& path)
+  {
+    auto result = mgl::path(path).lexically_normal().generic_string();
+
+    // Zip directory entries and lexically_normal both keep a trailing separator
+    while(result.size() > 1 && result.back() == '/')
+      result.pop_back();
+
+    return result;
+  }
+
+  size_t location::prefetch(const std::string& path) const
+  {
+    // Reading warms whatever the location reads from, e.g. the pages of a zip archive
+    mgl::uint8_buffer buffer;
+    read(path, buffer);
+    return buffer.size();
+  }
+
   bool location::operator==(const location& other) const
   {
     return path() == other.path();
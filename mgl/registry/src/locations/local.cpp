@@ -1,12 +1,20 @@
 #include "mgl_registry/locations/local.hpp"
 #include "mgl_core/io.hpp"
+#include "mgl_core/platform.hpp"
+
+#ifdef MGL_PLATFORM_LINUX
+#  include <fcntl.h>
+#  include <sys/inotify.h>
+#  include <unistd.h>
+#endif
 
 namespace mgl::registry
 {
   static const std::string local_location_name = "local";
 
-  local_location::local_location(const mgl::path& path)
+  local_location::local_location(const mgl::path& path, bool watch)
       : location(path)
+      , m_watch(watch)
   {
     if(path.empty())
       return;
@@ -20,6 +28,93 @@ namespace mgl::registry
     }
   }
 
+  local_location::~local_location()
+  {
+#ifdef MGL_PLATFORM_LINUX
+    if(m_watch_fd >= 0)
+      close(m_watch_fd);
+#endif
+  }
+
+  void local_location::refresh()
+  {
+    if(is_null())
+      return;
+
+    std::lock_guard lock(m_watch_mutex);
+    build_index();
+  }
+
+  void local_location::build_index() const
+  {
+#ifdef MGL_PLATFORM_LINUX
+    // Watches are per directory, recreate them so new subdirectories are covered as well
+    if(m_watch_fd >= 0)
+    {
+      close(m_watch_fd);
+      m_watch_fd = -1;
+    }
+
+    if(m_watch)
+    {
+      m_watch_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+      if(m_watch_fd < 0)
+        MGL_CORE_ERROR("local_location: failed to watch {}", this->path().string());
+    }
+
+    const uint32_t watch_mask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+    if(m_watch_fd >= 0)
+      inotify_add_watch(m_watch_fd, this->path().c_str(), watch_mask);
+#endif
+
+    mgl::list<std::string> paths;
+    std::error_code ec;
+    auto options = std::filesystem::directory_options::skip_permission_denied;
+
+    for(auto it = std::filesystem::recursive_directory_iterator(this->path(), options, ec);
+        it != std::filesystem::recursive_directory_iterator();
+        it.increment(ec))
+    {
+      if(ec)
+        break;
+
+      paths.push_back(it->path().lexically_relative(this->path()).generic_string());
+
+#ifdef MGL_PLATFORM_LINUX
+      if(m_watch_fd >= 0 && it->is_directory(ec))
+        inotify_add_watch(m_watch_fd, it->path().c_str(), watch_mask);
+#endif
+    }
+
+    if(ec)
+    {
+      MGL_CORE_ERROR("local_location: failed to index {}: {}", this->path().string(), ec.message());
+      m_index.invalidate();
+      return;
+    }
+
+    m_index.assign(std::move(paths));
+  }
+
+  void local_location::poll_changes() const
+  {
+#ifdef MGL_PLATFORM_LINUX
+    std::lock_guard lock(m_watch_mutex);
+
+    if(m_watch_fd < 0)
+      return;
+
+    // Only the fact that something changed matters, drain the queue and rebuild once
+    alignas(inotify_event) char events[4096];
+    bool changed = false;
+    while(::read(m_watch_fd, events, sizeof(events)) > 0)
+      changed = true;
+
+    if(changed)
+      build_index();
+#endif
+  }
+
   io::istream_ref local_location::open_read(const std::string& path, io::openmode mode)
   {
     if(is_null())
@@ -33,6 +128,7 @@ namespace mgl::registry
     if(is_null())
       return nullptr;
 
+    m_index.insert(path);
     return mgl::create_ref<mgl::io::ofstream>(this->path() / path, io::out | mode);
   }
 
@@ -57,6 +153,31 @@ namespace mgl::registry
     io::write_uint8_buffer(stream, buffer);
     stream->flush();
     stream->close();
+    m_index.insert(path);
+  }
+
+  size_t local_location::prefetch(const std::string& path) const
+  {
+    if(is_null())
+      return 0;
+
+    std::error_code ec;
+    auto file_size = std::filesystem::file_size(this->path() / path, ec);
+    if(ec)
+      return 0;
+
+#ifdef MGL_PLATFORM_LINUX
+    // The kernel reads the file into the page cache in the background, nothing is copied here
+    int fd = ::open((this->path() / path).c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd >= 0)
+    {
+      posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+      ::close(fd);
+      return file_size;
+    }
+#endif
+
+    return location::prefetch(path);
   }
 
   bool local_location::exists(const std::string& path) const
@@ -64,6 +185,11 @@ namespace mgl::registry
     if(is_null())
       return false;
 
+    poll_changes();
+
+    if(m_index.valid())
+      return m_index.contains(path);
+
     return std::filesystem::exists(this->path() / path);
   }
 
@@ -88,7 +214,7 @@ namespace mgl::registry
     if(!can_handle(url))
       return nullptr;
 
-    return mgl::ref<location>(new local_location(url.path));
+    return mgl::ref<location>(new local_location(url.path, url.query == "watch"));
   }
 
   const std::string& local_location::kind() const
@@ -0,0 +1,235 @@
+#include "mgl_registry/locations/pak.hpp"
+#include "mgl_core/log.hpp"
+#include "mgl_core/lz4.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace mgl::registry
+{
+  static const std::string pak_location_name = "pak";
+
+  pak_location::pak_location(const mgl::path& path)
+      : location(path)
+  {
+    if(path.empty())
+      return;
+
+    if(path.is_relative())
+      set_path(std::filesystem::current_path() / path);
+
+    if(!std::filesystem::exists(this->path()))
+    {
+      set_path("");
+      return;
+    }
+
+    refresh();
+  }
+
+  void pak_location::refresh()
+  {
+    if(is_null())
+      return;
+
+    archive a;
+    a.file = mgl::create_ref<mgl::mapped_file>(this->path());
+
+    const uint8_t* data = a.file->data();
+    const size_t size = a.file->size();
+
+    pak::header h;
+    bool valid = a.file->is_open() && size >= sizeof(h);
+
+    if(valid)
+    {
+      std::memcpy(&h, data, sizeof(h));
+      valid = h.magic == pak::MAGIC && h.version == pak::VERSION &&
+              h.entries_offset % alignof(pak::entry) == 0 && h.entries_offset <= size &&
+              h.entry_count <= (size - h.entries_offset) / sizeof(pak::entry) &&
+              h.names_offset <= size && h.names_size <= size - h.names_offset;
+    }
+
+    if(valid)
+    {
+      a.entries = reinterpret_cast<const pak::entry*>(data + h.entries_offset);
+      a.names = reinterpret_cast<const char*>(data + h.names_offset);
+      a.entry_count = h.entry_count;
+
+      for(uint32_t i = 0; valid && i < a.entry_count; i++)
+      {
+        auto& e = a.entries[i];
+        valid = e.offset <= size && e.stored_size <= size - e.offset &&
+                e.name_offset <= h.names_size && e.name_size <= h.names_size - e.name_offset;
+
+        // Raw entries are read straight from the mapping, their size must match the blob. LZ4
+        // sizes are bounded by the blob so a corrupt entry can't force a huge allocation.
+        switch(e.method)
+        {
+          case pak::compression::none: valid = valid && e.size == e.stored_size; break;
+          case pak::compression::lz4:
+            valid = valid && e.size <= mgl::lz4::decompress_bound(e.stored_size);
+            break;
+          default: valid = false; break;
+        }
+      }
+    }
+
+    if(!valid)
+    {
+      MGL_CORE_ERROR("pak_location: invalid archive {}", this->path().string());
+      a = archive();
+    }
+
+    std::unique_lock lock(m_mutex);
+    m_archive = std::move(a);
+  }
+
+  pak_location::archive pak_location::current() const
+  {
+    std::shared_lock lock(m_mutex);
+    return m_archive;
+  }
+
+  const pak::entry* pak_location::archive::find(const std::string& path) const
+  {
+    if(entries == nullptr)
+      return nullptr;
+
+    auto name = path_index::normalize(path);
+    auto h = pak::hash(name);
+
+    auto end = entries + entry_count;
+    auto it = std::lower_bound(
+        entries, end, h, [](const pak::entry& e, uint64_t value) { return e.hash < value; });
+
+    for(; it != end && it->hash == h; ++it)
+    {
+      if(std::string_view(names + it->name_offset, it->name_size) == name)
+        return it;
+    }
+
+    return nullptr;
+  }
+
+  io::istream_ref pak_location::open_read(const std::string& path, io::openmode mode)
+  {
+    auto a = current();
+    auto e = a.find(path);
+    if(e == nullptr)
+      return nullptr;
+
+    // Raw entries are streamed from the mapping, the stream keeps the archive mapped
+    if(e->method == pak::compression::none)
+      return mgl::create_ref<io::memory_istream>(a.file->data() + e->offset, e->size, a.file);
+
+    auto buffer = mgl::create_ref<mgl::uint8_buffer>();
+    read(path, *buffer);
+    return mgl::create_ref<io::memory_istream>(buffer->data(), buffer->size(), buffer);
+  }
+
+  io::ostream_ref pak_location::open_write(const std::string& path, io::openmode mode)
+  {
+    MGL_CORE_INFO("pak_location::open_write not supported, archives are read only");
+    return nullptr;
+  }
+
+  void pak_location::read(const std::string& path, mgl::uint8_buffer& buffer) const
+  {
+    auto a = current();
+    auto e = a.find(path);
+    if(e == nullptr)
+      return;
+
+    const uint8_t* blob = a.file->data() + e->offset;
+    buffer.resize(e->size);
+
+    switch(e->method)
+    {
+      case pak::compression::none:
+        std::memcpy(buffer.data(), blob, e->size);
+        break;
+      case pak::compression::lz4:
+        if(!mgl::lz4::decompress(blob, e->stored_size, buffer.data(), buffer.size()))
+        {
+          MGL_CORE_ERROR("pak_location: corrupted entry {} in {}", path, this->path().string());
+          buffer.clear();
+        }
+        break;
+      default:
+        MGL_CORE_ERROR("pak_location: unknown compression for {}", path);
+        buffer.clear();
+        break;
+    }
+  }
+
+  void pak_location::write(const std::string& path, const mgl::uint8_buffer& buffer) const
+  {
+    MGL_CORE_INFO("pak_location::write not supported, archives are read only");
+  }
+
+  bool pak_location::exists(const std::string& path) const
+  {
+    return current().find(path) != nullptr;
+  }
+
+  size_t pak_location::prefetch(const std::string& path) const
+  {
+    auto a = current();
+    auto e = a.find(path);
+    if(e == nullptr)
+      return 0;
+
+    a.file->prefetch(e->offset, e->stored_size);
+    return e->stored_size;
+  }
+
+  bool pak_location::is_indexed() const
+  {
+    std::shared_lock lock(m_mutex);
+    return m_archive.entries != nullptr;
+  }
+
+  mgl::mapped_file_ref
+  pak_location::view(const std::string& path, const uint8_t*& data, size_t& size) const
+  {
+    auto a = current();
+    auto e = a.find(path);
+    if(e == nullptr || e->method != pak::compression::none)
+      return nullptr;
+
+    data = a.file->data() + e->offset;
+    size = e->size;
+    return a.file;
+  }
+
+  bool pak_location::can_handle(const url& url) const
+  {
+    if(url.protocol != "file")
+      return false;
+
+    auto path = url.path;
+
+    if(path.empty())
+      return false;
+
+    if(path.is_relative())
+      path = std::filesystem::current_path() / url.path;
+
+    return std::filesystem::is_regular_file(path) && path.extension() == ".pak";
+  }
+
+  location_ref pak_location::factory(const url& url) const
+  {
+    if(!can_handle(url))
+      return nullptr;
+
+    return mgl::ref<location>(new pak_location(url.path));
+  }
+
+  const std::string& pak_location::kind() const
+  {
+    return pak_location_name;
+  }
+
+} // namespace mgl::registry
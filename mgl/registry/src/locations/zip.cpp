@@ -53,10 +53,22 @@ namespace mgl::registry
     if(is_null())
       return false;
 
+    if(m_index.valid())
+      return m_index.contains(path);
+
     zip_file zip(this->path().string());
     return zip.exists(path);
   }
 
+  void zip_location::refresh()
+  {
+    if(is_null())
+      return;
+
+    zip_file zip(this->path().string());
+    m_index.assign(zip.entries());
+  }
+
   bool zip_location::can_handle(const url& url) const
   {
     if(url.protocol != "file")
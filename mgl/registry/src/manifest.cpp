@@ -0,0 +1,97 @@
+#include "mgl_registry/manifest.hpp"
+
+#include "mgl_core/log.hpp"
+
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+namespace mgl::registry
+{
+  manifest_ref manifest::parse(const std::string& json)
+  {
+    auto document = nlohmann::json::parse(json, nullptr, false);
+
+    if(document.is_discarded() || !document.is_object())
+    {
+      MGL_CORE_ERROR("manifest: invalid json document");
+      return nullptr;
+    }
+
+    auto stages = document.find("stages");
+    if(stages == document.end() || !stages->is_object())
+    {
+      MGL_CORE_ERROR("manifest: missing stages object");
+      return nullptr;
+    }
+
+    auto result = mgl::create_ref<manifest>();
+
+    for(auto& [stage, entries] : stages->items())
+    {
+      if(!entries.is_array())
+      {
+        MGL_CORE_ERROR("manifest: stage {} is not a list of assets", stage);
+        return nullptr;
+      }
+
+      auto& assets = result->m_stages[stage];
+      assets.reserve(entries.size());
+
+      for(auto& entry : entries)
+      {
+        if(!entry.is_object() || !entry.contains("type") || !entry.contains("path") ||
+           !entry["type"].is_string() || !entry["path"].is_string())
+        {
+          MGL_CORE_ERROR("manifest: assets of stage {} need a type and a path", stage);
+          return nullptr;
+        }
+
+        asset a;
+        if(!resource::type_from_name(entry["type"].get<std::string>(), a.type))
+        {
+          MGL_CORE_ERROR("manifest: unknown asset type {}", entry["type"].get<std::string>());
+          return nullptr;
+        }
+
+        a.path = entry["path"].get<std::string>();
+        assets.push_back(std::move(a));
+      }
+    }
+
+    return result;
+  }
+
+  manifest_ref manifest::load(const mgl::path& path)
+  {
+    std::ifstream stream(path, std::ios::binary);
+
+    if(!stream.is_open())
+    {
+      MGL_CORE_ERROR("manifest: failed to read {}", path.string());
+      return nullptr;
+    }
+
+    std::string json((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    return parse(json);
+  }
+
+  mgl::string_list manifest::stages() const
+  {
+    mgl::string_list names;
+    names.reserve(m_stages.size());
+
+    for(auto& [name, assets] : m_stages)
+      names.push_back(name);
+
+    return names;
+  }
+
+  const mgl::list<manifest::asset>& manifest::assets(const std::string& stage) const
+  {
+    static const mgl::list<asset> s_empty;
+
+    auto it = m_stages.find(stage);
+    return it != m_stages.end() ? it->second : s_empty;
+  }
+
+} // namespace mgl::registry
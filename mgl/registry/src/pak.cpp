@@ -0,0 +1,116 @@
+#include "mgl_registry/pak.hpp"
+#include "mgl_registry/location.hpp"
+
+#include "mgl_core/io.hpp"
+#include "mgl_core/log.hpp"
+#include "mgl_core/lz4.hpp"
+
+#include <algorithm>
+
+namespace mgl::registry::pak
+{
+  uint64_t hash(std::string_view name)
+  {
+    uint64_t h = 14695981039346656037ull;
+    for(char c : name)
+    {
+      h ^= static_cast<uint8_t>(c);
+      h *= 1099511628211ull;
+    }
+    return h;
+  }
+
+  void writer::add(const std::string& name, const mgl::uint8_buffer& data, bool compress)
+  {
+    item i = { path_index::normalize(name), data, compression::none, data.size() };
+
+    if(compress && !data.empty())
+    {
+      mgl::uint8_buffer compressed;
+      mgl::lz4::compress(data.data(), data.size(), compressed);
+
+      if(compressed.size() <= data.size() - data.size() / 8)
+      {
+        i.data = std::move(compressed);
+        i.method = compression::lz4;
+      }
+    }
+
+    m_items.push_back(std::move(i));
+  }
+
+  static void pad(const mgl::io::ofstream_ref& stream, uint64_t& offset)
+  {
+    static const char zeros[ALIGNMENT] = {};
+    uint64_t padding = (ALIGNMENT - offset % ALIGNMENT) % ALIGNMENT;
+    stream->write(zeros, padding);
+    offset += padding;
+  }
+
+  bool writer::write(const mgl::path& path) const
+  {
+    auto stream = mgl::create_ref<std::ofstream>(path, std::ios::out | std::ios::binary);
+    if(!stream->is_open())
+    {
+      MGL_CORE_ERROR("pak: failed to open {} for writing", path.string());
+      return false;
+    }
+
+    mgl::list<entry> entries;
+    std::string names;
+    entries.reserve(m_items.size());
+
+    header h = {};
+    h.magic = MAGIC;
+    h.version = VERSION;
+    h.entry_count = static_cast<uint32_t>(m_items.size());
+
+    stream->write(reinterpret_cast<const char*>(&h), sizeof(h));
+    uint64_t offset = sizeof(h);
+
+    for(auto&& i : m_items)
+    {
+      pad(stream, offset);
+
+      entry e = {};
+      e.hash = hash(i.name);
+      e.offset = offset;
+      e.stored_size = i.data.size();
+      e.size = i.size;
+      e.name_offset = static_cast<uint32_t>(names.size());
+      e.name_size = static_cast<uint32_t>(i.name.size());
+      e.method = i.method;
+      entries.push_back(e);
+
+      names += i.name;
+      stream->write(reinterpret_cast<const char*>(i.data.data()), i.data.size());
+      offset += i.data.size();
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const entry& a, const entry& b) {
+      return a.hash < b.hash;
+    });
+
+    pad(stream, offset);
+    h.entries_offset = offset;
+    stream->write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(entry));
+    offset += entries.size() * sizeof(entry);
+
+    h.names_offset = offset;
+    h.names_size = static_cast<uint32_t>(names.size());
+    stream->write(names.data(), names.size());
+
+    stream->seekp(0);
+    stream->write(reinterpret_cast<const char*>(&h), sizeof(h));
+    stream->close();
+
+    if(stream->fail())
+    {
+      MGL_CORE_ERROR("pak: failed to write {}", path.string());
+      return false;
+    }
+
+    return true;
+  }
+
+} // namespace mgl::registry::pak
@@ -2,10 +2,20 @@
 #include "mgl_core/debug.hpp"
 #include "mgl_core/zip.hpp"
 #include "mgl_registry/locations/local.hpp"
+#include "mgl_registry/locations/pak.hpp"
 #include "mgl_registry/locations/zip.hpp"
 
+#include <atomic>
+
 namespace mgl::registry
 {
+  // Loaders are keyed by type and extension so a format can back several resource types,
+  // e.g. an .ogg file can be loaded as a sound or streamed as music
+  static std::string loader_key(resource::type type, const std::string& extension)
+  {
+    return resource::type_name(type) + extension;
+  }
+
   registry::registry()
   {
     {
@@ -16,6 +26,9 @@ namespace mgl::registry
       location_factory_ref zip_factory = mgl::create_scope<zip_location>();
       register_location_factory(zip_factory);
 
+      location_factory_ref pak_factory = mgl::create_scope<pak_location>();
+      register_location_factory(pak_factory);
+
       // Register loaders
       loader_ref image_loader = mgl::create_scope<loaders::image_loader>();
       register_loader(image_loader);
@@ -28,6 +41,12 @@ namespace mgl::registry
 
       loader_ref font_loader = mgl::create_scope<loaders::font_loader>();
       register_loader(font_loader);
+
+      loader_ref sound_loader = mgl::create_scope<loaders::sound_loader>();
+      register_loader(sound_loader);
+
+      loader_ref music_loader = mgl::create_scope<loaders::music_loader>();
+      register_loader(music_loader);
     }
   }
 
@@ -69,9 +88,10 @@ namespace mgl::registry
 
       auto location = f->factory(url);
 
-      if(m_locations.find(type) == m_locations.end())
-        m_locations[type] = locations();
+      // Index on registration so find() is a hash lookup instead of a probe per location
+      location->refresh();
 
+      std::unique_lock lock(m_locations_mutex);
       auto& locations = m_locations[type];
 
       for(auto&& l : locations)
@@ -95,12 +115,15 @@ namespace mgl::registry
   {
     string_list extensions = loader->get_extensions();
     string_list extensions_to_handle;
+    auto type = loader->get_type();
 
     for(const auto& extension : extensions)
     {
-      if(m_loaders.find(extension) != m_loaders.end())
+      if(m_loaders.find(loader_key(type, extension)) != m_loaders.end())
       {
-        MGL_CORE_ERROR("Loader already registered for extension: {}, skipping", extension);
+        MGL_CORE_ERROR("Loader already registered for {} extension: {}, skipping",
+                       resource::type_name(type),
+                       extension);
         continue;
       }
 
@@ -124,7 +147,7 @@ namespace mgl::registry
 
     for(const auto& extension : extensions_to_handle)
     {
-      m_loaders[extension] = info;
+      m_loaders[loader_key(type, extension)] = info;
     }
 
     return true;
@@ -132,16 +155,16 @@ namespace mgl::registry
 
   const location_ref registry::find(resource::type type, const std::string& path)
   {
-    static const std::string types_names[] = { "image", "shader", "font",   "sound", "music",
-                                               "text",  "json",   "binary", "custom" };
-
-    if(m_locations.find(type) == m_locations.end())
+    // Shared with the load_async workers and the prefetch task, registration takes it exclusively
+    std::shared_lock lock(m_locations_mutex);
+    auto it = m_locations.find(type);
+    if(it == m_locations.end())
     {
-      MGL_CORE_ERROR("No locations registered for type: {}", types_names[(int)type]);
+      MGL_CORE_ERROR("No locations registered for type: {}", resource::type_name(type));
       return nullptr;
     }
 
-    auto& locations = m_locations[type];
+    auto& locations = it->second;
 
     for(auto&& base : locations)
     {
@@ -167,18 +190,241 @@ namespace mgl::registry
 
     auto extension = mgl::path(path).extension().string();
 
-    if(m_loaders.find(extension) == m_loaders.end())
+    auto loader = m_loaders.find(loader_key(type, extension));
+    if(loader == m_loaders.end())
     {
-      MGL_CORE_ERROR("No loader registered for extension: {}", extension);
+      MGL_CORE_ERROR(
+          "No loader registered for {} extension: {}", resource::type_name(type), extension);
       return nullptr;
     }
 
-    auto& loader = m_loaders[extension];
-    return loader->loader->load(location, path, options);
+    resource_cache::key key = {
+      type, (location->path() / path).lexically_normal().string(), options.hash()
+    };
+
+    // The cache is checked under the lock, a finished decode is cached before it is removed from
+    // the loading map so a later request always finds one or the other
+    std::promise<resource_ref> promise;
+    resource_future pending;
+    {
+      std::lock_guard<std::mutex> lock(m_loading_mutex);
+
+      auto cached = m_cache.get(key);
+      if(cached != nullptr)
+      {
+        return cached;
+      }
+
+      auto it = m_loading.find(key);
+      if(it != m_loading.end())
+      {
+        pending = it->second;
+      }
+      else
+      {
+        m_loading.emplace(key, promise.get_future().share());
+      }
+    }
+
+    if(pending.valid())
+    {
+      return pending.get();
+    }
+
+    auto resource = loader->second->loader->load(location, path, options);
+
+    if(resource != nullptr)
+    {
+      m_cache.put(key, resource);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_loading_mutex);
+      m_loading.erase(key);
+    }
+
+    promise.set_value(resource);
+    return resource;
+  }
+
+  texture_data_ref registry::load_texture(const std::string& path, const texture_options& options)
+  {
+    auto& location = find(resource::type::image, path);
+
+    if(location == nullptr)
+    {
+      MGL_CORE_ERROR("Failed to find resource: {}", path);
+      return nullptr;
+    }
+
+    // The source bytes are hashed to find the cached chain and only decoded on a miss
+    mgl::uint8_buffer source;
+    location->read(path, source);
+
+    if(source.empty())
+    {
+      MGL_CORE_ERROR("Failed to read image file: {}", path);
+      return nullptr;
+    }
+
+    auto decode = [](const uint8_t* data, size_t size) {
+      return loaders::image_loader::decode(data, size, {});
+    };
+
+    auto data = m_textures.load(source.data(), source.size(), options, decode);
+
+    if(data == nullptr)
+    {
+      MGL_CORE_ERROR("Failed to read image file: {}", path);
+    }
+
+    return data;
+  }
+
+  mgl::string_list registry::invalidate_include(const std::string& path)
+  {
+    auto& location = find(resource::type::shader, path);
+
+    if(location == nullptr)
+    {
+      MGL_CORE_ERROR("Failed to find resource: {}", path);
+      return {};
+    }
+
+    auto shaders = m_includes.invalidate(shader_preprocessor::file_key(location, path));
+
+    for(auto& shader : shaders)
+    {
+      m_cache.remove(resource::type::shader, shader);
+    }
+
+    return shaders;
+  }
+
+  mgl::thread_pool& registry::pool()
+  {
+    std::lock_guard<std::mutex> lock(m_pool_mutex);
+    if(m_pool == nullptr)
+    {
+      m_pool = mgl::create_scope<mgl::thread_pool>();
+    }
+    return *m_pool;
+  }
+
+  void registry::post_completion(std::function<void()> completion)
+  {
+    std::lock_guard<std::mutex> lock(m_completions_mutex);
+    m_completions.push_back(std::move(completion));
+  }
+
+  resource_future registry::load_async(resource::type type,
+                                       const std::string& path,
+                                       const loader_options& options,
+                                       const load_callback& on_complete)
+  {
+    auto opts = options.clone();
+    return pool()
+        .submit([this, type, path, opts, on_complete]() {
+          auto resource = load(type, path, *opts);
+          if(on_complete != nullptr)
+          {
+            post_completion([on_complete, resource]() { on_complete(resource); });
+          }
+          return resource;
+        })
+        .share();
+  }
+
+  mgl::list<resource_future> registry::load_many(const mgl::list<load_request>& requests,
+                                                 const load_many_callback& on_complete)
+  {
+    mgl::list<resource_future> futures;
+    futures.reserve(requests.size());
+
+    if(requests.empty())
+    {
+      if(on_complete != nullptr)
+      {
+        post_completion([on_complete]() { on_complete({}); });
+      }
+      return futures;
+    }
+
+    // The last request to finish posts the completion with every result in request order
+    auto results = mgl::create_ref<resource_list>(requests.size());
+    auto remaining = mgl::create_ref<std::atomic<size_t>>(requests.size());
+
+    for(size_t i = 0; i < requests.size(); i++)
+    {
+      auto& request = requests[i];
+      auto opts = request.options != nullptr ? request.options->clone()
+                                             : mgl::create_ref<loader_options>();
+      auto future = pool().submit([this, i, request, opts, results, remaining, on_complete]() {
+        auto resource = load(request.type, request.path, *opts);
+        (*results)[i] = resource;
+        if(remaining->fetch_sub(1) == 1 && on_complete != nullptr)
+        {
+          post_completion([on_complete, results]() { on_complete(*results); });
+        }
+        return resource;
+      });
+      futures.push_back(future.share());
+    }
+
+    return futures;
+  }
+
+  prefetch_future registry::prefetch(const manifest& manifest, const std::string& stage)
+  {
+    if(!manifest.has_stage(stage))
+    {
+      MGL_CORE_ERROR("Manifest has no stage: {}", stage);
+    }
+
+    return prefetch(manifest.assets(stage));
+  }
+
+  prefetch_future registry::prefetch(const mgl::list<manifest::asset>& assets)
+  {
+    // A single task reads the assets in order, which keeps the disk access sequential
+    return pool()
+        .submit([this, assets]() {
+          size_t bytes = 0;
+          for(auto& asset : assets)
+          {
+            auto location = find(asset.type, asset.path);
+            if(location != nullptr)
+              bytes += location->prefetch(asset.path);
+          }
+          return bytes;
+        })
+        .share();
+  }
+
+  size_t registry::dispatch_completions()
+  {
+    mgl::list<std::function<void()>> completions;
+    {
+      std::lock_guard<std::mutex> lock(m_completions_mutex);
+      completions.swap(m_completions);
+    }
+
+    for(auto& completion : completions)
+    {
+      completion();
+    }
+
+    return completions.size();
+  }
+
+  void registry::wait()
+  {
+    pool().wait();
   }
 
   bool registry::exists(const std::string& path) const
   {
+    std::shared_lock lock(m_locations_mutex);
     for(auto&& [type, locations] : m_locations)
     {
       for(auto&& location : locations)
@@ -191,4 +437,14 @@ namespace mgl::registry
     return false;
   }
 
+  void registry::refresh()
+  {
+    std::unique_lock lock(m_locations_mutex);
+    for(auto&& [type, locations] : m_locations)
+    {
+      for(auto&& location : locations)
+        location->refresh();
+    }
+  }
+
 } // namespace mgl::registry
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "mgl_registry/resources/image.hpp"
 #include "mgl_core/debug.hpp"
+#include "mgl_registry/image_ops.hpp"
 
 #define STB_IMAGE_WRITE_IMPLEMENTATION 1
 #include "stb/stb_image_write.h"
@@ -27,25 +28,53 @@ namespace mgl::registry
 
   void image::blit(int32_t x, int32_t y, const image& image, const mgl::rect& rect)
   {
-    MGL_CORE_ASSERT(x >= 0 && x <= m_width, "X is out of bounds");
-    MGL_CORE_ASSERT(y >= 0 && y <= m_height, "Y is out of bounds");
     MGL_CORE_ASSERT(m_channels >= 1 && m_channels <= 4, "Invalid number of channels");
     MGL_CORE_ASSERT(m_channels == image.m_channels, "Invalid number of channels, must be the same")
 
-    int32_t width = std::min(static_cast<int32_t>(rect.width), m_width - x);
-    int32_t height = std::min(static_cast<int32_t>(rect.height), m_height - y);
+    // Clip the source rect to the source image, then the destination to this image
+    int32_t sx = rect.x, sy = rect.y, width = rect.width, height = rect.height;
 
-    for(int32_t i = 0; i < height; ++i)
+    if(sx < 0)
     {
-      for(int32_t j = 0; j < width; ++j)
-      {
-        std::copy(image.m_data.begin() + (rect.y + i) * image.m_width * m_channels +
-                      (rect.x + j) * m_channels,
-                  image.m_data.begin() + (rect.y + i) * image.m_width * m_channels +
-                      (rect.x + j) * m_channels + m_channels,
-                  m_data.begin() + (y + i) * m_width * m_channels + (x + j) * m_channels);
-      }
+      x -= sx;
+      width += sx;
+      sx = 0;
+    }
+    if(sy < 0)
+    {
+      y -= sy;
+      height += sy;
+      sy = 0;
+    }
+    width = std::min(width, image.m_width - sx);
+    height = std::min(height, image.m_height - sy);
+
+    if(x < 0)
+    {
+      sx -= x;
+      width += x;
+      x = 0;
+    }
+    if(y < 0)
+    {
+      sy -= y;
+      height += y;
+      y = 0;
     }
+    width = std::min(width, m_width - x);
+    height = std::min(height, m_height - y);
+
+    if(width <= 0 || height <= 0)
+      return;
+
+    const size_t src_stride = (size_t)image.m_width * m_channels;
+    const size_t dst_stride = (size_t)m_width * m_channels;
+    image_ops::copy_rect(image.m_data.data() + sy * src_stride + (size_t)sx * m_channels,
+                         src_stride,
+                         m_data.data() + y * dst_stride + (size_t)x * m_channels,
+                         dst_stride,
+                         (size_t)width * m_channels,
+                         height);
   }
 
   image_ref image::crop(int32_t x, int32_t y, int32_t width, int32_t height) const
@@ -57,16 +86,14 @@ namespace mgl::registry
 
     auto result = mgl::create_ref<image>(width, height, m_channels);
 
-    for(int32_t i = 0; i < height; ++i)
-    {
-      for(int32_t j = 0; j < width; ++j)
-      {
-        std::copy(m_data.begin() + (y + i) * m_width * m_channels + (x + j) * m_channels,
-                  m_data.begin() + (y + i) * m_width * m_channels + (x + j) * m_channels +
-                      m_channels,
-                  result->m_data.begin() + i * width * m_channels + j * m_channels);
-      }
-    }
+    const size_t stride = (size_t)m_width * m_channels;
+    const size_t row_bytes = (size_t)width * m_channels;
+    image_ops::copy_rect(m_data.data() + y * stride + (size_t)x * m_channels,
+                         stride,
+                         result->m_data.data(),
+                         row_bytes,
+                         row_bytes,
+                         height);
 
     return result;
   }
@@ -74,11 +101,17 @@ namespace mgl::registry
   image_ref image::flip_vertically() const
   {
     auto result = mgl::create_ref<image>(m_width, m_height, m_channels);
-    for(int32_t i = 0; i < m_height; ++i)
+
+    // A negative source stride copies the rows bottom up
+    const ptrdiff_t stride = (ptrdiff_t)m_width * m_channels;
+    if(m_height > 0)
     {
-      std::copy(m_data.begin() + i * m_width * m_channels,
-                m_data.begin() + i * m_width * m_channels + m_width * m_channels,
-                result->m_data.begin() + (m_height - i - 1) * m_width * m_channels);
+      image_ops::copy_rect(m_data.data() + (m_height - 1) * stride,
+                           -stride,
+                           result->m_data.data(),
+                           stride,
+                           stride,
+                           m_height);
     }
 
     return result;
@@ -88,15 +121,11 @@ namespace mgl::registry
   {
     auto result = mgl::create_ref<image>(m_width, m_height, m_channels);
 
+    const size_t stride = (size_t)m_width * m_channels;
     for(int32_t i = 0; i < m_height; ++i)
     {
-      for(int32_t j = 0; j < m_width; ++j)
-      {
-        std::copy(m_data.begin() + i * m_width * m_channels + j * m_channels,
-                  m_data.begin() + i * m_width * m_channels + j * m_channels + m_channels,
-                  result->m_data.begin() + i * m_width * m_channels +
-                      (m_width - j - 1) * m_channels);
-      }
+      image_ops::reverse_row(
+          m_data.data() + i * stride, result->m_data.data() + i * stride, m_width, m_channels);
     }
 
     return result;
@@ -109,18 +138,35 @@ namespace mgl::registry
     return result;
   }
 
+  image_ref image::to_rgba() const
+  {
+    auto result = mgl::create_ref<image>(m_width, m_height, 4);
+    image_ops::expand_to_rgba(
+        m_data.data(), result->m_data.data(), (size_t)m_width * m_height, m_channels);
+    return result;
+  }
+
+  void image::swizzle(const std::array<uint8_t, 4>& order)
+  {
+    image_ops::swizzle(m_data.data(), (size_t)m_width * m_height, m_channels, order.data());
+  }
+
+  void image::premultiply_alpha()
+  {
+    image_ops::premultiply_alpha(m_data.data(), (size_t)m_width * m_height, m_channels);
+  }
+
   void image::put_pixel(int32_t x, int32_t y, const glm::vec4& color)
   {
-    MGL_CORE_ASSERT(x >= 0 && x <= m_width, "X is out of bounds");
-    MGL_CORE_ASSERT(y >= 0 && y <= m_height, "Y is out of bounds");
+    MGL_CORE_ASSERT(x >= 0 && x < m_width, "X is out of bounds");
+    MGL_CORE_ASSERT(y >= 0 && y < m_height, "Y is out of bounds");
     MGL_CORE_ASSERT(m_channels >= 1 && m_channels <= 4, "Invalid number of channels");
-    uint8_t data[m_channels];
+
+    uint8_t* pixel = m_data.data() + ((size_t)y * m_width + x) * m_channels;
     for(int32_t i = 0; i < m_channels; ++i)
     {
-      data[i] = color[i] * 255;
+      pixel[i] = color[i] * 255;
     }
-
-    std::copy(data, data + m_channels, m_data.begin() + y * m_width * m_channels + x * m_channels);
   }
 
   void image::resize(int32_t width, int32_t height)
@@ -131,12 +177,12 @@ namespace mgl::registry
     int32_t new_width = std::min(width, m_width);
     int32_t new_height = std::min(height, m_height);
 
-    for(int32_t i = 0; i < new_height; ++i)
-    {
-      std::copy(m_data.begin() + i * m_width * m_channels,
-                m_data.begin() + i * m_width * m_channels + new_width * m_channels,
-                new_buffer.begin() + i * width * m_channels);
-    }
+    image_ops::copy_rect(m_data.data(),
+                         (size_t)m_width * m_channels,
+                         new_buffer.data(),
+                         (size_t)width * m_channels,
+                         (size_t)new_width * m_channels,
+                         new_height);
 
     m_width = width;
     m_height = height;
@@ -148,7 +194,8 @@ namespace mgl::registry
     MGL_CORE_ASSERT(x >= 0 && x < m_width, "X is out of bounds");
     MGL_CORE_ASSERT(y >= 0 && y < m_height, "Y is out of bounds");
 
-    glm::vec4 color;
+    // Channels the image doesn't have read as black and opaque
+    glm::vec4 color(0.0f, 0.0f, 0.0f, 1.0f);
     for(int32_t i = 0; i < m_channels; ++i)
     {
       color[i] = m_data[y * m_width * m_channels + x * m_channels + i] / 255.0f;
@@ -160,17 +207,14 @@ namespace mgl::registry
   void image::fill(const glm::vec4& color)
   {
     MGL_CORE_ASSERT(m_channels >= 1 && m_channels <= 4, "Invalid number of channels");
-    uint8_t data[m_channels];
+    uint8_t pixel[4];
 
     for(int32_t i = 0; i < m_channels; ++i)
     {
-      data[i] = color[i] * 255;
+      pixel[i] = color[i] * 255;
     }
 
-    for(int32_t i = 0; i < m_width * m_height; ++i)
-    {
-      std::copy(data, data + m_channels, m_data.begin() + i * m_channels);
-    }
+    image_ops::fill(m_data.data(), (size_t)m_width * m_height, pixel, m_channels);
   }
 
   void image::save(const std::string& path, const location_ref& location) const
@@ -4,12 +4,18 @@
 #include "mgl_core/memory.hpp"
 #include "mgl_core/string.hpp"
 #include "mgl_core/zip.hpp"
+#include <algorithm>
 #include <regex>
 
 namespace mgl::registry
 {
-  shader::shader(const std::string& source, shader::type type)
+  shader::shader(const std::string& source, shader::type type, const mgl::string_list& files)
+      : m_files(files)
   {
+    // Lines trimmed before #version still count for the #line directive emitted in source()
+    auto first = std::min(source.find_first_not_of(" \t\r\n"), source.size());
+    auto leading = std::count(source.begin(), source.begin() + first, '\n');
+
     auto src = mgl::trim(source);
     auto lines = mgl::split(src, '\n');
     MGL_CORE_ASSERT(mgl::starts_with(lines[0], "#version"),
@@ -17,74 +23,10 @@ namespace mgl::registry
 
     m_type = type;
     m_version = mgl::to_int(lines[0].substr(sizeof("#version")));
+    m_first_line = static_cast<int>(leading) + 2;
     m_source = mgl::join('\n', lines, 1);
   }
 
-  bool shader::handle_includes(const location_ref& location, int depth, int source_id)
-  {
-    if(depth > 10)
-    {
-      MGL_CORE_ERROR("Too many includes in shader source");
-      return false;
-    }
-
-    std::string source = m_source;
-    std::string include = "#include";
-    std::string::size_type pos = source.find(include);
-
-    while(pos != std::string::npos)
-    {
-      std::string::size_type start = source.find("\"", pos + include.size());
-      std::string::size_type end = source.find("\"", start + 1);
-
-      if(start == std::string::npos || end == std::string::npos)
-      {
-        MGL_CORE_ERROR("Invalid include directive in shader source");
-        return false;
-      }
-
-      std::string include_path = source.substr(start + 1, end - start - 1);
-
-      mgl::io::istream_ref file = location->open_read(include_path);
-
-      if(!file)
-      {
-        MGL_CORE_ERROR("Failed to read include file: {}", include_path);
-        return false;
-      }
-
-      std::string include_source((std::istreambuf_iterator<char>(*file)),
-                                 std::istreambuf_iterator<char>());
-
-      if(include_source.empty())
-      {
-        MGL_CORE_ERROR("Failed to read include file: {}", include_path);
-        return false;
-      }
-
-      std::string include_directive = source.substr(pos, end - pos + 1);
-      source.replace(pos, end - pos + 1, include_source);
-
-      mgl::string_list lines = mgl::split(include_source, '\n');
-
-      for(const std::string& line : lines)
-      {
-        if(line.find(include) != std::string::npos)
-        {
-          if(!handle_includes(location, depth + 1, source_id))
-          {
-            return false;
-          }
-        }
-      }
-
-      pos = source.find(include, pos + include_source.size());
-    }
-
-    m_source = source;
-    return true;
-  }
-
   const std::string shader::vertex(const shader_defines& defines)
   {
     if(m_type != shader::type::VERTEX_SHADER && m_type != shader::type::GENERIC_PROGRAM)
@@ -152,13 +94,11 @@ namespace mgl::registry
       str_defines.push_back(std::format("#define {} {}", key, value));
     }
 
-    auto line = (int)str_defines.size() + 2;
-
-    return std::format("#version {}\n#define {}\n{}\n#line {}\n{}",
+    return std::format("#version {}\n#define {}\n{}\n#line {} 0\n{}",
                        m_version,
                        s_shaders_text[type],
                        mgl::join('\n', str_defines),
-                       line,
+                       m_first_line,
                        m_source);
   }
 
@@ -171,10 +111,11 @@ namespace mgl::registry
       str_defines.push_back(std::format("#define {} {}", key, value));
     }
 
-    auto line = (int)str_defines.size() + 1;
-
-    return std::format(
-        "#version {}\n{}\n#line {}\n{}", m_version, mgl::join('\n', str_defines), line, m_source);
+    return std::format("#version {}\n{}\n#line {} 0\n{}",
+                       m_version,
+                       mgl::join('\n', str_defines),
+                       m_first_line,
+                       m_source);
   }
 
 } // namespace mgl::registry
\ No newline at end of file
@@ -0,0 +1,243 @@
+#include "mgl_registry/shader_preprocessor.hpp"
+
+#include "mgl_core/debug.hpp"
+#include "mgl_core/log.hpp"
+
+#include <format>
+#include <mutex>
+
+namespace mgl::registry
+{
+  static constexpr size_t MAX_INCLUDE_DEPTH = 32;
+
+  // Returns the include path if line is an include directive, e.g. #include "common/light.glsl"
+  static bool parse_include(std::string_view line, std::string& path)
+  {
+    size_t pos = line.find_first_not_of(" \t");
+    if(pos == std::string_view::npos || line[pos] != '#')
+      return false;
+
+    pos = line.find_first_not_of(" \t", pos + 1);
+    if(pos == std::string_view::npos || line.compare(pos, 7, "include") != 0)
+      return false;
+
+    pos = line.find_first_not_of(" \t", pos + 7);
+    if(pos == std::string_view::npos || (line[pos] != '"' && line[pos] != '<'))
+      return false;
+
+    char close = line[pos] == '"' ? '"' : '>';
+    size_t end = line.find(close, pos + 1);
+    if(end == std::string_view::npos || end == pos + 1)
+      return false;
+
+    path = std::string(line.substr(pos + 1, end - pos - 1));
+    return true;
+  }
+
+  shader_preprocessor::parsed_file_ref shader_preprocessor::parse(const std::string& source)
+  {
+    auto file = mgl::create_ref<parsed_file>();
+    std::string_view view = source;
+    int32_t line = 1;
+
+    for(size_t pos = 0; pos < view.size(); line++)
+    {
+      size_t end = view.find('\n', pos);
+      std::string_view text = view.substr(pos, end == std::string_view::npos ? end : end - pos);
+      pos = end == std::string_view::npos ? view.size() : end + 1;
+
+      std::string path;
+      if(parse_include(text, path))
+      {
+        file->push_back({ std::move(path), line, true });
+        continue;
+      }
+
+      if(file->empty() || file->back().include)
+        file->push_back({ "", line, false });
+
+      auto& run = file->back().text;
+      run.append(text);
+      run.push_back('\n');
+    }
+
+    return file;
+  }
+
+  std::string shader_preprocessor::file_key(const location_ref& location, const std::string& path)
+  {
+    return (location->path() / path).lexically_normal().string();
+  }
+
+  shader_preprocessor::parsed_file_ref shader_preprocessor::open(const location_ref& location,
+                                                                 const std::string& path)
+  {
+    auto key = file_key(location, path);
+
+    {
+      std::shared_lock lock(m_mutex);
+      auto it = m_files.find(key);
+      if(it != m_files.end())
+        return it->second;
+    }
+
+    mgl::uint8_buffer buffer;
+    location->read(path, buffer);
+
+    if(buffer.empty())
+      return nullptr;
+
+    auto file = parse(std::string(buffer.begin(), buffer.end()));
+
+    // Another thread may have parsed it meanwhile, both results are the same
+    std::unique_lock lock(m_mutex);
+    return m_files.emplace(key, file).first->second;
+  }
+
+  bool shader_preprocessor::expand(expansion& state,
+                                   const parsed_file& file,
+                                   const std::string& path,
+                                   int32_t id)
+  {
+    auto& out = state.out;
+
+    for(auto& c : file)
+    {
+      if(!c.include)
+      {
+        out.source.append(c.text);
+        continue;
+      }
+
+      // Paths are relative to the including file first and to the location root otherwise
+      auto include = path_index::normalize((mgl::path(path).parent_path() / c.text).string());
+      if(!state.location->exists(include))
+        include = path_index::normalize(c.text);
+
+      if(!state.location->exists(include))
+      {
+        MGL_CORE_ERROR("Failed to read include file: {} ({}:{})", c.text, path, c.line);
+        return false;
+      }
+
+      auto key = file_key(state.location, include);
+
+      if(mgl::in(key, state.stack))
+      {
+        MGL_CORE_ERROR("Recursive include of {} ({}:{})", c.text, path, c.line);
+        return false;
+      }
+
+      if(state.stack.size() >= MAX_INCLUDE_DEPTH)
+      {
+        MGL_CORE_ERROR("Too many nested includes ({}:{})", path, c.line);
+        return false;
+      }
+
+      auto parsed = open(state.location, include);
+      if(parsed == nullptr)
+      {
+        MGL_CORE_ERROR("Failed to read include file: {} ({}:{})", c.text, path, c.line);
+        return false;
+      }
+
+      auto [it, added] = state.ids.emplace(key, static_cast<int32_t>(out.files.size()));
+      if(added)
+        out.files.push_back(key);
+
+      out.source.append(std::format("#line 1 {}\n", it->second));
+
+      state.stack.push_back(key);
+      bool expanded = expand(state, *parsed, include, it->second);
+      state.stack.pop_back();
+
+      if(!expanded)
+        return false;
+
+      out.source.append(std::format("#line {} {}\n", c.line + 1, id));
+    }
+
+    return true;
+  }
+
+  bool shader_preprocessor::preprocess(const location_ref& location,
+                                       const std::string& path,
+                                       const std::string& source,
+                                       result& out)
+  {
+    MGL_CORE_ASSERT(location != nullptr, "Location is null");
+
+    auto key = file_key(location, path);
+
+    out.source.clear();
+    out.source.reserve(source.size());
+    out.files = { key };
+
+    expansion state = { location, out, { { key, 0 } }, { key } };
+
+    if(!expand(state, *parse(source), path_index::normalize(path), 0))
+      return false;
+
+    mgl::string_list dependencies(out.files.begin() + 1, out.files.end());
+
+    std::unique_lock lock(m_mutex);
+
+    // Replace the edges of a previous expansion, the shader may have changed its includes
+    auto previous = m_dependencies.find(key);
+    if(previous != m_dependencies.end())
+    {
+      for(auto& file : previous->second)
+        m_dependents[file].erase(key);
+    }
+
+    for(auto& file : dependencies)
+      m_dependents[file].insert(key);
+
+    m_dependencies[key] = std::move(dependencies);
+    return true;
+  }
+
+  mgl::string_list shader_preprocessor::dependents(const std::string& file) const
+  {
+    std::shared_lock lock(m_mutex);
+
+    auto it = m_dependents.find(file);
+    if(it == m_dependents.end())
+      return {};
+
+    return mgl::string_list(it->second.begin(), it->second.end());
+  }
+
+  mgl::string_list shader_preprocessor::dependencies(const std::string& shader) const
+  {
+    std::shared_lock lock(m_mutex);
+
+    auto it = m_dependencies.find(shader);
+    return it != m_dependencies.end() ? it->second : mgl::string_list();
+  }
+
+  mgl::string_list shader_preprocessor::invalidate(const std::string& file)
+  {
+    {
+      std::unique_lock lock(m_mutex);
+      m_files.erase(file);
+    }
+
+    return dependents(file);
+  }
+
+  void shader_preprocessor::clear()
+  {
+    std::unique_lock lock(m_mutex);
+    m_files.clear();
+    m_dependencies.clear();
+    m_dependents.clear();
+  }
+
+  size_t shader_preprocessor::cached_files() const
+  {
+    std::shared_lock lock(m_mutex);
+    return m_files.size();
+  }
+
+} // namespace mgl::registry
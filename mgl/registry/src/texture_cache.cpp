@@ -0,0 +1,417 @@
+#include "mgl_registry/texture_cache.hpp"
+#include "mgl_registry/image_ops.hpp"
+
+#include "mgl_core/debug.hpp"
+#include "mgl_core/log.hpp"
+#include "mgl_core/mapped_file.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <thread>
+
+namespace mgl::registry
+{
+  /**
+   * Layout of a cached texture blob, all values are little endian:
+   *
+   *   header
+   *   level table, largest level first
+   *   level pixels, each one starting on a 16 byte boundary
+   *
+   * The same layout is used for chains built in memory, so mapped and built chains are read by the
+   * same code.
+   */
+  static constexpr uint32_t BLOB_MAGIC = 0x5845544D; // "MTEX"
+  static constexpr uint32_t BLOB_VERSION = 1;
+  static constexpr size_t BLOB_ALIGNMENT = 16;
+  static constexpr const char* BLOB_EXTENSION = ".mtex";
+
+  struct blob_header
+  {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    int32_t channels;
+    uint32_t options;
+    uint32_t level_count;
+    uint32_t reserved;
+  };
+
+  struct blob_level
+  {
+    uint64_t offset;
+    uint64_t size;
+    int32_t width;
+    int32_t height;
+  };
+
+  static_assert(sizeof(blob_header) == 32, "texture blob header layout changed");
+  static_assert(sizeof(blob_level) == 24, "texture blob level layout changed");
+
+  static size_t align_up(size_t value)
+  {
+    return (value + BLOB_ALIGNMENT - 1) & ~(BLOB_ALIGNMENT - 1);
+  }
+
+  static texture_options options_from_bits(uint32_t bits)
+  {
+    texture_options options;
+    options.premultiply_alpha = bits & 1;
+    options.srgb = bits & 2;
+    options.mipmaps = bits & 4;
+    options.flip_vertically = bits & 8;
+    return options;
+  }
+
+  // Validates the blob and points the levels into it, returns null if it is not a usable blob
+  static texture_data_ref
+  parse_blob(const uint8_t* data, size_t size, uint64_t key, const mgl::ref<const void>& storage)
+  {
+    if(size < sizeof(blob_header))
+      return nullptr;
+
+    blob_header header;
+    std::memcpy(&header, data, sizeof(header));
+
+    if(header.magic != BLOB_MAGIC || header.version != BLOB_VERSION || header.key != key)
+      return nullptr;
+
+    if(header.channels < 1 || header.channels > 4 || header.level_count == 0 ||
+       header.level_count > 32)
+      return nullptr;
+
+    size_t table_end = sizeof(blob_header) + header.level_count * sizeof(blob_level);
+    if(size < table_end)
+      return nullptr;
+
+    mgl::list<texture_data::level> levels;
+    levels.reserve(header.level_count);
+
+    for(uint32_t i = 0; i < header.level_count; i++)
+    {
+      blob_level l;
+      std::memcpy(&l, data + sizeof(blob_header) + i * sizeof(blob_level), sizeof(l));
+
+      size_t expected = (size_t)l.width * l.height * header.channels;
+      if(l.width < 1 || l.height < 1 || l.size != expected || l.offset < table_end ||
+         l.offset > size || l.size > size - l.offset)
+        return nullptr;
+
+      levels.push_back({ l.width, l.height, data + l.offset, (size_t)l.size });
+    }
+
+    return mgl::create_ref<texture_data>(
+        header.channels, options_from_bits(header.options), std::move(levels), storage);
+  }
+
+  // sRGB transfer functions, decoding is a table lookup and encoding a lookup in a finer table
+  static const std::array<float, 256>& srgb_to_linear_table()
+  {
+    static const std::array<float, 256> table = [] {
+      std::array<float, 256> t;
+      for(size_t i = 0; i < t.size(); i++)
+      {
+        float c = i / 255.0f;
+        t[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+      }
+      return t;
+    }();
+    return table;
+  }
+
+  static constexpr size_t LINEAR_STEPS = 4096;
+
+  static const std::array<uint8_t, LINEAR_STEPS>& linear_to_srgb_table()
+  {
+    static const std::array<uint8_t, LINEAR_STEPS> table = [] {
+      std::array<uint8_t, LINEAR_STEPS> t;
+      for(size_t i = 0; i < t.size(); i++)
+      {
+        float c = i / float(LINEAR_STEPS - 1);
+        float s = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+        t[i] = static_cast<uint8_t>(std::clamp(s, 0.0f, 1.0f) * 255.0f + 0.5f);
+      }
+      return t;
+    }();
+    return table;
+  }
+
+  static uint8_t encode_srgb(float linear)
+  {
+    float c = std::clamp(linear, 0.0f, 1.0f);
+    return linear_to_srgb_table()[static_cast<size_t>(c * (LINEAR_STEPS - 1) + 0.5f)];
+  }
+
+  // Grey and RGB images only have color channels, alpha is the last channel otherwise
+  static int32_t color_channels(int32_t channels)
+  {
+    return channels == 2 || channels == 4 ? channels - 1 : channels;
+  }
+
+  static void premultiply_srgb(uint8_t* data, size_t count, int32_t channels)
+  {
+    auto& to_linear = srgb_to_linear_table();
+    int32_t colors = channels - 1;
+
+    for(size_t i = 0; i < count; i++, data += channels)
+    {
+      float alpha = data[colors] / 255.0f;
+      for(int32_t c = 0; c < colors; c++)
+      {
+        data[c] = encode_srgb(to_linear[data[c]] * alpha);
+      }
+    }
+  }
+
+  // 2x2 box filter, odd edges reuse the last row or column
+  static void downsample(const uint8_t* src,
+                         int32_t src_width,
+                         int32_t src_height,
+                         uint8_t* dst,
+                         int32_t width,
+                         int32_t height,
+                         int32_t channels,
+                         bool srgb)
+  {
+    auto& to_linear = srgb_to_linear_table();
+    int32_t linear_channels = srgb ? color_channels(channels) : 0;
+    size_t src_stride = (size_t)src_width * channels;
+
+    for(int32_t y = 0; y < height; y++)
+    {
+      const uint8_t* row0 = src + std::min(2 * y, src_height - 1) * src_stride;
+      const uint8_t* row1 = src + std::min(2 * y + 1, src_height - 1) * src_stride;
+
+      for(int32_t x = 0; x < width; x++, dst += channels)
+      {
+        size_t x0 = (size_t)std::min(2 * x, src_width - 1) * channels;
+        size_t x1 = (size_t)std::min(2 * x + 1, src_width - 1) * channels;
+
+        for(int32_t c = 0; c < channels; c++)
+        {
+          if(c < linear_channels)
+          {
+            float sum = to_linear[row0[x0 + c]] + to_linear[row0[x1 + c]] +
+                        to_linear[row1[x0 + c]] + to_linear[row1[x1 + c]];
+            dst[c] = encode_srgb(sum * 0.25f);
+          }
+          else
+          {
+            dst[c] = static_cast<uint8_t>(
+                (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) >> 2);
+          }
+        }
+      }
+    }
+  }
+
+  static mgl::ref<mgl::uint8_buffer>
+  build_blob(const image_ref& source, const texture_options& options, uint64_t key)
+  {
+    int32_t channels = source->channels();
+    int32_t width = source->width();
+    int32_t height = source->height();
+
+    mgl::list<blob_level> levels;
+    for(;;)
+    {
+      levels.push_back({ 0, (uint64_t)width * height * channels, width, height });
+      if(!options.mipmaps || (width == 1 && height == 1))
+        break;
+      width = std::max(width / 2, 1);
+      height = std::max(height / 2, 1);
+    }
+
+    size_t offset = align_up(sizeof(blob_header) + levels.size() * sizeof(blob_level));
+    for(auto& l : levels)
+    {
+      l.offset = offset;
+      offset = align_up(offset + l.size);
+    }
+
+    auto blob = mgl::create_ref<mgl::uint8_buffer>(offset, 0);
+    uint8_t* data = blob->data();
+
+    blob_header header = {
+      BLOB_MAGIC, BLOB_VERSION, key, channels, (uint32_t)options.hash(), (uint32_t)levels.size(), 0
+    };
+    std::memcpy(data, &header, sizeof(header));
+    std::memcpy(data + sizeof(header), levels.data(), levels.size() * sizeof(blob_level));
+
+    auto& base = levels.front();
+    uint8_t* pixels = data + base.offset;
+    std::memcpy(pixels, source->data(), base.size);
+
+    if(options.flip_vertically)
+    {
+      image_ops::flip_vertically(pixels, base.width, base.height, channels);
+    }
+
+    if(options.premultiply_alpha && (channels == 2 || channels == 4))
+    {
+      size_t count = (size_t)base.width * base.height;
+      if(options.srgb)
+        premultiply_srgb(pixels, count, channels);
+      else
+        image_ops::premultiply_alpha(pixels, count, channels);
+    }
+
+    for(size_t i = 1; i < levels.size(); i++)
+    {
+      auto& src = levels[i - 1];
+      auto& dst = levels[i];
+      downsample(data + src.offset,
+                 src.width,
+                 src.height,
+                 data + dst.offset,
+                 dst.width,
+                 dst.height,
+                 channels,
+                 options.srgb);
+    }
+
+    return blob;
+  }
+
+  void texture_cache::set_directory(const mgl::path& directory)
+  {
+    m_directory = directory;
+
+    if(m_directory.empty())
+      return;
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_directory, ec);
+    if(ec)
+    {
+      MGL_CORE_ERROR("Failed to create texture cache directory: {}", m_directory.string());
+      m_directory.clear();
+    }
+  }
+
+  texture_data_ref texture_cache::load(const uint8_t* source,
+                                       size_t size,
+                                       const texture_options& options,
+                                       const decoder& decode)
+  {
+    MGL_CORE_ASSERT(decode != nullptr, "Texture cache needs a decoder");
+
+    uint64_t k = key(source, size, options);
+
+    mgl::path file;
+    if(enabled())
+    {
+      file = m_directory / std::format("{:016x}{}", k, BLOB_EXTENSION);
+
+      std::error_code ec;
+      if(std::filesystem::exists(file, ec))
+      {
+        auto mapped = mgl::create_ref<mgl::mapped_file>(file);
+        if(mapped->is_open())
+        {
+          auto data = parse_blob(mapped->data(), mapped->size(), k, mapped);
+          if(data != nullptr)
+            return data;
+        }
+
+        MGL_CORE_WARN("Discarding invalid texture cache entry: {}", file.string());
+      }
+    }
+
+    auto img = decode(source, size);
+    if(img == nullptr)
+      return nullptr;
+
+    auto blob = build_blob(img, options, k);
+    auto data = parse_blob(blob->data(), blob->size(), k, blob);
+    MGL_CORE_ASSERT(data != nullptr, "Built an invalid texture blob");
+
+    if(!file.empty())
+    {
+      // Written under a unique name and renamed, loaders racing on the same entry never see a
+      // partial blob
+      auto tid = std::hash<std::thread::id>{}(std::this_thread::get_id());
+      mgl::path temp = file;
+      temp += std::format(".{:x}.tmp", tid);
+
+      std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+      out.write(reinterpret_cast<const char*>(blob->data()), blob->size());
+      out.close();
+
+      std::error_code ec;
+      if(out.good())
+        std::filesystem::rename(temp, file, ec);
+
+      if(!out.good() || ec)
+      {
+        MGL_CORE_ERROR("Failed to write texture cache entry: {}", file.string());
+        std::filesystem::remove(temp, ec);
+      }
+    }
+
+    return data;
+  }
+
+  void texture_cache::clear()
+  {
+    if(!enabled())
+      return;
+
+    std::error_code ec;
+    for(auto& entry : std::filesystem::directory_iterator(m_directory, ec))
+    {
+      if(entry.path().extension() == BLOB_EXTENSION)
+        std::filesystem::remove(entry.path(), ec);
+    }
+  }
+
+  texture_data_ref texture_cache::build(const image_ref& source, const texture_options& options)
+  {
+    MGL_CORE_ASSERT(source != nullptr, "Image is null");
+    auto blob = build_blob(source, options, 0);
+    return parse_blob(blob->data(), blob->size(), 0, blob);
+  }
+
+  // MurmurHash64A over the source bytes, salted with the blob version and the options
+  uint64_t texture_cache::key(const uint8_t* source, size_t size, const texture_options& options)
+  {
+    const uint64_t m = 0xc6a4a7935bd1e995ull;
+    const int r = 47;
+
+    uint64_t seed = BLOB_VERSION * 0x9e3779b97f4a7c15ull ^ options.hash();
+    uint64_t h = seed ^ (size * m);
+
+    const uint8_t* end = source + (size & ~size_t(7));
+    for(const uint8_t* p = source; p != end; p += 8)
+    {
+      uint64_t k;
+      std::memcpy(&k, p, sizeof(k));
+
+      k *= m;
+      k ^= k >> r;
+      k *= m;
+
+      h ^= k;
+      h *= m;
+    }
+
+    size_t tail = size & 7;
+    if(tail)
+    {
+      uint64_t k = 0;
+      std::memcpy(&k, end, tail);
+      h ^= k;
+      h *= m;
+    }
+
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
+  }
+
+} // namespace mgl::registry
@@ -0,0 +1,8 @@
+#include "uniforms.glsl"
+
+layout(location = 0) in vec3 position;
+
+vec4 transform(vec4 p)
+{
+  return projection * view * model * p;
+}
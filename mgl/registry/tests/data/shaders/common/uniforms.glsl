@@ -0,0 +1,3 @@
+uniform mat4 view;
+uniform mat4 projection;
+uniform mat4 model;
@@ -0,0 +1,7 @@
+#version 330 core
+#include "common/transform.glsl"
+
+void main()
+{
+  gl_Position = transform(vec4(position, 1.0));
+}
@@ -0,0 +1,188 @@
+#include "mgl_registry/audio_stream.hpp"
+#include "mgl_registry/registry.hpp"
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <fstream>
+
+// Builds a PCM WAV file of the given samples, bits is 8, 16 or 32 (float)
+static mgl::uint8_buffer
+make_wav(int32_t channels, int32_t sample_rate, int32_t bits, const mgl::int16_buffer& samples)
+{
+  uint16_t format = bits == 32 ? 3 : 1;
+  uint32_t data_size = static_cast<uint32_t>(samples.size() * (bits / 8));
+
+  mgl::uint8_buffer wav;
+  auto put = [&](const void* data, size_t size) {
+    auto bytes = static_cast<const uint8_t*>(data);
+    wav.insert(wav.end(), bytes, bytes + size);
+  };
+  auto put_u32 = [&](uint32_t value) { put(&value, 4); };
+  auto put_u16 = [&](uint16_t value) { put(&value, 2); };
+
+  put("RIFF", 4);
+  put_u32(36 + data_size);
+  put("WAVE", 4);
+  put("fmt ", 4);
+  put_u32(16);
+  put_u16(format);
+  put_u16(static_cast<uint16_t>(channels));
+  put_u32(static_cast<uint32_t>(sample_rate));
+  put_u32(static_cast<uint32_t>(sample_rate * channels * (bits / 8)));
+  put_u16(static_cast<uint16_t>(channels * (bits / 8)));
+  put_u16(static_cast<uint16_t>(bits));
+  put("data", 4);
+  put_u32(data_size);
+
+  for(auto sample : samples)
+  {
+    if(bits == 8)
+    {
+      uint8_t value = static_cast<uint8_t>((sample >> 8) + 128);
+      put(&value, 1);
+    }
+    else if(bits == 16)
+      put(&sample, 2);
+    else
+    {
+      float value = sample / 32767.0f;
+      put(&value, 4);
+    }
+  }
+
+  return wav;
+}
+
+static mgl::int16_buffer make_samples(size_t count)
+{
+  mgl::int16_buffer samples(count);
+  for(size_t i = 0; i < count; i++)
+    samples[i] = static_cast<int16_t>(static_cast<int32_t>((i * 256) % 65536) - 32768);
+  return samples;
+}
+
+static mgl::io::istream_ref memory_stream(const mgl::uint8_buffer& data)
+{
+  return mgl::create_ref<mgl::io::memory_istream>(data.data(), data.size());
+}
+
+TEST(mgl_test_audio_stream, decode_wav)
+{
+  auto samples = make_samples(2 * 1000);
+  auto wav = make_wav(2, 44100, 16, samples);
+
+  auto stream = mgl::registry::audio_stream::open(memory_stream(wav));
+  ASSERT_NE(stream, nullptr);
+  EXPECT_EQ(stream->channels(), 2);
+  EXPECT_EQ(stream->sample_rate(), 44100);
+
+  mgl::int16_buffer decoded(samples.size());
+  EXPECT_EQ(stream->read(decoded.data(), 600), 600);
+  EXPECT_EQ(stream->read(decoded.data() + 1200, 600), 400);
+  EXPECT_EQ(stream->read(decoded.data(), 600), 0);
+  EXPECT_EQ(decoded, samples);
+
+  ASSERT_TRUE(stream->rewind());
+  mgl::int16_buffer first(2 * 10);
+  EXPECT_EQ(stream->read(first.data(), 10), 10);
+  EXPECT_TRUE(std::equal(first.begin(), first.end(), samples.begin()));
+}
+
+TEST(mgl_test_audio_stream, decode_wav_formats)
+{
+  auto samples = make_samples(512);
+
+  for(int32_t bits : { 8, 32 })
+  {
+    auto wav = make_wav(1, 22050, bits, samples);
+    auto stream = mgl::registry::audio_stream::open(memory_stream(wav));
+    ASSERT_NE(stream, nullptr);
+
+    mgl::int16_buffer decoded(samples.size());
+    ASSERT_EQ(stream->read(decoded.data(), decoded.size()), samples.size());
+
+    // 8 bit keeps the high byte, float is rounded on the way back
+    for(size_t i = 0; i < samples.size(); i++)
+      EXPECT_NEAR(decoded[i], samples[i], bits == 8 ? 256 : 1);
+  }
+}
+
+TEST(mgl_test_audio_stream, bounded_memory)
+{
+  // One minute of stereo at 44.1 kHz, about 10 MB of samples
+  const size_t frames = 60 * 44100;
+  auto path = std::filesystem::temp_directory_path() / "mgl_test_audio_stream.wav";
+
+  {
+    auto wav = make_wav(2, 44100, 16, make_samples(2 * frames));
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(wav.data()), wav.size());
+  }
+
+  auto stream = mgl::registry::audio_stream::open(
+      mgl::create_ref<std::ifstream>(path, std::ios::binary));
+  ASSERT_NE(stream, nullptr);
+
+  mgl::int16_buffer block(2 * 4096);
+  size_t total = 0;
+  size_t peak = 0;
+
+  while(size_t count = stream->read(block.data(), 4096))
+  {
+    total += count;
+    peak = std::max(peak, stream->memory_size());
+  }
+
+  EXPECT_EQ(total, frames);
+  EXPECT_LT(peak, 64 * 1024);
+
+  stream.reset();
+  std::filesystem::remove(path);
+}
+
+TEST(mgl_test_audio_stream, invalid_data)
+{
+  mgl::uint8_buffer garbage(64, 0x55);
+  EXPECT_EQ(mgl::registry::audio_stream::open(memory_stream(garbage)), nullptr);
+
+  // Ogg page magic without a valid Vorbis header
+  mgl::uint8_buffer ogg(64, 0);
+  std::memcpy(ogg.data(), "OggS", 4);
+  EXPECT_EQ(mgl::registry::audio_stream::open(memory_stream(ogg)), nullptr);
+
+  auto wav = make_wav(1, 22050, 16, make_samples(16));
+  wav[20] = 2; // ADPCM
+  EXPECT_EQ(mgl::registry::audio_stream::open(memory_stream(wav)), nullptr);
+}
+
+TEST(mgl_test_audio_stream, load_sound_and_music)
+{
+  auto sound = mgl::registry::load_sound("test.wav", mgl::registry::loader_options());
+  ASSERT_NE(sound, nullptr);
+  EXPECT_EQ(sound->channels(), 1);
+  EXPECT_EQ(sound->sample_rate(), 22050);
+  EXPECT_EQ(sound->frames(), 2205);
+  EXPECT_EQ(sound->memory_size(), 2205 * sizeof(int16_t));
+
+  // The same file can also be streamed as music
+  auto music = mgl::registry::load_music("test.wav", mgl::registry::loader_options());
+  ASSERT_NE(music, nullptr);
+  EXPECT_EQ(music->sample_rate(), 22050);
+
+  auto stream = music->open();
+  ASSERT_NE(stream, nullptr);
+
+  mgl::int16_buffer samples(sound->samples().size());
+  EXPECT_EQ(stream->read(samples.data(), sound->frames()), sound->frames());
+  EXPECT_EQ(samples, sound->samples());
+
+  EXPECT_EQ(mgl::registry::load_sound("missing.wav", mgl::registry::loader_options()), nullptr);
+}
+
+int main(int argc, char** argv)
+{
+  mgl::registry::register_location(mgl::registry::resource::type::sound, "file://data/sounds");
+  mgl::registry::register_location(mgl::registry::resource::type::music, "file://data/sounds");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
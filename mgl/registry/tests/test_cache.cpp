@@ -0,0 +1,67 @@
+#include "mgl_registry/cache.hpp"
+#include "mgl_registry/resources/text.hpp"
+#include "gtest/gtest.h"
+
+using mgl::registry::resource;
+using mgl::registry::resource_cache;
+
+static resource_cache::key text_key(const std::string& path)
+{
+  return { resource::type::text, path, 0 };
+}
+
+TEST(mgl_registry_cache, hit_and_miss)
+{
+  resource_cache cache;
+  EXPECT_EQ(cache.get(text_key("a.txt")), nullptr);
+
+  auto text = mgl::create_ref<mgl::registry::text>("hello");
+  cache.put(text_key("a.txt"), text);
+  EXPECT_EQ(cache.get(text_key("a.txt")), text);
+
+  auto stats = cache.get_stats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.entries, 1);
+  EXPECT_EQ(stats.bytes, 5);
+}
+
+TEST(mgl_registry_cache, options_are_part_of_the_key)
+{
+  resource_cache cache;
+  cache.put(text_key("a.txt"), mgl::create_ref<mgl::registry::text>("hello"));
+  EXPECT_EQ(cache.get({ resource::type::text, "a.txt", 1 }), nullptr);
+}
+
+TEST(mgl_registry_cache, lru_eviction)
+{
+  resource_cache cache(10);
+  cache.put(text_key("a.txt"), mgl::create_ref<mgl::registry::text>("aaaa"));
+  cache.put(text_key("b.txt"), mgl::create_ref<mgl::registry::text>("bbbb"));
+
+  // Touch a so b becomes the least recently used
+  EXPECT_NE(cache.get(text_key("a.txt")), nullptr);
+  cache.put(text_key("c.txt"), mgl::create_ref<mgl::registry::text>("cccc"));
+
+  EXPECT_EQ(cache.get_stats().evictions, 1);
+  EXPECT_EQ(cache.get(text_key("b.txt")), nullptr);
+  EXPECT_NE(cache.get(text_key("a.txt")), nullptr);
+  EXPECT_NE(cache.get(text_key("c.txt")), nullptr);
+}
+
+TEST(mgl_registry_cache, evicted_resource_in_use_is_shared)
+{
+  resource_cache cache(4);
+  auto a = mgl::create_ref<mgl::registry::text>("aaaa");
+  cache.put(text_key("a.txt"), a);
+  cache.put(text_key("b.txt"), mgl::create_ref<mgl::registry::text>("bbbb"));
+
+  EXPECT_EQ(cache.get_stats().evictions, 1);
+  EXPECT_EQ(cache.get(text_key("a.txt")), a);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
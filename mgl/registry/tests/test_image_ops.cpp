@@ -0,0 +1,164 @@
+#include "mgl_registry/image_ops.hpp"
+#include "mgl_registry/resources/image.hpp"
+#include "gtest/gtest.h"
+
+namespace image_ops = mgl::registry::image_ops;
+
+// Odd sizes so every SIMD path also runs its scalar tail
+static const int32_t WIDTH = 67;
+static const int32_t HEIGHT = 5;
+
+static mgl::uint8_buffer make_pixels(size_t size)
+{
+  mgl::uint8_buffer data(size);
+  uint32_t seed = 7;
+  for(auto& b : data)
+  {
+    seed = seed * 1664525u + 1013904223u;
+    b = static_cast<uint8_t>(seed >> 24);
+  }
+  return data;
+}
+
+TEST(mgl_test_image_ops, flip_horizontally)
+{
+  for(int32_t channels = 1; channels <= 4; channels++)
+  {
+    auto data = make_pixels((size_t)WIDTH * HEIGHT * channels);
+    auto flipped = data;
+    image_ops::flip_horizontally(flipped.data(), WIDTH, HEIGHT, channels);
+
+    for(int32_t y = 0; y < HEIGHT; y++)
+      for(int32_t x = 0; x < WIDTH; x++)
+        for(int32_t c = 0; c < channels; c++)
+          ASSERT_EQ(flipped[(y * WIDTH + x) * channels + c],
+                    data[(y * WIDTH + WIDTH - 1 - x) * channels + c]);
+  }
+}
+
+TEST(mgl_test_image_ops, flip_vertically)
+{
+  auto data = make_pixels((size_t)WIDTH * HEIGHT * 3);
+  auto flipped = data;
+  image_ops::flip_vertically(flipped.data(), WIDTH, HEIGHT, 3);
+
+  for(int32_t y = 0; y < HEIGHT; y++)
+    for(int32_t x = 0; x < WIDTH * 3; x++)
+      ASSERT_EQ(flipped[y * WIDTH * 3 + x], data[(HEIGHT - 1 - y) * WIDTH * 3 + x]);
+}
+
+TEST(mgl_test_image_ops, fill)
+{
+  const uint8_t pixel[4] = { 1, 2, 3, 4 };
+  for(int32_t channels = 1; channels <= 4; channels++)
+  {
+    mgl::uint8_buffer data((size_t)WIDTH * channels + 1, 0xAA);
+    image_ops::fill(data.data(), WIDTH, pixel, channels);
+
+    for(size_t i = 0; i < (size_t)WIDTH * channels; i++)
+      ASSERT_EQ(data[i], pixel[i % channels]);
+    EXPECT_EQ(data.back(), 0xAA);
+  }
+}
+
+TEST(mgl_test_image_ops, swizzle)
+{
+  const uint8_t order[4] = { 2, 1, 0, 3 };
+  for(int32_t channels = 3; channels <= 4; channels++)
+  {
+    auto data = make_pixels((size_t)WIDTH * channels);
+    auto swizzled = data;
+    image_ops::swizzle(swizzled.data(), WIDTH, channels, order);
+
+    for(size_t i = 0; i < (size_t)WIDTH; i++)
+      for(int32_t c = 0; c < channels; c++)
+        ASSERT_EQ(swizzled[i * channels + c], data[i * channels + order[c]]);
+  }
+}
+
+TEST(mgl_test_image_ops, expand_to_rgba)
+{
+  for(int32_t channels = 1; channels <= 4; channels++)
+  {
+    auto data = make_pixels((size_t)WIDTH * channels);
+    mgl::uint8_buffer rgba((size_t)WIDTH * 4);
+    image_ops::expand_to_rgba(data.data(), rgba.data(), WIDTH, channels);
+
+    for(size_t i = 0; i < (size_t)WIDTH; i++)
+    {
+      const uint8_t* p = data.data() + i * channels;
+      const uint8_t* q = rgba.data() + i * 4;
+      uint8_t expected[4] = { p[0], p[0], p[0], 255 };
+      if(channels == 2)
+        expected[3] = p[1];
+      if(channels >= 3)
+        expected[1] = p[1], expected[2] = p[2];
+      if(channels == 4)
+        expected[3] = p[3];
+
+      for(int32_t c = 0; c < 4; c++)
+        ASSERT_EQ(q[c], expected[c]);
+    }
+  }
+}
+
+TEST(mgl_test_image_ops, premultiply_alpha)
+{
+  // Every color and alpha combination, compared against the rounded float result
+  mgl::uint8_buffer data(256 * 256 * 4);
+  for(int32_t a = 0; a < 256; a++)
+    for(int32_t c = 0; c < 256; c++)
+    {
+      uint8_t* p = data.data() + (a * 256 + c) * 4;
+      p[0] = p[1] = p[2] = c;
+      p[3] = a;
+    }
+
+  image_ops::premultiply_alpha(data.data(), 256 * 256, 4);
+
+  for(int32_t a = 0; a < 256; a++)
+    for(int32_t c = 0; c < 256; c++)
+    {
+      const uint8_t* p = data.data() + (a * 256 + c) * 4;
+      ASSERT_EQ(p[0], (c * a + 127) / 255);
+      ASSERT_EQ(p[2], p[0]);
+      ASSERT_EQ(p[3], a);
+    }
+}
+
+TEST(mgl_test_image_ops, blit_clips)
+{
+  mgl::registry::image dst(4, 4, 1);
+  mgl::registry::image src(3, 3, 1);
+  src.fill(glm::vec4(1.0f));
+
+  dst.blit(-1, -1, src);
+  dst.blit(3, 3, src, { 0, 0, 10, 10 });
+
+  const uint8_t expected[16] = { 255, 255, 0, 0, 255, 255, 0, 0, 0, 0, 0, 0, 0, 0, 0, 255 };
+  for(int32_t i = 0; i < 16; i++)
+    EXPECT_EQ(dst.buffer()[i], expected[i]);
+}
+
+TEST(mgl_test_image_ops, image_roundtrip)
+{
+  auto data = make_pixels((size_t)WIDTH * HEIGHT * 3);
+  mgl::registry::image img(WIDTH, HEIGHT, 3, data.data());
+
+  auto twice = img.flip_horizontally()->flip_horizontally()->flip_vertically()->flip_vertically();
+  EXPECT_EQ(twice->buffer(), img.buffer());
+
+  auto rgba = img.to_rgba();
+  EXPECT_EQ(rgba->channels(), 4);
+  EXPECT_EQ(rgba->get_pixel(1, 1).a, 1.0f);
+
+  auto cropped = img.crop(2, 1, 3, 2);
+  EXPECT_EQ(cropped->get_pixel(0, 0), img.get_pixel(2, 1));
+  EXPECT_EQ(cropped->get_pixel(2, 1), img.get_pixel(4, 2));
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
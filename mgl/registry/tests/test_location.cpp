@@ -1,9 +1,14 @@
 #include "mgl_core/log.hpp"
+#include "mgl_core/platform.hpp"
 #include "mgl_registry/location.hpp"
 #include "mgl_registry/locations/local.hpp"
+#include "mgl_registry/locations/pak.hpp"
 #include "mgl_registry/locations/zip.hpp"
+#include "mgl_registry/pak.hpp"
 #include "gtest/gtest.h"
 
+#include <fstream>
+
 TEST(url_test, test_url_parsing)
 {
   mgl::registry::url url;
@@ -37,6 +42,107 @@ TEST(url_test, test_url_parsing)
   EXPECT_EQ(url.query, "query");
 }
 
+TEST(url_test, test_file_url_query)
+{
+  mgl::registry::url url("file://assets?watch");
+  EXPECT_EQ(url.protocol, "file");
+  EXPECT_EQ(url.path, "assets");
+  EXPECT_EQ(url.query, "watch");
+}
+
+TEST(location_test, test_pak_corrupt_entry_size)
+{
+  auto path = std::filesystem::temp_directory_path() / "mgl_test_location.pak";
+
+  mgl::registry::pak::writer writer;
+  writer.add("zeros.bin", mgl::uint8_buffer(4096, 0));
+  ASSERT_TRUE(writer.write(path));
+
+  // Claim the LZ4 blob unpacks to 4 GiB, far more than its few stored bytes can produce
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    mgl::registry::pak::header h;
+    file.read(reinterpret_cast<char*>(&h), sizeof(h));
+    ASSERT_EQ(h.entry_count, 1);
+
+    mgl::registry::pak::entry e;
+    file.seekg(h.entries_offset);
+    file.read(reinterpret_cast<char*>(&e), sizeof(e));
+    ASSERT_EQ(e.method, mgl::registry::pak::compression::lz4);
+
+    e.size = UINT32_MAX;
+    file.seekp(h.entries_offset);
+    file.write(reinterpret_cast<const char*>(&e), sizeof(e));
+  }
+
+  mgl::registry::pak_location factory;
+  auto location = factory.factory(mgl::registry::url("file://" + path.string()));
+  ASSERT_NE(location, nullptr);
+  EXPECT_FALSE(location->is_indexed());
+
+  mgl::uint8_buffer buffer;
+  location->read("zeros.bin", buffer);
+  EXPECT_TRUE(buffer.empty());
+
+  location.reset();
+  std::filesystem::remove(path);
+}
+
+TEST(location_test, test_path_index)
+{
+  auto root = std::filesystem::temp_directory_path() / "mgl_test_path_index";
+  std::filesystem::remove_all(root);
+  std::filesystem::create_directories(root / "sub");
+  mgl::io::open_write(root / "sub" / "a.txt")->close();
+
+  mgl::registry::local_location factory;
+  auto location = factory.factory(mgl::registry::url("file://" + root.string()));
+  ASSERT_NE(location, nullptr);
+  EXPECT_FALSE(location->is_indexed());
+
+  location->refresh();
+  EXPECT_TRUE(location->is_indexed());
+  EXPECT_TRUE(location->exists("sub/a.txt"));
+  EXPECT_TRUE(location->exists("sub/./a.txt"));
+  EXPECT_TRUE(location->exists("sub"));
+  EXPECT_FALSE(location->exists("sub/b.txt"));
+
+  // Files added behind the location's back are only seen after a refresh
+  mgl::io::open_write(root / "sub" / "b.txt")->close();
+  EXPECT_FALSE(location->exists("sub/b.txt"));
+  location->refresh();
+  EXPECT_TRUE(location->exists("sub/b.txt"));
+
+  // Writes through the location keep the index up to date
+  location->write("c.txt", { 1, 2, 3 });
+  EXPECT_TRUE(location->exists("c.txt"));
+
+  std::filesystem::remove_all(root);
+}
+
+#ifdef MGL_PLATFORM_LINUX
+TEST(location_test, test_watched_path_index)
+{
+  auto root = std::filesystem::temp_directory_path() / "mgl_test_watched_index";
+  std::filesystem::remove_all(root);
+  std::filesystem::create_directories(root / "sub");
+
+  mgl::registry::local_location factory;
+  auto location = factory.factory(mgl::registry::url("file://" + root.string() + "?watch"));
+  ASSERT_NE(location, nullptr);
+  location->refresh();
+  EXPECT_FALSE(location->exists("sub/a.txt"));
+
+  mgl::io::open_write(root / "sub" / "a.txt")->close();
+  EXPECT_TRUE(location->exists("sub/a.txt"));
+
+  std::filesystem::remove(root / "sub" / "a.txt");
+  EXPECT_FALSE(location->exists("sub/a.txt"));
+
+  std::filesystem::remove_all(root);
+}
+#endif
+
 int main(int argc, char** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,91 @@
+#include "mgl_registry/locations/pak.hpp"
+#include "mgl_registry/manifest.hpp"
+#include "mgl_registry/pak.hpp"
+#include "mgl_registry/registry.hpp"
+#include "gtest/gtest.h"
+
+static const std::string s_manifest = R"({
+  "stages": {
+    "boot": [
+      { "type": "image", "path": "test.png" },
+      { "type": "text", "path": "test.txt" },
+      { "type": "text", "path": "missing.txt" }
+    ],
+    "level": [
+      { "type": "shader", "path": "test.glsl" }
+    ]
+  }
+})";
+
+TEST(mgl_test_manifest, parse)
+{
+  auto manifest = mgl::registry::manifest::parse(s_manifest);
+  ASSERT_NE(manifest, nullptr);
+
+  EXPECT_EQ(manifest->stages().size(), 2);
+  EXPECT_TRUE(manifest->has_stage("boot"));
+  EXPECT_FALSE(manifest->has_stage("credits"));
+  EXPECT_TRUE(manifest->assets("credits").empty());
+
+  auto& boot = manifest->assets("boot");
+  ASSERT_EQ(boot.size(), 3);
+  EXPECT_EQ(boot[0].type, mgl::registry::resource::type::image);
+  EXPECT_EQ(boot[0].path, "test.png");
+  EXPECT_EQ(boot[1].type, mgl::registry::resource::type::text);
+}
+
+TEST(mgl_test_manifest, parse_errors)
+{
+  EXPECT_EQ(mgl::registry::manifest::parse("{"), nullptr);
+  EXPECT_EQ(mgl::registry::manifest::parse("[]"), nullptr);
+  EXPECT_EQ(mgl::registry::manifest::parse(R"({ "stages": [] })"), nullptr);
+  EXPECT_EQ(mgl::registry::manifest::parse(R"({ "stages": { "boot": [ { "path": "a" } ] } })"),
+            nullptr);
+  EXPECT_EQ(mgl::registry::manifest::parse(
+                R"({ "stages": { "boot": [ { "type": "video", "path": "a" } ] } })"),
+            nullptr);
+  EXPECT_EQ(mgl::registry::manifest::load("missing.json"), nullptr);
+}
+
+TEST(mgl_test_manifest, prefetch)
+{
+  auto manifest = mgl::registry::manifest::parse(s_manifest);
+  ASSERT_NE(manifest, nullptr);
+
+  auto future = mgl::registry::prefetch(*manifest, "boot");
+  ASSERT_TRUE(future.valid());
+
+  size_t expected = std::filesystem::file_size("data/images/test.png") +
+                    std::filesystem::file_size("data/text/test.txt");
+  EXPECT_EQ(future.get(), expected);
+
+  EXPECT_EQ(mgl::registry::prefetch(*manifest, "credits").get(), 0);
+}
+
+TEST(mgl_test_manifest, prefetch_pak)
+{
+  auto path = std::filesystem::temp_directory_path() / "mgl_test_manifest.pak";
+
+  mgl::registry::pak::writer writer;
+  writer.add("raw.bin", mgl::uint8_buffer(10000, 7), false);
+  ASSERT_TRUE(writer.write(path));
+
+  mgl::registry::pak_location factory;
+  auto location = factory.factory(mgl::registry::url("file://" + path.string()));
+  ASSERT_NE(location, nullptr);
+
+  EXPECT_EQ(location->prefetch("raw.bin"), 10000);
+  EXPECT_EQ(location->prefetch("missing.bin"), 0);
+
+  location.reset();
+  std::filesystem::remove(path);
+}
+
+int main(int argc, char** argv)
+{
+  mgl::registry::register_location(mgl::registry::resource::type::image, "file://data/images");
+  mgl::registry::register_location(mgl::registry::resource::type::text, "file://data/text");
+  mgl::registry::register_location(mgl::registry::resource::type::shader, "file://data/shaders");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,165 @@
+#include "mgl_core/io.hpp"
+#include "mgl_registry/locations/pak.hpp"
+#include "mgl_registry/pak.hpp"
+#include "gtest/gtest.h"
+
+#include <fstream>
+
+static mgl::path write_test_pak()
+{
+  auto path = std::filesystem::temp_directory_path() / "mgl_test.pak";
+
+  mgl::uint8_buffer small = { 1, 2, 3 };
+  mgl::uint8_buffer zeros(4096, 0);
+  mgl::uint8_buffer noise(1000);
+  for(size_t i = 0; i < noise.size(); i++)
+    noise[i] = static_cast<uint8_t>((i * 2654435761u) >> 13);
+
+  mgl::registry::pak::writer writer;
+  writer.add("small.bin", small);
+  writer.add("dir/zeros.bin", zeros);
+  writer.add("./dir/noise.bin", noise);
+  writer.add("raw/zeros.bin", zeros, false);
+  EXPECT_TRUE(writer.write(path));
+
+  return path;
+}
+
+TEST(mgl_test_pak, read_entries)
+{
+  auto path = write_test_pak();
+
+  mgl::registry::pak_location factory;
+  auto location = factory.factory(mgl::registry::url("file://" + path.string()));
+  ASSERT_NE(location, nullptr);
+  EXPECT_TRUE(location->is_indexed());
+
+  EXPECT_TRUE(location->exists("small.bin"));
+  EXPECT_TRUE(location->exists("dir/noise.bin"));
+  EXPECT_TRUE(location->exists("dir/../dir/zeros.bin"));
+  EXPECT_FALSE(location->exists("missing.bin"));
+
+  mgl::uint8_buffer buffer;
+  location->read("small.bin", buffer);
+  EXPECT_EQ(buffer, mgl::uint8_buffer({ 1, 2, 3 }));
+
+  location->read("dir/zeros.bin", buffer);
+  EXPECT_EQ(buffer, mgl::uint8_buffer(4096, 0));
+
+  location->read("dir/noise.bin", buffer);
+  ASSERT_EQ(buffer.size(), 1000);
+  EXPECT_EQ(buffer[999], static_cast<uint8_t>((999 * 2654435761u) >> 13));
+
+  auto stream = location->open_read("raw/zeros.bin");
+  ASSERT_NE(stream, nullptr);
+  stream->seekg(0, std::ios::end);
+  EXPECT_EQ(stream->tellg(), 4096);
+
+  location.reset();
+  std::filesystem::remove(path);
+}
+
+TEST(mgl_test_pak, view_raw_entries)
+{
+  auto path = write_test_pak();
+
+  mgl::registry::pak_location factory;
+  auto location = std::dynamic_pointer_cast<mgl::registry::pak_location>(
+      factory.factory(mgl::registry::url("file://" + path.string())));
+  ASSERT_NE(location, nullptr);
+
+  const uint8_t* data = nullptr;
+  size_t size = 0;
+  auto mapping = location->view("raw/zeros.bin", data, size);
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_EQ(size, 4096);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(data) % mgl::registry::pak::ALIGNMENT, 0);
+  EXPECT_EQ(data[0], 0);
+
+  // Compressed entries can't be viewed in place
+  EXPECT_EQ(location->view("dir/zeros.bin", data, size), nullptr);
+
+  mapping.reset();
+  location.reset();
+  std::filesystem::remove(path);
+}
+
+TEST(mgl_test_pak, reject_invalid_archive)
+{
+  auto path = std::filesystem::temp_directory_path() / "mgl_test_invalid.pak";
+  auto stream = mgl::io::open_write(path);
+  mgl::io::write_uint8_buffer(stream, mgl::uint8_buffer(64, 0xFF));
+  stream->close();
+
+  mgl::registry::pak_location factory;
+  auto location = factory.factory(mgl::registry::url("file://" + path.string()));
+  ASSERT_NE(location, nullptr);
+  EXPECT_FALSE(location->is_indexed());
+  EXPECT_FALSE(location->exists("small.bin"));
+
+  location.reset();
+  std::filesystem::remove(path);
+}
+
+static void patch_pak(const mgl::path& path, const std::string& name,
+                      void (*patch)(mgl::registry::pak::entry&))
+{
+  std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+  mgl::registry::pak::header h;
+  file.read(reinterpret_cast<char*>(&h), sizeof(h));
+
+  auto target = mgl::registry::pak::hash(name);
+  for(uint32_t i = 0; i < h.entry_count; i++)
+  {
+    auto offset = h.entries_offset + i * sizeof(mgl::registry::pak::entry);
+    mgl::registry::pak::entry e;
+    file.seekg(offset);
+    file.read(reinterpret_cast<char*>(&e), sizeof(e));
+    if(e.hash != target)
+      continue;
+
+    patch(e);
+    file.seekp(offset);
+    file.write(reinterpret_cast<const char*>(&e), sizeof(e));
+  }
+}
+
+TEST(mgl_test_pak, reject_corrupted_entries)
+{
+  mgl::registry::pak_location factory;
+
+  // A raw entry claiming more bytes than it stores would read past the mapping
+  auto path = write_test_pak();
+  patch_pak(path, "raw/zeros.bin", [](mgl::registry::pak::entry& e) { e.size += 1 << 20; });
+  auto location = factory.factory(mgl::registry::url("file://" + path.string()));
+  ASSERT_NE(location, nullptr);
+  EXPECT_FALSE(location->is_indexed());
+  EXPECT_EQ(location->open_read("raw/zeros.bin"), nullptr);
+  location.reset();
+
+  path = write_test_pak();
+  patch_pak(path, "small.bin", [](mgl::registry::pak::entry& e) {
+    e.method = static_cast<mgl::registry::pak::compression>(7);
+  });
+  location = factory.factory(mgl::registry::url("file://" + path.string()));
+  ASSERT_NE(location, nullptr);
+  EXPECT_FALSE(location->is_indexed());
+  location.reset();
+
+  // Cutting the file drops the entry table and names off the end
+  path = write_test_pak();
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+  location = factory.factory(mgl::registry::url("file://" + path.string()));
+  ASSERT_NE(location, nullptr);
+  EXPECT_FALSE(location->is_indexed());
+  EXPECT_FALSE(location->exists("small.bin"));
+
+  location.reset();
+  std::filesystem::remove(path);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -6,6 +6,11 @@
 #include "mgl_registry/registry.hpp"
 #include "gtest/gtest.h"
 
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <thread>
+
 TEST(mgl_test_load_image, load_image)
 {
   auto image = mgl::registry::load_image("test.png", mgl::registry::loader_options());
@@ -88,6 +93,117 @@ TEST(mgl_test_load_font, load_font)
   bmp_sdf2->save("font-sdf-32.png");
 }
 
+TEST(mgl_test_cache, load_is_deduplicated)
+{
+  auto& cache = mgl::registry::cache();
+  cache.clear();
+  cache.reset_stats();
+
+  auto first = mgl::registry::load_text("test.txt", mgl::registry::loader_options());
+  auto second = mgl::registry::load_text("test.txt", mgl::registry::loader_options());
+  EXPECT_NE(first, nullptr);
+  EXPECT_EQ(first, second);
+
+  auto stats = cache.get_stats();
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.hits, 1);
+}
+
+TEST(mgl_test_load_async, load_async)
+{
+  bool completed = false;
+  auto future = mgl::registry::load_async(mgl::registry::resource::type::text,
+                                          "test.txt",
+                                          mgl::registry::loader_options(),
+                                          [&completed](const mgl::registry::resource_ref& r) {
+                                            completed = r != nullptr;
+                                          });
+
+  auto text = std::dynamic_pointer_cast<mgl::registry::text>(future.get());
+  EXPECT_NE(text, nullptr);
+  EXPECT_EQ(text->data(), "Hello, World!");
+
+  // The callback only runs when the main thread dispatches completions
+  mgl::registry::current_registry().wait();
+  EXPECT_FALSE(completed);
+  EXPECT_EQ(mgl::registry::dispatch_completions(), 1);
+  EXPECT_TRUE(completed);
+}
+
+TEST(mgl_test_load_async, load_many)
+{
+  mgl::registry::resource_list results;
+  auto futures = mgl::registry::load_many(
+      { { mgl::registry::resource::type::text, "test.txt" },
+        { mgl::registry::resource::type::image, "test.png" },
+        { mgl::registry::resource::type::shader, "test.glsl" } },
+      [&results](const mgl::registry::resource_list& r) { results = r; });
+
+  EXPECT_EQ(futures.size(), 3);
+  for(auto& future : futures)
+  {
+    EXPECT_NE(future.get(), nullptr);
+  }
+
+  mgl::registry::current_registry().wait();
+  mgl::registry::dispatch_completions();
+  ASSERT_EQ(results.size(), 3);
+  EXPECT_EQ(results[0]->get_type(), mgl::registry::resource::type::text);
+  EXPECT_EQ(results[1]->get_type(), mgl::registry::resource::type::image);
+  EXPECT_EQ(results[2]->get_type(), mgl::registry::resource::type::shader);
+}
+
+// Counts its decodes and takes long enough for concurrent requests to overlap
+static std::atomic<int32_t> s_slow_loads = 0;
+
+class slow_text_loader : public mgl::registry::loader
+{
+public:
+  virtual mgl::registry::resource::type get_type() const override
+  {
+    return mgl::registry::resource::type::text;
+  }
+
+  virtual mgl::string_list get_extensions() const override { return { ".slow" }; }
+
+  virtual mgl::registry::resource_ref load(const mgl::registry::location_ref& location,
+                                           const std::string& path,
+                                           const mgl::registry::loader_options& options) override
+  {
+    s_slow_loads++;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    return mgl::create_ref<mgl::registry::text>("slow");
+  }
+};
+
+TEST(mgl_test_load_async, load_many_duplicates)
+{
+  std::ofstream("data/text/dedupe.slow") << "slow";
+  mgl::registry::loader_ref loader = mgl::create_scope<slow_text_loader>();
+  mgl::registry::register_loader(loader);
+  mgl::registry::current_registry().refresh();
+  mgl::registry::cache().clear();
+
+  // Duplicate requests in flight at the same time share the first decode
+  auto futures = mgl::registry::load_many({ { mgl::registry::resource::type::text, "dedupe.slow" },
+                                            { mgl::registry::resource::type::text, "dedupe.slow" },
+                                            { mgl::registry::resource::type::text, "dedupe.slow" },
+                                            { mgl::registry::resource::type::text, "dedupe.slow" } });
+
+  ASSERT_EQ(futures.size(), 4);
+  auto first = futures[0].get();
+  ASSERT_NE(first, nullptr);
+  for(auto& future : futures)
+  {
+    EXPECT_EQ(future.get(), first);
+  }
+  EXPECT_EQ(s_slow_loads, 1);
+
+  mgl::registry::current_registry().wait();
+  mgl::registry::dispatch_completions();
+  std::filesystem::remove("data/text/dedupe.slow");
+}
+
 int main(int argc, char** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
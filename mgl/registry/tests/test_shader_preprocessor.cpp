@@ -0,0 +1,111 @@
+#include "mgl_registry/locations/local.hpp"
+#include "mgl_registry/registry.hpp"
+#include "mgl_registry/shader_preprocessor.hpp"
+#include "gtest/gtest.h"
+
+static mgl::registry::location_ref shaders_location()
+{
+  mgl::registry::local_location factory;
+  return factory.factory(mgl::registry::url("file://data/shaders"));
+}
+
+TEST(mgl_test_shader_preprocessor, expand_includes)
+{
+  auto location = shaders_location();
+  mgl::registry::shader_preprocessor preprocessor;
+
+  std::string source = "#version 330 core\n"
+                       "#include \"common/transform.glsl\"\n"
+                       "void main() { }\n";
+
+  mgl::registry::shader_preprocessor::result result;
+  ASSERT_TRUE(preprocessor.preprocess(location, "main.vs", source, result));
+
+  ASSERT_EQ(result.files.size(), 3);
+  EXPECT_EQ(result.files[1], mgl::registry::shader_preprocessor::file_key(
+                                 location, "common/transform.glsl"));
+  EXPECT_EQ(result.files[2],
+            mgl::registry::shader_preprocessor::file_key(location, "common/uniforms.glsl"));
+
+  EXPECT_EQ(result.source.find("#include"), std::string::npos);
+  EXPECT_NE(result.source.find("uniform mat4 view;"), std::string::npos);
+  EXPECT_NE(result.source.find("#line 1 1\n#line 1 2\nuniform mat4 view;"), std::string::npos);
+  EXPECT_NE(result.source.find("#line 2 1\n"), std::string::npos);
+  EXPECT_NE(result.source.find("#line 3 0\nvoid main() { }"), std::string::npos);
+  EXPECT_EQ(preprocessor.cached_files(), 2);
+
+  // A second shader reuses the parsed includes
+  ASSERT_TRUE(preprocessor.preprocess(location, "other.vs", source, result));
+  EXPECT_EQ(preprocessor.cached_files(), 2);
+}
+
+TEST(mgl_test_shader_preprocessor, dependency_graph)
+{
+  auto location = shaders_location();
+  mgl::registry::shader_preprocessor preprocessor;
+  mgl::registry::shader_preprocessor::result result;
+
+  ASSERT_TRUE(preprocessor.preprocess(
+      location, "a.vs", "#version 330\n#include \"common/transform.glsl\"\n", result));
+  ASSERT_TRUE(preprocessor.preprocess(
+      location, "b.vs", "#version 330\n#include \"common/uniforms.glsl\"\n", result));
+
+  auto uniforms = mgl::registry::shader_preprocessor::file_key(location, "common/uniforms.glsl");
+  auto transform = mgl::registry::shader_preprocessor::file_key(location, "common/transform.glsl");
+
+  auto dependents = preprocessor.dependents(uniforms);
+  EXPECT_EQ(dependents.size(), 2);
+  EXPECT_EQ(preprocessor.dependents(transform).size(), 1);
+
+  auto a = mgl::registry::shader_preprocessor::file_key(location, "a.vs");
+  EXPECT_EQ(preprocessor.dependencies(a).size(), 2);
+
+  // Re-expanding a shader replaces its edges
+  ASSERT_TRUE(preprocessor.preprocess(location, "a.vs", "#version 330\n", result));
+  EXPECT_TRUE(preprocessor.dependencies(a).empty());
+  EXPECT_EQ(preprocessor.dependents(uniforms).size(), 1);
+
+  EXPECT_EQ(preprocessor.invalidate(uniforms).size(), 1);
+  EXPECT_EQ(preprocessor.cached_files(), 1);
+}
+
+TEST(mgl_test_shader_preprocessor, errors)
+{
+  auto location = shaders_location();
+  mgl::registry::shader_preprocessor preprocessor;
+  mgl::registry::shader_preprocessor::result result;
+
+  EXPECT_FALSE(preprocessor.preprocess(
+      location, "a.vs", "#version 330\n#include \"common/missing.glsl\"\n", result));
+  EXPECT_FALSE(preprocessor.preprocess(
+      location, "a.vs", "#version 330\n#include \"common/recursive.glsl\"\n", result));
+}
+
+TEST(mgl_test_shader_preprocessor, load_and_invalidate)
+{
+  mgl::registry::loaders::shader_loader_options options;
+  options.type = mgl::registry::shader::type::VERTEX_SHADER;
+
+  auto shader = mgl::registry::load_shader("test_include.vs", options);
+  ASSERT_NE(shader, nullptr);
+  EXPECT_EQ(shader->files().size(), 3);
+
+  auto source = shader->vertex();
+  EXPECT_NE(source.find("#line 2 0\n#line 1 1\n"), std::string::npos);
+  EXPECT_NE(source.find("uniform mat4 model;"), std::string::npos);
+
+  auto reload = mgl::registry::invalidate_include("common/uniforms.glsl");
+  ASSERT_EQ(reload.size(), 1);
+  EXPECT_EQ(reload[0], shader->files()[0]);
+
+  auto reloaded = mgl::registry::load_shader("test_include.vs", options);
+  ASSERT_NE(reloaded, nullptr);
+  EXPECT_NE(reloaded, shader);
+}
+
+int main(int argc, char** argv)
+{
+  mgl::registry::register_location(mgl::registry::resource::type::shader, "file://data/shaders");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
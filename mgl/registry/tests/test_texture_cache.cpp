@@ -0,0 +1,150 @@
+#include "mgl_registry/registry.hpp"
+#include "mgl_registry/texture_cache.hpp"
+#include "gtest/gtest.h"
+
+static mgl::registry::image_ref make_image(int32_t width, int32_t height, int32_t channels)
+{
+  auto img = mgl::create_ref<mgl::registry::image>(width, height, channels);
+  for(int32_t y = 0; y < height; y++)
+    for(int32_t x = 0; x < width; x++)
+      for(int32_t c = 0; c < channels; c++)
+        img->data()[((size_t)y * width + x) * channels + c] = static_cast<uint8_t>(x * 16 + c);
+  return img;
+}
+
+TEST(mgl_test_texture_cache, build_mip_chain)
+{
+  mgl::registry::texture_options options;
+  options.premultiply_alpha = false;
+
+  auto data = mgl::registry::texture_cache::build(make_image(8, 4, 4), options);
+  ASSERT_NE(data, nullptr);
+  ASSERT_EQ(data->level_count(), 4);
+  EXPECT_EQ(data->width(), 8);
+  EXPECT_EQ(data->height(), 4);
+  EXPECT_EQ(data->channels(), 4);
+
+  auto& levels = data->levels();
+  EXPECT_EQ(levels[1].width, 4);
+  EXPECT_EQ(levels[1].height, 2);
+  EXPECT_EQ(levels[3].width, 1);
+  EXPECT_EQ(levels[3].height, 1);
+  EXPECT_EQ(levels[3].size, 4);
+
+  for(auto& level : levels)
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(level.data) % 16, 0);
+
+  // Columns 0 and 1 average to 8 + c
+  EXPECT_EQ(levels[1].data[0], 8);
+  EXPECT_EQ(levels[1].data[3], 11);
+
+  options.mipmaps = false;
+  EXPECT_EQ(mgl::registry::texture_cache::build(make_image(8, 4, 4), options)->level_count(), 1);
+}
+
+TEST(mgl_test_texture_cache, premultiply)
+{
+  auto img = mgl::create_ref<mgl::registry::image>(1, 1, 4);
+  uint8_t* pixel = img->data();
+  pixel[0] = 200;
+  pixel[3] = 128;
+
+  auto data = mgl::registry::texture_cache::build(img, {});
+  ASSERT_NE(data, nullptr);
+  EXPECT_TRUE(data->premultiplied());
+  EXPECT_EQ(data->levels()[0].data[0], 100);
+  EXPECT_EQ(data->levels()[0].data[3], 128);
+
+  // In linear space mid grey at half alpha is darker than half of its encoded value
+  mgl::registry::texture_options options;
+  options.srgb = true;
+  pixel[0] = 128;
+  data = mgl::registry::texture_cache::build(img, options);
+  EXPECT_GT(data->levels()[0].data[0], 64);
+  EXPECT_LT(data->levels()[0].data[0], 128);
+}
+
+TEST(mgl_test_texture_cache, store_and_map)
+{
+  auto directory = std::filesystem::temp_directory_path() / "mgl_test_texture_cache";
+  std::filesystem::remove_all(directory);
+
+  mgl::registry::texture_cache cache;
+  EXPECT_FALSE(cache.enabled());
+  cache.set_directory(directory);
+  EXPECT_TRUE(cache.enabled());
+
+  mgl::uint8_buffer source = { 'i', 'm', 'g' };
+  int decodes = 0;
+  auto decoder = [&](const uint8_t*, size_t) {
+    decodes++;
+    return make_image(16, 16, 3);
+  };
+
+  auto built = cache.load(source.data(), source.size(), {}, decoder);
+  ASSERT_NE(built, nullptr);
+  EXPECT_EQ(decodes, 1);
+  EXPECT_EQ(built->level_count(), 5);
+
+  auto mapped = cache.load(source.data(), source.size(), {}, decoder);
+  ASSERT_NE(mapped, nullptr);
+  EXPECT_EQ(decodes, 1);
+  ASSERT_EQ(mapped->level_count(), built->level_count());
+  for(size_t i = 0; i < built->level_count(); i++)
+  {
+    auto& a = built->levels()[i];
+    auto& b = mapped->levels()[i];
+    ASSERT_EQ(a.size, b.size);
+    EXPECT_EQ(std::memcmp(a.data, b.data, a.size), 0);
+  }
+
+  // Different options or sources are different entries
+  mgl::registry::texture_options options;
+  options.mipmaps = false;
+  EXPECT_EQ(cache.load(source.data(), source.size(), options, decoder)->level_count(), 1);
+  EXPECT_EQ(decodes, 2);
+
+  source.push_back('2');
+  cache.load(source.data(), source.size(), {}, decoder);
+  EXPECT_EQ(decodes, 3);
+
+  mapped.reset();
+  cache.clear();
+  cache.load(source.data(), source.size(), {}, decoder);
+  EXPECT_EQ(decodes, 4);
+
+  cache.clear();
+  std::filesystem::remove_all(directory);
+}
+
+TEST(mgl_test_texture_cache, load_texture)
+{
+  auto directory = std::filesystem::temp_directory_path() / "mgl_test_texture_registry";
+  std::filesystem::remove_all(directory);
+  mgl::registry::set_texture_cache(directory);
+
+  auto built = mgl::registry::load_texture("test.png");
+  ASSERT_NE(built, nullptr);
+
+  mgl::registry::loaders::image_loader_options image_options;
+  auto image = mgl::registry::load_image("test.png", image_options);
+  ASSERT_NE(image, nullptr);
+  EXPECT_EQ(built->width(), image->width());
+  EXPECT_EQ(built->height(), image->height());
+  EXPECT_EQ(built->channels(), image->channels());
+
+  auto mapped = mgl::registry::load_texture("test.png");
+  ASSERT_NE(mapped, nullptr);
+  EXPECT_EQ(mapped->level_count(), built->level_count());
+
+  mgl::registry::current_registry().textures().clear();
+  mgl::registry::set_texture_cache({});
+  std::filesystem::remove_all(directory);
+}
+
+int main(int argc, char** argv)
+{
+  mgl::registry::register_location(mgl::registry::resource::type::image, "file://data/images");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
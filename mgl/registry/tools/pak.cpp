@@ -0,0 +1,60 @@
+#include "mgl_core/io.hpp"
+#include "mgl_registry/pak.hpp"
+
+#include <cstring>
+#include <iostream>
+
+// Packs a directory into a pak archive: mgl_pak [--raw] <input dir> <output.pak>
+int main(int argc, char** argv)
+{
+  bool compress = true;
+  mgl::list<std::string> args;
+
+  for(int i = 1; i < argc; i++)
+  {
+    if(std::strcmp(argv[i], "--raw") == 0)
+      compress = false;
+    else
+      args.push_back(argv[i]);
+  }
+
+  if(args.size() != 2)
+  {
+    std::cerr << "usage: mgl_pak [--raw] <input dir> <output.pak>" << std::endl;
+    return 1;
+  }
+
+  mgl::path input = args[0];
+  mgl::path output = args[1];
+
+  if(!std::filesystem::is_directory(input))
+  {
+    std::cerr << "mgl_pak: " << input.string() << " is not a directory" << std::endl;
+    return 1;
+  }
+
+  mgl::registry::pak::writer writer;
+  size_t total = 0;
+
+  for(auto&& entry : std::filesystem::recursive_directory_iterator(input))
+  {
+    if(!entry.is_regular_file())
+      continue;
+
+    mgl::uint8_buffer data(entry.file_size());
+    auto stream = mgl::io::open_read(entry.path());
+    mgl::io::read_uint8_buffer(stream, data);
+    stream->close();
+
+    total += data.size();
+    writer.add(entry.path().lexically_relative(input).generic_string(), data, compress);
+  }
+
+  if(!writer.write(output))
+    return 1;
+
+  std::cout << "mgl_pak: packed " << writer.size() << " files, " << total << " bytes into "
+            << output.string() << " (" << std::filesystem::file_size(output) << " bytes)"
+            << std::endl;
+  return 0;
+}